@@ -19,6 +19,7 @@
 #include "platform/uni_platform.h"
 #include "uni_common.h"
 #include "uni_gpio.h"
+#include "uni_latency.h"
 #include "uni_log.h"
 #include "uni_mouse_quadrature.h"
 #include "uni_property.h"
@@ -575,6 +576,7 @@ void uni_console_init(void) {
 
     register_bluepad32();
     uni_gpio_register_cmds();
+    uni_latency_register_cmds();
 
     if (uni_get_platform()->register_console_cmds)
         uni_get_platform()->register_console_cmds();
@@ -32,22 +32,27 @@ static bool bt_bredr_enabled = true;
 
 static void l2cap_create_control_connection(uni_hid_device_t* d) {
     uint8_t status;
+    uint16_t cid = 0;
+    // Go through the setter so the device cid index stays in sync.
     status = l2cap_create_channel(uni_bt_packet_handler, d->conn.btaddr, BLUETOOTH_PSM_HID_CONTROL,
-                                  UNI_BT_L2CAP_CHANNEL_MTU, &d->conn.control_cid);
+                                  UNI_BT_L2CAP_CHANNEL_MTU, &cid);
     if (status) {
         loge("\nConnecting or Auth to HID Control failed: 0x%02x", status);
     } else {
+        uni_hid_device_set_control_cid(d, cid);
         uni_bt_conn_set_state(&d->conn, UNI_BT_CONN_STATE_L2CAP_CONTROL_CONNECTION_REQUESTED);
     }
 }
 
 static void l2cap_create_interrupt_connection(uni_hid_device_t* d) {
     uint8_t status;
+    uint16_t cid = 0;
     status = l2cap_create_channel(uni_bt_packet_handler, d->conn.btaddr, BLUETOOTH_PSM_HID_INTERRUPT,
-                                  UNI_BT_L2CAP_CHANNEL_MTU, &d->conn.interrupt_cid);
+                                  UNI_BT_L2CAP_CHANNEL_MTU, &cid);
     if (status) {
         loge("\nConnecting or Auth to HID Interrupt failed: 0x%02x", status);
     } else {
+        uni_hid_device_set_interrupt_cid(d, cid);
         uni_bt_conn_set_state(&d->conn, UNI_BT_CONN_STATE_L2CAP_INTERRUPT_CONNECTION_REQUESTED);
     }
 }
@@ -85,19 +90,19 @@ void uni_bt_bredr_scan_stop(void) {
 void uni_bt_bredr_disconnect(uni_hid_device_t* d) {
     if (gap_get_connection_type(d->conn.handle) != GAP_CONNECTION_INVALID) {
         gap_disconnect(d->conn.handle);
-        d->conn.handle = UNI_BT_CONN_HANDLE_INVALID;
+        uni_hid_device_set_connection_handle(d, UNI_BT_CONN_HANDLE_INVALID);
     } else {
         // After calling gap_disconnect() we should not call l2cap_disonnect(),
         // since gap_disconnect() will take care of it.
         // But if the handle is not present, then call it manually.
         if (d->conn.control_cid) {
             l2cap_disconnect(d->conn.control_cid);
-            d->conn.control_cid = 0;
+            uni_hid_device_set_control_cid(d, 0);
         }
 
         if (d->conn.interrupt_cid) {
             l2cap_disconnect(d->conn.interrupt_cid);
-            d->conn.interrupt_cid = 0;
+            uni_hid_device_set_interrupt_cid(d, 0);
         }
     }
 }
@@ -382,7 +387,7 @@ void uni_bt_bredr_on_l2cap_incoming_connection(uint16_t channel, const uint8_t*
             }
             l2cap_accept_connection(channel);
             uni_hid_device_set_connection_handle(device, handle);
-            device->conn.control_cid = channel;
+            uni_hid_device_set_control_cid(device, channel);
             uni_hid_device_set_incoming(device, true);
             break;
         case PSM_HID_INTERRUPT:
@@ -391,7 +396,7 @@ void uni_bt_bredr_on_l2cap_incoming_connection(uint16_t channel, const uint8_t*
                 l2cap_decline_connection(channel);
                 break;
             }
-            device->conn.interrupt_cid = channel;
+            uni_hid_device_set_interrupt_cid(device, channel);
             l2cap_accept_connection(channel);
             break;
         default:
@@ -450,12 +455,12 @@ void uni_bt_bredr_on_l2cap_channel_opened(uint16_t channel, const uint8_t* packe
 
     switch (psm) {
         case PSM_HID_CONTROL:
-            device->conn.control_cid = l2cap_event_channel_opened_get_local_cid(packet);
+            uni_hid_device_set_control_cid(device, l2cap_event_channel_opened_get_local_cid(packet));
             logi("HID Control opened, cid 0x%02x\n", device->conn.control_cid);
             uni_bt_conn_set_state(&device->conn, UNI_BT_CONN_STATE_L2CAP_CONTROL_CONNECTED);
             break;
         case PSM_HID_INTERRUPT:
-            device->conn.interrupt_cid = l2cap_event_channel_opened_get_local_cid(packet);
+            uni_hid_device_set_interrupt_cid(device, l2cap_event_channel_opened_get_local_cid(packet));
             logi("HID Interrupt opened, cid 0x%02x\n", device->conn.interrupt_cid);
             uni_bt_conn_set_state(&device->conn, UNI_BT_CONN_STATE_L2CAP_INTERRUPT_CONNECTED);
 
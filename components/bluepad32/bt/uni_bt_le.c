@@ -411,7 +411,7 @@ static void uni_device_information_packet_handler(uint8_t packet_type,
                         break;
                     }
                     logi("Using hids_cid=%d\n", hids_cid);
-                    device->hids_cid = hids_cid;
+                    uni_hid_device_set_hids_cid(device, hids_cid);
                     break;
                 default:
                     logi("Device Information service client connection failed, error=%#x.\n", status);
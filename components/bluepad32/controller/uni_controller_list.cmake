@@ -0,0 +1,83 @@
+# Generates the sorted controller list from include/controller/uni_controller_list.h.
+#
+# The list is kept in the same format (and grouping) as SDL's controller_list.h, so that it is easy to sync.
+# At configure time the entries are sorted by MAKE_CONTROLLER_ID(VID, PID), so that uni_guess_controller_type()
+# can do a binary search on a const (flash) table. Duplicated IDs fail the build.
+#
+# Plain CMake (no Python) so that Bluepad32 can still be used as a regular component.
+
+function(uni_generate_controller_list INPUT OUTPUT)
+    set_property(DIRECTORY APPEND PROPERTY CMAKE_CONFIGURE_DEPENDS ${INPUT})
+    file(READ ${INPUT} content)
+
+    # Skip commented-out entries
+    string(REGEX REPLACE "/\\*([^*]|\\*+[^*/])*\\*+/" "" content "${content}")
+    string(REGEX REPLACE "//[^\n]*" "" content "${content}")
+
+    set(ws "[ \t]*")
+    set(hex "0[xX][0-9a-fA-F]+")
+    set(entry_regex
+        "{${ws}MAKE_CONTROLLER_ID${ws}\\(${ws}(${hex})${ws},${ws}(${hex})${ws}\\)${ws},${ws}(k_eControllerType_[A-Za-z0-9_]+)${ws},${ws}(NULL|\"[^\"]*\")${ws}}")
+    string(REGEX MATCHALL "${entry_regex}" entries "${content}")
+    string(REGEX MATCHALL "MAKE_CONTROLLER_ID${ws}\\(${ws}0[xX]" ids "${content}")
+    list(LENGTH entries entry_count)
+    list(LENGTH ids id_count)
+    if(NOT entry_count EQUAL id_count)
+        message(FATAL_ERROR "${INPUT}: ${id_count} controller IDs but only ${entry_count} entries could be parsed")
+    endif()
+
+    set(sorted "")
+    foreach(entry ${entries})
+        string(REGEX MATCH "${entry_regex}" entry "${entry}")
+        set(id "")
+        foreach(part ${CMAKE_MATCH_1} ${CMAKE_MATCH_2})
+            # 0xf0d -> 0f0d, so that sorting strings sorts the IDs
+            string(TOLOWER ${part} part)
+            string(SUBSTRING ${part} 2 -1 part)
+            string(LENGTH ${part} len)
+            while(len LESS 4)
+                set(part "0${part}")
+                math(EXPR len "${len} + 1")
+            endwhile()
+            set(id "${id}${part}")
+        endforeach()
+        string(SUBSTRING ${id} 0 4 vid)
+        string(SUBSTRING ${id} 4 4 pid)
+        list(APPEND sorted "${id}|    {MAKE_CONTROLLER_ID(0x${vid}, 0x${pid}), ${CMAKE_MATCH_3}, ${CMAKE_MATCH_4}},")
+    endforeach()
+    list(SORT sorted)
+
+    set(body "")
+    set(prev_id "")
+    foreach(item ${sorted})
+        string(SUBSTRING "${item}" 0 8 id)
+        string(SUBSTRING "${item}" 9 -1 line)
+        if(id STREQUAL prev_id)
+            string(SUBSTRING ${id} 0 4 vid)
+            string(SUBSTRING ${id} 4 4 pid)
+            message(FATAL_ERROR "${INPUT}: duplicate controller entry for VID 0x${vid} PID 0x${pid}")
+        endif()
+        set(prev_id ${id})
+        string(APPEND body "${line}\n")
+    endforeach()
+
+    set(generated
+        "// Generated by uni_controller_list.cmake from uni_controller_list.h. DO NOT EDIT.\n"
+        "// Sorted by ID. CAN ONLY BE INCLUDED FROM uni_controller_type.c\n"
+        "\n"
+        "#define MAKE_CONTROLLER_ID(nVID, nPID) (uint32_t)((uint16_t)nVID << 16 | (uint16_t)nPID)\n"
+        "\n"
+        "static const uni_controller_description_t arrControllers[] = {\n"
+        "${body}"
+        "}\;\n")
+    string(CONCAT generated ${generated})
+
+    # Only touch the file when it changes, to avoid needless rebuilds
+    if(EXISTS ${OUTPUT})
+        file(READ ${OUTPUT} previous)
+    endif()
+    if(NOT "${previous}" STREQUAL "${generated}")
+        file(WRITE ${OUTPUT} "${generated}")
+    endif()
+    message(STATUS "Controller list: ${entry_count} entries")
+endfunction()
@@ -23,54 +23,41 @@
 
 #include "controller/uni_controller_type.h"
 
-#include <stdbool.h>
-#include <stdio.h>
+#include <stddef.h>
 
-#include "controller/uni_controller_list.h"
-#include "sdkconfig.h"
+// Generated at build time from uni_controller_list.h, sorted by ID. See uni_controller_list.cmake
+#include "uni_controller_list_sorted.h"
 #include "uni_common.h"
-#include "uni_log.h"
-
-uni_controller_type_t uni_guess_controller_type(uint16_t vid, uint16_t pid) {
-#ifdef CONFIG_TARGET_POSIX
-    //  Verify that there are no duplicates in the controller list
-    //  If the list were sorted, we could do this much more efficiently, as well as improve lookup speed.
-    static bool checked_for_duplicates;
-    if (!checked_for_duplicates) {
-        checked_for_duplicates = true;
-        int i, j;
-        for (i = 0; i < ARRAY_SIZE(arrControllers); ++i) {
-            for (j = i + 1; j < ARRAY_SIZE(arrControllers); ++j) {
-                if (arrControllers[i].device_id == arrControllers[j].device_id) {
-                    loge("Duplicate controller entry found for VID 0x%.4x PID 0x%.4x (%d,%d)\n",
-                         (arrControllers[i].device_id >> 16), arrControllers[i].device_id & 0xffff, i, j);
-                }
-            }
-        }
-    }
-#endif  // CONFIG_TARGET_POSIX
 
+static const uni_controller_description_t* find_controller(uint16_t vid, uint16_t pid) {
     uint32_t device_id = MAKE_CONTROLLER_ID(vid, pid);
-    int i;
-
-    for (i = 0; i < ARRAY_SIZE(arrControllers); ++i) {
-        if (device_id == arrControllers[i].device_id) {
-            return arrControllers[i].controller_type;
-        }
+    int lo = 0;
+    int hi = ARRAY_SIZE(arrControllers) - 1;
+
+    while (lo <= hi) {
+        int mid = lo + (hi - lo) / 2;
+        if (arrControllers[mid].device_id == device_id)
+            return &arrControllers[mid];
+        if (arrControllers[mid].device_id < device_id)
+            lo = mid + 1;
+        else
+            hi = mid - 1;
     }
+    return NULL;
+}
 
-    return k_eControllerType_UnknownNonSteamController;
+uni_controller_type_t uni_guess_controller_type(uint16_t vid, uint16_t pid) {
+    const uni_controller_description_t* c = find_controller(vid, pid);
+    if (c == NULL)
+        return k_eControllerType_UnknownNonSteamController;
+    return c->controller_type;
 }
 
 const char* uni_guess_controller_name(uint16_t vid, uint16_t pid) {
-    uint32_t device_id = MAKE_CONTROLLER_ID(vid, pid);
-    int i;
-    for (i = 0; i < sizeof(arrControllers) / sizeof(arrControllers[0]); ++i) {
-        if (device_id == arrControllers[i].device_id) {
-            return arrControllers[i].name;
-        }
-    }
-    return NULL;
+    const uni_controller_description_t* c = find_controller(vid, pid);
+    if (c == NULL)
+        return NULL;
+    return c->name;
 }
 
 #undef MAKE_CONTROLLER_ID
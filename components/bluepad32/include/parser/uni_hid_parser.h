@@ -5,6 +5,7 @@
 #ifndef UNI_HID_PARSER_H
 #define UNI_HID_PARSER_H
 
+#include <stdbool.h>
 #include <stdint.h>
 
 // Forward declarations
@@ -22,6 +23,54 @@ struct hid_globals_s {
 };
 typedef struct hid_globals_s hid_globals_t;
 
+// Compiled HID descriptor.
+// The HID descriptor doesn't change after SDP / GATT discovery, so instead of re-walking it
+// for each input report, it is compiled once (when the descriptor is set) into flat per-report-ID field tables.
+// parse_usage() only sees the fields that live in the incoming report.
+// Devices whose descriptor doesn't fit in the tables fall back to walking the descriptor.
+#define UNI_HID_REPORT_TABLE_MAX_FIELDS 96
+#define UNI_HID_REPORT_TABLE_MAX_GLOBALS 24
+#define UNI_HID_REPORT_TABLE_MAX_REPORTS 16
+
+typedef enum {
+    UNI_HID_REPORT_TABLE_EMPTY = 0,    // Not compiled yet
+    UNI_HID_REPORT_TABLE_COMPILED,     // Use the compiled fields
+    UNI_HID_REPORT_TABLE_UNSUPPORTED,  // Too big, or mixes fields with and without report ID: walk it
+} uni_hid_report_table_state_t;
+
+#define UNI_HID_FIELD_FLAG_VARIABLE 0x01  // Otherwise it is an array: the value is the usage
+#define UNI_HID_FIELD_FLAG_SIGNED 0x02
+
+typedef struct {
+    uint16_t bit_pos;  // Includes the report ID byte, if any
+    uint16_t usage_page;
+    uint16_t usage;
+    uint8_t size;     // In bits
+    uint8_t flags;    // UNI_HID_FIELD_FLAG_
+    uint8_t globals;  // Index in uni_hid_report_table_t.globals
+} uni_hid_field_t;
+
+typedef struct {
+    uint16_t report_id;  // HID_REPORT_ID_UNDEFINED if the descriptor doesn't use report IDs
+    uint8_t first_field;
+    uint8_t field_count;
+} uni_hid_report_fields_t;
+
+typedef struct {
+    uint8_t state;  // uni_hid_report_table_state_t
+    uint8_t report_count;
+    uint8_t field_count;
+    uint8_t globals_count;
+    // Dispatch cache: index in reports[] of the last dispatched report. Most devices send the same report ID
+    // most of the time.
+    uint8_t last_report;
+    // Report IDs that carry input fields. Other report IDs are dropped without looking at the reports.
+    uint32_t report_id_mask[256 / 32];
+    uni_hid_report_fields_t reports[UNI_HID_REPORT_TABLE_MAX_REPORTS];
+    hid_globals_t globals[UNI_HID_REPORT_TABLE_MAX_GLOBALS];
+    uni_hid_field_t fields[UNI_HID_REPORT_TABLE_MAX_FIELDS];
+} uni_hid_report_table_t;
+
 typedef void (*report_setup_fn_t)(struct uni_hid_device_s* d);
 typedef void (*report_init_report_fn_t)(struct uni_hid_device_s* d);
 typedef void (*report_parse_usage_fn_t)(struct uni_hid_device_s* d,
@@ -73,6 +122,13 @@ typedef struct {
 } uni_report_parser_t;
 
 void uni_hid_parse_input_report(struct uni_hid_device_s* d, const uint8_t* report, uint16_t report_len);
+// Compiles d->hid_descriptor into d->report_table. Called when the descriptor is set.
+// Returns false if the descriptor must be walked for each report instead.
+bool uni_hid_parser_compile_descriptor(struct uni_hid_device_s* d);
+// Calls parse_usage for each field of the report, using the compiled table of the report ID.
+void uni_hid_parser_dispatch_report(struct uni_hid_device_s* d, const uint8_t* report, uint16_t report_len);
+// Calls parse_usage for each field of the report, walking the HID descriptor (slow path).
+void uni_hid_parser_walk_report(struct uni_hid_device_s* d, const uint8_t* report, uint16_t report_len);
 int32_t uni_hid_parser_process_axis(const hid_globals_t* globals, uint32_t value);
 int32_t uni_hid_parser_process_pedal(const hid_globals_t* globals, uint32_t value);
 uint8_t uni_hid_parser_process_hat(const hid_globals_t* globals, uint32_t value);
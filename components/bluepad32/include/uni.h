@@ -36,14 +36,15 @@ extern "C" {
 #include "parser/uni_hid_parser_mouse.h"
 #include "parser/uni_hid_parser_xboxone.h"
 #include "platform/uni_platform.h"
-#include "uni_circular_buffer.h"
 #include "uni_console.h"
 #include "uni_hid_device.h"
 #include "uni_init.h"
 #include "uni_joystick.h"
+#include "uni_latency.h"
 #include "uni_log.h"
 #include "uni_mouse_quadrature.h"
 #include "uni_property.h"
+#include "uni_report_queue.h"
 #include "uni_utils.h"
 #include "uni_virtual_device.h"
 
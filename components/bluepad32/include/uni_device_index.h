@@ -0,0 +1,49 @@
+// SPDX-License-Identifier: Apache-2.0
+
+#ifndef UNI_DEVICE_INDEX_H
+#define UNI_DEVICE_INDEX_H
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#include "sdkconfig.h"
+
+// Maps a 16-bit key (cid, connection handle, address hash) to device indexes, so that the packet handlers
+// don't have to scan all the devices. Small open-addressing hash table with linear probing.
+// Several devices may share a key. Lookups return the lowest device index, the same result as a scan.
+// A table holds at most two keys per device, so it is at most half full.
+// Only used from the BTstack thread.
+#if CONFIG_BLUEPAD32_MAX_DEVICES <= 4
+#define UNI_DEVICE_INDEX_BITS 4
+#elif CONFIG_BLUEPAD32_MAX_DEVICES <= 8
+#define UNI_DEVICE_INDEX_BITS 5
+#elif CONFIG_BLUEPAD32_MAX_DEVICES <= 16
+#define UNI_DEVICE_INDEX_BITS 6
+#elif CONFIG_BLUEPAD32_MAX_DEVICES <= 32
+#define UNI_DEVICE_INDEX_BITS 7
+#elif CONFIG_BLUEPAD32_MAX_DEVICES <= 64
+#define UNI_DEVICE_INDEX_BITS 8
+#else
+#error "CONFIG_BLUEPAD32_MAX_DEVICES must be <= 64"
+#endif
+#define UNI_DEVICE_INDEX_SLOTS (1 << UNI_DEVICE_INDEX_BITS)
+
+typedef struct {
+    uint16_t key;
+    uint8_t dev;  // Device index + 1. 0 means empty slot
+} uni_device_index_slot_t;
+
+// Zero-initialized means empty.
+typedef struct {
+    uni_device_index_slot_t slots[UNI_DEVICE_INDEX_SLOTS];
+} uni_device_index_t;
+
+// Confirms a candidate device, for keys that are hashes (e.g. of the BT address).
+typedef bool (*uni_device_index_match_t)(int idx, const void* data);
+
+void uni_device_index_insert(uni_device_index_t* t, uint16_t key, int idx);
+void uni_device_index_remove(uni_device_index_t* t, uint16_t key, int idx);
+// Returns the lowest device index stored with key, or -1. match can be NULL.
+int uni_device_index_find(const uni_device_index_t* t, uint16_t key, uni_device_index_match_t match, const void* data);
+
+#endif  // UNI_DEVICE_INDEX_H
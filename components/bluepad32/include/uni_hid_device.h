@@ -13,7 +13,7 @@
 #include "controller/uni_controller.h"
 #include "controller/uni_controller_type.h"
 #include "parser/uni_hid_parser.h"
-#include "uni_circular_buffer.h"
+#include "uni_report_queue.h"
 #include "uni_error.h"
 
 #define HID_MAX_NAME_LEN 240
@@ -68,6 +68,8 @@ struct uni_hid_device_s {
 
     // Functions used to parse the usage page/usage.
     uni_report_parser_t report_parser;
+    // HID descriptor compiled into per-report field tables. Reset when the descriptor changes.
+    uni_hid_report_table_t report_table;
 
     // Buttons that need to be released before triggering the action again.
     uint32_t misc_button_wait_release;
@@ -76,10 +78,6 @@ struct uni_hid_device_s {
     // Needed for Nintendo Switch family of controllers.
     btstack_timer_source_t misc_button_delay_timer;
 
-    // Circular buffer that contains the outgoing packets that couldn't be sent
-    // immediately.
-    uni_circular_buffer_t outgoing_buffer;
-
     // Bytes reserved to controller's parser instances.
     // E.g.: The Wii driver uses it for the state machine.
     uint8_t parser_data[HID_DEVICE_MAX_PARSER_DATA];
@@ -172,11 +170,27 @@ bool uni_hid_device_has_controller_type(const uni_hid_device_t* d);
 
 void uni_hid_device_process_controller(uni_hid_device_t* d);
 
+// Device keys used by the get_instance_for_XXX() lookups. Don't modify them directly, since the
+// lookup indexes have to be updated as well.
 void uni_hid_device_set_connection_handle(uni_hid_device_t* d, hci_con_handle_t handle);
+void uni_hid_device_set_control_cid(uni_hid_device_t* d, uint16_t cid);
+void uni_hid_device_set_interrupt_cid(uni_hid_device_t* d, uint16_t cid);
+// BLE only
+void uni_hid_device_set_hids_cid(uni_hid_device_t* d, uint16_t hids_cid);
 
 void uni_hid_device_send_report(uni_hid_device_t* d, uint16_t cid, const uint8_t* report, uint16_t len);
 void uni_hid_device_send_intr_report(uni_hid_device_t* d, const uint8_t* report, uint16_t len);
 void uni_hid_device_send_ctrl_report(uni_hid_device_t* d, const uint8_t* report, uint16_t len);
+// For reports that carry the latest state (rumble, LEDs): if they have to be queued, they replace
+// the queued report of the same kind.
+void uni_hid_device_send_intr_report_latest(uni_hid_device_t* d,
+                                            uni_report_kind_t kind,
+                                            const uint8_t* report,
+                                            uint16_t len);
+void uni_hid_device_send_ctrl_report_latest(uni_hid_device_t* d,
+                                            uni_report_kind_t kind,
+                                            const uint8_t* report,
+                                            uint16_t len);
 void uni_hid_device_send_queued_reports(uni_hid_device_t* d);
 
 bool uni_hid_device_does_require_hid_descriptor(const uni_hid_device_t* d);
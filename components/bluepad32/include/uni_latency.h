@@ -0,0 +1,56 @@
+// SPDX-License-Identifier: Apache-2.0
+
+#ifndef UNI_LATENCY_H
+#define UNI_LATENCY_H
+
+#include <stdint.h>
+
+#include "sdkconfig.h"
+
+// Input latency trace points, in pipeline order.
+// Each stage measures the time since the previous stage, but only when the
+// previous stage produced something new. E.g. only the first APP_OUTPUT after
+// an APP_INPUT is measured; output writes caused by ramps are ignored.
+typedef enum {
+    UNI_LATENCY_STAGE_HCI_RX,           // HCI ACL packet received from the controller (VHCI task)
+    UNI_LATENCY_STAGE_HID_REPORT,       // HID input report handed to the parser (BTstack thread)
+    UNI_LATENCY_STAGE_CONTROLLER_DATA,  // Report parsed, platform on_controller_data() about to be called
+    UNI_LATENCY_STAGE_APP_INPUT,        // Platform published the input to the app
+    UNI_LATENCY_STAGE_APP_OUTPUT,       // App wrote an actuator output
+
+    UNI_LATENCY_STAGE_COUNT,
+} uni_latency_stage_t;
+
+typedef struct {
+    uint32_t count;
+    uint32_t p50_us;
+    uint32_t p99_us;
+    uint32_t max_us;
+} uni_latency_stats_t;
+
+#ifdef CONFIG_BLUEPAD32_LATENCY_TRACE
+
+// Number of events kept per core.
+#define UNI_LATENCY_RING_SIZE 64
+
+// Lock-free, safe to call from any task. Costs one timer read plus a few stores.
+void uni_latency_mark(uni_latency_stage_t stage);
+// Stats for "previous stage -> stage". Use UNI_LATENCY_STAGE_COUNT for the
+// end-to-end HCI_RX -> APP_OUTPUT latency.
+void uni_latency_get_stats(uni_latency_stage_t stage, uni_latency_stats_t* out);
+void uni_latency_reset(void);
+void uni_latency_log_summary(void);
+void uni_latency_init(void);
+void uni_latency_register_cmds(void);
+
+#else  // !CONFIG_BLUEPAD32_LATENCY_TRACE
+
+static inline void uni_latency_mark(uni_latency_stage_t stage) {
+    (void)stage;
+}
+static inline void uni_latency_init(void) {}
+static inline void uni_latency_register_cmds(void) {}
+
+#endif  // !CONFIG_BLUEPAD32_LATENCY_TRACE
+
+#endif  // UNI_LATENCY_H
@@ -0,0 +1,43 @@
+// SPDX-License-Identifier: Apache-2.0
+
+#ifndef UNI_REPORT_QUEUE_H
+#define UNI_REPORT_QUEUE_H
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#include "sdkconfig.h"
+
+// Outgoing reports that couldn't be sent immediately, e.g. because the ACL buffers are full.
+// All devices share one arena of variable-length packets. Each device has its own FIFO inside it,
+// and a device can't take more than UNI_REPORT_QUEUE_DEVICE_MAX_SIZE bytes so that a stuck connection
+// doesn't block the rest.
+// Only used from the BTstack thread.
+#define UNI_REPORT_QUEUE_ARENA_SIZE (1024 + CONFIG_BLUEPAD32_MAX_DEVICES * 256)
+#define UNI_REPORT_QUEUE_DEVICE_MAX_SIZE 1024
+
+enum {
+    UNI_REPORT_QUEUE_ERROR_OK = 0,
+    UNI_REPORT_QUEUE_ERROR_QUEUE_FULL,
+    UNI_REPORT_QUEUE_ERROR_REPORT_TOO_BIG,
+};
+
+// Reports that only carry the latest state. A queued report of the same kind (and same channel)
+// is dropped when a newer one is queued. Commands and init sequences must use UNI_REPORT_KIND_NONE.
+typedef enum {
+    UNI_REPORT_KIND_NONE = 0,
+    UNI_REPORT_KIND_RUMBLE,
+    UNI_REPORT_KIND_PLAYER_LEDS,
+    UNI_REPORT_KIND_LIGHTBAR,
+} uni_report_kind_t;
+
+uint8_t uni_report_queue_put(int dev_idx, uint16_t cid, uni_report_kind_t kind, const uint8_t* data, uint16_t len);
+// Oldest report of the device. data points inside the queue and is valid until the queue is modified.
+bool uni_report_queue_peek(int dev_idx, uint16_t* cid, const uint8_t** data, uint16_t* len);
+// Removes the oldest report of the device.
+void uni_report_queue_pop(int dev_idx);
+bool uni_report_queue_is_empty(int dev_idx);
+// Removes all the reports of the device.
+void uni_report_queue_reset(int dev_idx);
+
+#endif  // UNI_REPORT_QUEUE_H
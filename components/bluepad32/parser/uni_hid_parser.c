@@ -4,9 +4,12 @@
 
 #include "parser/uni_hid_parser.h"
 
+#include <string.h>
+
 #include "hid_usage.h"
 #include "uni_btstack_version_compat.h"
 #include "uni_hid_device.h"
+#include "uni_latency.h"
 #include "uni_log.h"
 #include "uni_version.h"
 
@@ -21,10 +24,10 @@
 #endif
 
 void uni_hid_parse_input_report(struct uni_hid_device_s* d, const uint8_t* report, uint16_t report_len) {
-    btstack_hid_parser_t parser;
-
     uni_report_parser_t* rp = &d->report_parser;
 
+    uni_latency_mark(UNI_LATENCY_STAGE_HID_REPORT);
+
     //    printf_hexdump(report, report_len);
 
     // Certain devices like iCade might not set "init_report".
@@ -39,37 +42,244 @@ void uni_hid_parse_input_report(struct uni_hid_device_s* d, const uint8_t* repor
 
     // Devices that suport regular HID reports.
     if (rp->parse_usage) {
-        btstack_hid_parser_init(&parser, d->hid_descriptor, d->hid_descriptor_len, HID_REPORT_TYPE_INPUT, report,
-                                report_len);
-        while (btstack_hid_parser_has_more(&parser)) {
-            uint16_t usage_page;
-            uint16_t usage;
-            int32_t value;
-            hid_globals_t globals;
-
-            // Save globals, since they are destroyed by btstack_hid_parser_get_field()
-            // see: https://github.com/bluekitchen/btstack/issues/187
+        if (d->report_table.state == UNI_HID_REPORT_TABLE_EMPTY)
+            uni_hid_parser_compile_descriptor(d);
+
+        if (d->report_table.state == UNI_HID_REPORT_TABLE_COMPILED)
+            uni_hid_parser_dispatch_report(d, report, report_len);
+        else
+            uni_hid_parser_walk_report(d, report, report_len);
+    }
+}
+
+void uni_hid_parser_walk_report(struct uni_hid_device_s* d, const uint8_t* report, uint16_t report_len) {
+    btstack_hid_parser_t parser;
+    uni_report_parser_t* rp = &d->report_parser;
+
+    btstack_hid_parser_init(&parser, d->hid_descriptor, d->hid_descriptor_len, HID_REPORT_TYPE_INPUT, report,
+                            report_len);
+    while (btstack_hid_parser_has_more(&parser)) {
+        uint16_t usage_page;
+        uint16_t usage;
+        int32_t value;
+        hid_globals_t globals;
+
+        // Save globals, since they are destroyed by btstack_hid_parser_get_field()
+        // see: https://github.com/bluekitchen/btstack/issues/187
 #if USE_NEW_PARSER_API
-            globals.logical_minimum = parser.usage_iterator.global_logical_minimum;
-            globals.logical_maximum = parser.usage_iterator.global_logical_maximum;
-            globals.report_count = parser.usage_iterator.global_report_count;
-            globals.report_id = parser.usage_iterator.global_report_id;
-            globals.report_size = parser.usage_iterator.global_report_size;
-            globals.usage_page = parser.usage_iterator.global_usage_page;
+        globals.logical_minimum = parser.usage_iterator.global_logical_minimum;
+        globals.logical_maximum = parser.usage_iterator.global_logical_maximum;
+        globals.report_count = parser.usage_iterator.global_report_count;
+        globals.report_id = parser.usage_iterator.global_report_id;
+        globals.report_size = parser.usage_iterator.global_report_size;
+        globals.usage_page = parser.usage_iterator.global_usage_page;
 #else
-            globals.logical_minimum = parser.global_logical_minimum;
-            globals.logical_maximum = parser.global_logical_maximum;
-            globals.report_count = parser.global_report_count;
-            globals.report_id = parser.global_report_id;
-            globals.report_size = parser.global_report_size;
-            globals.usage_page = parser.global_usage_page;
+        globals.logical_minimum = parser.global_logical_minimum;
+        globals.logical_maximum = parser.global_logical_maximum;
+        globals.report_count = parser.global_report_count;
+        globals.report_id = parser.global_report_id;
+        globals.report_size = parser.global_report_size;
+        globals.usage_page = parser.global_usage_page;
 #endif
 
-            btstack_hid_parser_get_field(&parser, &usage_page, &usage, &value);
+        btstack_hid_parser_get_field(&parser, &usage_page, &usage, &value);
 
-            logd("usage_page = 0x%04x, usage = 0x%04x, value = 0x%x\n", usage_page, usage, value);
-            rp->parse_usage(d, &globals, usage_page, usage, value);
+        logd("usage_page = 0x%04x, usage = 0x%04x, value = 0x%x\n", usage_page, usage, value);
+        rp->parse_usage(d, &globals, usage_page, usage, value);
+    }
+}
+
+#if USE_NEW_PARSER_API
+static bool globals_equal(const hid_globals_t* a, const hid_globals_t* b) {
+    return a->logical_minimum == b->logical_minimum && a->logical_maximum == b->logical_maximum &&
+           a->usage_page == b->usage_page && a->report_size == b->report_size &&
+           a->report_count == b->report_count && a->report_id == b->report_id;
+}
+
+// Returns the index of the globals in the table, adding them if needed. -1 if the table is full.
+static int table_add_globals(uni_hid_report_table_t* t, const hid_globals_t* g) {
+    for (int i = 0; i < t->globals_count; i++) {
+        if (globals_equal(&t->globals[i], g))
+            return i;
+    }
+    if (t->globals_count >= UNI_HID_REPORT_TABLE_MAX_GLOBALS)
+        return -1;
+    t->globals[t->globals_count] = *g;
+    return t->globals_count++;
+}
+
+static int table_find_report(const uni_hid_report_table_t* t, uint16_t report_id) {
+    for (int i = 0; i < t->report_count; i++) {
+        if (t->reports[i].report_id == report_id)
+            return i;
+    }
+    return -1;
+}
+
+// First pass: count the fields of each report ID, in the order they appear in the descriptor.
+static bool compile_count_fields(const uni_hid_device_t* d, uni_hid_report_table_t* t) {
+    btstack_hid_usage_iterator_t it;
+    btstack_hid_usage_item_t item;
+    int total = 0;
+
+    btstack_hid_usage_iterator_init(&it, d->hid_descriptor, d->hid_descriptor_len, HID_REPORT_TYPE_INPUT);
+    while (btstack_hid_usage_iterator_has_more(&it)) {
+        btstack_hid_usage_iterator_get_item(&it, &item);
+        if (item.size == 0 || item.size > 32 || ++total > UNI_HID_REPORT_TABLE_MAX_FIELDS)
+            return false;
+
+        int idx = table_find_report(t, item.report_id);
+        if (idx < 0) {
+            if (t->report_count >= UNI_HID_REPORT_TABLE_MAX_REPORTS)
+                return false;
+            idx = t->report_count++;
+            t->reports[idx].report_id = item.report_id;
         }
+        t->reports[idx].field_count++;
+    }
+
+    // Fields without report ID are parsed for every report. If they are mixed with report IDs, the
+    // original order can't be kept with per-report tables.
+    if (t->report_count > 1 && table_find_report(t, HID_REPORT_ID_UNDEFINED) >= 0)
+        return false;
+
+    uint8_t first = 0;
+    for (int i = 0; i < t->report_count; i++) {
+        uint16_t id = t->reports[i].report_id;
+        t->reports[i].first_field = first;
+        first += t->reports[i].field_count;
+        if (id != HID_REPORT_ID_UNDEFINED)
+            t->report_id_mask[(id & 0xff) / 32] |= 1u << (id % 32);
+    }
+    return true;
+}
+
+// Second pass: fill the fields, grouped by report ID.
+static bool compile_fill_fields(const uni_hid_device_t* d, uni_hid_report_table_t* t) {
+    btstack_hid_usage_iterator_t it;
+    btstack_hid_usage_item_t item;
+    uint8_t filled[UNI_HID_REPORT_TABLE_MAX_REPORTS] = {0};
+
+    btstack_hid_usage_iterator_init(&it, d->hid_descriptor, d->hid_descriptor_len, HID_REPORT_TYPE_INPUT);
+    while (btstack_hid_usage_iterator_has_more(&it)) {
+        btstack_hid_usage_iterator_get_item(&it, &item);
+
+        // Same globals that the walking parser passes to parse_usage().
+        hid_globals_t globals = {
+            .logical_minimum = it.global_logical_minimum,
+            .logical_maximum = it.global_logical_maximum,
+            .usage_page = it.global_usage_page,
+            .report_size = it.global_report_size,
+            .report_count = it.global_report_count,
+            .report_id = it.global_report_id,
+        };
+        int g = table_add_globals(t, &globals);
+        if (g < 0)
+            return false;
+
+        int idx = table_find_report(t, item.report_id);
+        uni_hid_field_t* f = &t->fields[t->reports[idx].first_field + filled[idx]++];
+        f->bit_pos = item.bit_pos + (item.report_id != HID_REPORT_ID_UNDEFINED ? 8 : 0);
+        f->usage_page = item.usage_page;
+        f->usage = item.usage;
+        f->size = item.size;
+        f->flags = 0;
+        if (item.descriptor_item.item_value & 2)
+            f->flags |= UNI_HID_FIELD_FLAG_VARIABLE;
+        if (item.global_logical_minimum < 0)
+            f->flags |= UNI_HID_FIELD_FLAG_SIGNED;
+        f->globals = (uint8_t)g;
+    }
+    t->field_count = t->reports[t->report_count - 1].first_field + t->reports[t->report_count - 1].field_count;
+    return true;
+}
+#endif  // USE_NEW_PARSER_API
+
+bool uni_hid_parser_compile_descriptor(struct uni_hid_device_s* d) {
+    uni_hid_report_table_t* t = &d->report_table;
+
+    memset(t, 0, sizeof(*t));
+#if USE_NEW_PARSER_API
+    if (compile_count_fields(d, t) && (t->report_count == 0 || compile_fill_fields(d, t))) {
+        t->state = UNI_HID_REPORT_TABLE_COMPILED;
+        logi("HID descriptor compiled: %d reports, %d fields, %d globals\n", t->report_count, t->field_count,
+             t->globals_count);
+        return true;
+    }
+    memset(t, 0, sizeof(*t));
+#endif
+    t->state = UNI_HID_REPORT_TABLE_UNSUPPORTED;
+    logi("HID descriptor not compiled, parsing it for each report\n");
+    return false;
+}
+
+// Reads a little-endian bitfield. Bytes past the end of the report read as zero.
+static inline uint32_t read_field(const uint8_t* report, uint16_t report_len, uint16_t bit_pos, uint8_t size) {
+    uint16_t pos = bit_pos >> 3;
+    uint16_t end = (bit_pos + size - 1) >> 3;
+    uint32_t v = 0;
+
+    for (uint16_t i = pos; i <= end && i < report_len && i - pos < 4; i++)
+        v |= (uint32_t)report[i] << ((i - pos) * 8);
+    v >>= bit_pos & 0x07;
+    return size >= 32 ? v : v & ((1u << size) - 1);
+}
+
+// Returns the fields of the report, or NULL if its report ID has no input fields.
+static const uni_hid_report_fields_t* find_report_fields(uni_hid_report_table_t* t,
+                                                         const uint8_t* report,
+                                                         uint16_t report_len) {
+    if (t->report_count == 0)
+        return NULL;
+
+    // Descriptors without report IDs have a single table that is used for every report.
+    if (t->reports[0].report_id == HID_REPORT_ID_UNDEFINED)
+        return &t->reports[0];
+
+    if (report_len == 0)
+        return NULL;
+    uint8_t id = report[0];
+    if ((t->report_id_mask[id / 32] & (1u << (id % 32))) == 0)
+        return NULL;
+
+    if (t->reports[t->last_report].report_id == id)
+        return &t->reports[t->last_report];
+    for (int r = 0; r < t->report_count; r++) {
+        if (t->reports[r].report_id == id) {
+            t->last_report = r;
+            return &t->reports[r];
+        }
+    }
+    return NULL;
+}
+
+void uni_hid_parser_dispatch_report(struct uni_hid_device_s* d, const uint8_t* report, uint16_t report_len) {
+    uni_hid_report_table_t* t = &d->report_table;
+    uni_report_parser_t* rp = &d->report_parser;
+
+    const uni_hid_report_fields_t* rf = find_report_fields(t, report, report_len);
+    if (rf == NULL)
+        return;
+
+    const uni_hid_field_t* f = &t->fields[rf->first_field];
+    for (int i = 0; i < rf->field_count; i++, f++) {
+        uint32_t raw = read_field(report, report_len, f->bit_pos, f->size);
+        uint16_t usage = f->usage;
+        int32_t value;
+
+        if (f->flags & UNI_HID_FIELD_FLAG_VARIABLE) {
+            if ((f->flags & UNI_HID_FIELD_FLAG_SIGNED) && f->size < 32 && (raw & (1u << (f->size - 1))))
+                value = (int32_t)(raw - (1u << f->size));
+            else
+                value = (int32_t)raw;
+        } else {
+            // Array: the value is the usage
+            usage = (uint16_t)raw;
+            value = 1;
+        }
+
+        logd("usage_page = 0x%04x, usage = 0x%04x, value = 0x%x\n", f->usage_page, usage, value);
+        rp->parse_usage(d, &t->globals[f->globals], f->usage_page, usage, value);
     }
 }
 
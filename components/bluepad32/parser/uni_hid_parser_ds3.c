@@ -136,7 +136,7 @@ typedef struct __attribute((packed)) {
 
 static ds3_instance_t* get_ds3_instance(uni_hid_device_t* d);
 static void ds3_update_led(uni_hid_device_t* d, uint8_t player_leds);
-static void ds3_send_output_report(uni_hid_device_t* d, ds3_output_report_t* out);
+static void ds3_send_output_report(uni_hid_device_t* d, ds3_output_report_t* out, uni_report_kind_t kind);
 static void on_ds3_set_rumble_on(btstack_timer_source_t* ts);
 static void on_ds3_set_rumble_off(btstack_timer_source_t* ts);
 static void ds3_stop_rumble_now(uni_hid_device_t* d);
@@ -360,7 +360,7 @@ static void ds3_update_led(uni_hid_device_t* d, uint8_t player_leds) {
     // LED cmd. LED1==2, LED2==4, etc...
     out.player_leds = player_leds << 1;
 
-    ds3_send_output_report(d, &out);
+    ds3_send_output_report(d, &out, UNI_REPORT_KIND_PLAYER_LEDS);
 }
 
 static void ds3_stop_rumble_now(uni_hid_device_t* d) {
@@ -376,7 +376,7 @@ static void ds3_stop_rumble_now(uni_hid_device_t* d) {
     // LED cmd. LED1==2, LED2==4, etc...
     out.player_leds = ins->player_leds << 1;
 
-    ds3_send_output_report(d, &out);
+    ds3_send_output_report(d, &out, UNI_REPORT_KIND_RUMBLE);
 }
 
 static void ds3_play_dual_rumble_now(uni_hid_device_t* d,
@@ -404,7 +404,7 @@ static void ds3_play_dual_rumble_now(uni_hid_device_t* d,
     // LED cmd. LED1==2, LED2==4, etc...
     out.player_leds = ins->player_leds << 1;
 
-    ds3_send_output_report(d, &out);
+    ds3_send_output_report(d, &out, UNI_REPORT_KIND_RUMBLE);
 
     // Set timer to turn off rumble
     ins->rumble_timer_duration.process = &on_ds3_set_rumble_off;
@@ -426,7 +426,7 @@ static void on_ds3_set_rumble_on(btstack_timer_source_t* ts) {
     ds3_play_dual_rumble_now(d, ins->rumble_duration_ms, ins->rumble_weak_magnitude, ins->rumble_strong_magnitude);
 }
 
-static void ds3_send_output_report(uni_hid_device_t* d, ds3_output_report_t* out) {
+static void ds3_send_output_report(uni_hid_device_t* d, ds3_output_report_t* out, uni_report_kind_t kind) {
     out->transation_type = 0x52;  // SET_REPORT output
     out->report_id = 0x01;
 
@@ -441,9 +441,9 @@ static void ds3_send_output_report(uni_hid_device_t* d, ds3_output_report_t* out
 
     ds3_instance_t* ins = get_ds3_instance(d);
     // Sony PS3 controllers expect the report on the control channel
-    uni_hid_device_send_ctrl_report(d, (uint8_t*)out, sizeof(*out));
+    uni_hid_device_send_ctrl_report_latest(d, kind, (uint8_t*)out, sizeof(*out));
     if (ins->clone_controller) {
         // Clone controllers expect the report on the interrupt channel
-        uni_hid_device_send_intr_report(d, (uint8_t*)out, sizeof(*out));
+        uni_hid_device_send_intr_report_latest(d, kind, (uint8_t*)out, sizeof(*out));
     }
 }
@@ -204,7 +204,7 @@ typedef struct __attribute((packed)) {
 _Static_assert(sizeof(ds4_feature_report_calibration_t) == DS4_FEATURE_REPORT_CALIBRATION_SIZE, "Invalid size");
 
 static ds4_instance_t* get_ds4_instance(uni_hid_device_t* d);
-static void ds4_send_output_report(uni_hid_device_t* d, ds4_output_report_t* out);
+static void ds4_send_output_report(uni_hid_device_t* d, ds4_output_report_t* out, uni_report_kind_t kind);
 static void ds4_request_calibration_report(uni_hid_device_t* d);
 static void ds4_request_firmware_version_report(uni_hid_device_t* d);
 static void ds4_send_enable_lightbar_report(uni_hid_device_t* d);
@@ -533,7 +533,7 @@ void uni_hid_parser_ds4_set_lightbar_color(uni_hid_device_t* d, uint8_t r, uint8
         .motor_left = ins->prev_rumble_strong_magnitude,
     };
 
-    ds4_send_output_report(d, &out);
+    ds4_send_output_report(d, &out, UNI_REPORT_KIND_LIGHTBAR);
 }
 
 void uni_hid_parser_ds4_play_dual_rumble(struct uni_hid_device_s* d,
@@ -587,13 +587,13 @@ static ds4_instance_t* get_ds4_instance(uni_hid_device_t* d) {
     return (ds4_instance_t*)&d->parser_data[0];
 }
 
-static void ds4_send_output_report(uni_hid_device_t* d, ds4_output_report_t* out) {
+static void ds4_send_output_report(uni_hid_device_t* d, ds4_output_report_t* out, uni_report_kind_t kind) {
     out->transaction_type = (HID_MESSAGE_TYPE_DATA << 4) | HID_REPORT_TYPE_OUTPUT;
     out->report_id = 0x11;  // taken from HID descriptor
     out->unk0[0] = 0xc4;    // HID alone + poll interval
     out->crc32 = ~uni_crc32_le(0xffffffff, (uint8_t*)out, sizeof(*out) - 4);
 
-    uni_hid_device_send_intr_report(d, (uint8_t*)out, sizeof(*out));
+    uni_hid_device_send_intr_report_latest(d, kind, (uint8_t*)out, sizeof(*out));
 }
 
 static void ds4_stop_rumble_now(uni_hid_device_t* d) {
@@ -613,7 +613,7 @@ static void ds4_stop_rumble_now(uni_hid_device_t* d) {
         .led_green = ins->prev_color_green,
         .led_blue = ins->prev_color_blue,
     };
-    ds4_send_output_report(d, &out);
+    ds4_send_output_report(d, &out, UNI_REPORT_KIND_RUMBLE);
 }
 
 static void ds4_play_dual_rumble_now(uni_hid_device_t* d,
@@ -642,7 +642,7 @@ static void ds4_play_dual_rumble_now(uni_hid_device_t* d,
         .led_green = ins->prev_color_green,
         .led_blue = ins->prev_color_blue,
     };
-    ds4_send_output_report(d, &out);
+    ds4_send_output_report(d, &out, UNI_REPORT_KIND_RUMBLE);
 
     // Set timer to turn off rumble
     ins->rumble_timer_duration.process = &on_ds4_set_rumble_off;
@@ -710,7 +710,7 @@ static void ds4_send_enable_lightbar_report(uni_hid_device_t* d) {
         .led_green = ins->prev_color_green,
         .led_blue = ins->prev_color_blue,
     };
-    ds4_send_output_report(d, &out);
+    ds4_send_output_report(d, &out, UNI_REPORT_KIND_NONE);
 }
 
 static void ds4_parse_mouse(uni_hid_device_t* d, const ds4_input_report_11_t* r) {
@@ -228,7 +228,7 @@ typedef struct __attribute((packed)) {
 _Static_assert(sizeof(ds5_feature_report_calibration_t) == DS5_FEATURE_REPORT_CALIBRATION_SIZE, "Invalid size");
 
 static ds5_instance_t* get_ds5_instance(uni_hid_device_t* d);
-static void ds5_send_output_report(uni_hid_device_t* d, ds5_output_report_t* out);
+static void ds5_send_output_report(uni_hid_device_t* d, ds5_output_report_t* out, uni_report_kind_t kind);
 static void ds5_send_enable_lightbar_report(uni_hid_device_t* d);
 static void ds5_request_pairing_info_report(uni_hid_device_t* d);
 static void ds5_request_firmware_version_report(uni_hid_device_t* d);
@@ -385,7 +385,7 @@ void ds5_set_adaptive_trigger_effect(struct uni_hid_device_s* d,
     }
 
     // logi("Has set valid flag %d, also, %d, and, %d", out.valid_flag0, out.left_trigger_ffb, out.right_trigger_ffb);
-    ds5_send_output_report(d, &out);
+    ds5_send_output_report(d, &out, UNI_REPORT_KIND_NONE);
 }
 
 void uni_hid_parser_ds5_init_report(uni_hid_device_t* d) {
@@ -668,7 +668,7 @@ void uni_hid_parser_ds5_set_player_leds(struct uni_hid_device_s* d, uint8_t valu
         .valid_flag1 = DS5_FLAG1_PLAYER_LED_CONTROL_ENABLE,
     };
 
-    ds5_send_output_report(d, &out);
+    ds5_send_output_report(d, &out, UNI_REPORT_KIND_PLAYER_LEDS);
 }
 
 void uni_hid_parser_ds5_set_lightbar_color(struct uni_hid_device_s* d, uint8_t r, uint8_t g, uint8_t b) {
@@ -679,7 +679,7 @@ void uni_hid_parser_ds5_set_lightbar_color(struct uni_hid_device_s* d, uint8_t r
         .valid_flag1 = DS5_FLAG1_LIGHTBAR_CONTROL_ENABLE,
     };
 
-    ds5_send_output_report(d, &out);
+    ds5_send_output_report(d, &out, UNI_REPORT_KIND_LIGHTBAR);
 }
 
 void uni_hid_parser_ds5_play_dual_rumble(struct uni_hid_device_s* d,
@@ -734,7 +734,7 @@ static ds5_instance_t* get_ds5_instance(uni_hid_device_t* d) {
     return (ds5_instance_t*)&d->parser_data[0];
 }
 
-static void ds5_send_output_report(uni_hid_device_t* d, ds5_output_report_t* out) {
+static void ds5_send_output_report(uni_hid_device_t* d, ds5_output_report_t* out, uni_report_kind_t kind) {
     ds5_instance_t* ins = get_ds5_instance(d);
 
     out->transaction_type = (HID_MESSAGE_TYPE_DATA << 4) | HID_REPORT_TYPE_OUTPUT;
@@ -749,7 +749,7 @@ static void ds5_send_output_report(uni_hid_device_t* d, ds5_output_report_t* out
 
     out->crc32 = ~uni_crc32_le(0xffffffff, (uint8_t*)out, sizeof(*out) - 4);
 
-    uni_hid_device_send_intr_report(d, (uint8_t*)out, sizeof(*out));
+    uni_hid_device_send_intr_report_latest(d, kind, (uint8_t*)out, sizeof(*out));
 }
 
 static void ds5_stop_rumble_now(uni_hid_device_t* d) {
@@ -768,7 +768,7 @@ static void ds5_stop_rumble_now(uni_hid_device_t* d) {
     else
         out.valid_flag0 |= DS5_FLAG0_COMPATIBLE_VIBRATION;
 
-    ds5_send_output_report(d, &out);
+    ds5_send_output_report(d, &out, UNI_REPORT_KIND_RUMBLE);
 }
 
 static void ds5_play_dual_rumble_now(uni_hid_device_t* d,
@@ -796,7 +796,7 @@ static void ds5_play_dual_rumble_now(uni_hid_device_t* d,
     else
         out.valid_flag0 |= DS5_FLAG0_COMPATIBLE_VIBRATION;
 
-    ds5_send_output_report(d, &out);
+    ds5_send_output_report(d, &out, UNI_REPORT_KIND_RUMBLE);
 
     // Set timer to turn off rumble
     ins->rumble_timer_duration.process = &on_ds5_set_rumble_off;
@@ -863,7 +863,7 @@ static void ds5_send_enable_lightbar_report(uni_hid_device_t* d) {
         .valid_flag2 = DS5_FLAG2_LIGHTBAR_SETUP_CONTROL_ENABLE,
         .lightbar_setup = DS5_LIGHTBAR_SETUP_LIGHT_OUT,
     };
-    ds5_send_output_report(d, &out);
+    ds5_send_output_report(d, &out, UNI_REPORT_KIND_NONE);
 
     // Set as ready
     ds5_instance_t* ins = get_ds5_instance(d);
@@ -123,7 +123,7 @@ typedef struct __attribute((packed)) {
 } psmove_input_zcm2_report_t;
 
 static psmove_instance_t* get_psmove_instance(uni_hid_device_t* d);
-static void psmove_send_output_report(uni_hid_device_t* d, psmove_output_report_t* out);
+static void psmove_send_output_report(uni_hid_device_t* d, psmove_output_report_t* out, uni_report_kind_t kind);
 static void on_psmove_set_rumble_on(btstack_timer_source_t* ts);
 static void on_psmove_set_rumble_off(btstack_timer_source_t* ts);
 static void psmove_play_dual_rumble_now(uni_hid_device_t* d, uint16_t duration_ms, uint8_t magnitude);
@@ -252,7 +252,7 @@ void uni_hid_parser_psmove_set_lightbar_color(uni_hid_device_t* d, uint8_t r, ui
         .led_rgb[2] = b,
         .rumble = ins->rumble_magnitude,
     };
-    psmove_send_output_report(d, &out);
+    psmove_send_output_report(d, &out, UNI_REPORT_KIND_LIGHTBAR);
 }
 
 void uni_hid_parser_psmove_setup(struct uni_hid_device_s* d) {
@@ -301,7 +301,7 @@ static void psmove_stop_rumble_now(uni_hid_device_t* d) {
         .rumble = 0,
     };
 
-    psmove_send_output_report(d, &out);
+    psmove_send_output_report(d, &out, UNI_REPORT_KIND_RUMBLE);
 }
 
 static void psmove_play_dual_rumble_now(uni_hid_device_t* d, uint16_t duration_ms, uint8_t magnitude) {
@@ -325,7 +325,7 @@ static void psmove_play_dual_rumble_now(uni_hid_device_t* d, uint16_t duration_m
     // Cache it until rumble is off. Might be used by LEDs
     ins->rumble_magnitude = magnitude;
 
-    psmove_send_output_report(d, &out);
+    psmove_send_output_report(d, &out, UNI_REPORT_KIND_RUMBLE);
 
     // Set timer to turn off rumble
     ins->rumble_timer_duration.process = &on_psmove_set_rumble_off;
@@ -347,10 +347,10 @@ static void on_psmove_set_rumble_off(btstack_timer_source_t* ts) {
     psmove_stop_rumble_now(d);
 }
 
-static void psmove_send_output_report(uni_hid_device_t* d, psmove_output_report_t* out) {
+static void psmove_send_output_report(uni_hid_device_t* d, psmove_output_report_t* out, uni_report_kind_t kind) {
     /* Should be 0xa2 */
     out->transaction_type = (HID_MESSAGE_TYPE_DATA << 4) | HID_REPORT_TYPE_OUTPUT;
 
     // uni_hid_device_send_ctrl_report(d, (uint8_t*)out, sizeof(*out));
-    uni_hid_device_send_intr_report(d, (uint8_t*)out, sizeof(*out));
+    uni_hid_device_send_intr_report_latest(d, kind, (uint8_t*)out, sizeof(*out));
 }
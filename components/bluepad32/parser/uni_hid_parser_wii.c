@@ -1427,7 +1427,7 @@ static void wii_set_led(uni_hid_device_t* d, uni_gamepad_seat_t seat) {
         led |= 0x01;
 
     report[2] = led;
-    uni_hid_device_send_intr_report(d, report, sizeof(report));
+    uni_hid_device_send_intr_report_latest(d, UNI_REPORT_KIND_PLAYER_LEDS, report, sizeof(report));
 }
 
 static void wii_stop_rumble_now(uni_hid_device_t* d) {
@@ -1441,7 +1441,7 @@ static void wii_stop_rumble_now(uni_hid_device_t* d) {
     uint8_t report[] = {
         0xa2, WIIPROTO_REQ_RUMBLE, 0x00 /* Rumble off*/
     };
-    uni_hid_device_send_intr_report(d, report, sizeof(report));
+    uni_hid_device_send_intr_report_latest(d, UNI_REPORT_KIND_RUMBLE, report, sizeof(report));
 }
 
 static void wii_play_dual_rumble_now(uni_hid_device_t* d, uint16_t duration_ms) {
@@ -1456,7 +1456,7 @@ static void wii_play_dual_rumble_now(uni_hid_device_t* d, uint16_t duration_ms)
     uint8_t report[] = {
         0xa2, WIIPROTO_REQ_RUMBLE, 0x01 /* Rumble on*/
     };
-    uni_hid_device_send_intr_report(d, report, sizeof(report));
+    uni_hid_device_send_intr_report_latest(d, UNI_REPORT_KIND_RUMBLE, report, sizeof(report));
 
     // Set timer to turn off rumble
     ins->rumble_timer_duration.process = &on_wii_set_rumble_off;
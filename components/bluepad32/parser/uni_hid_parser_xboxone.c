@@ -628,7 +628,7 @@ static void xboxone_stop_rumble_now(uni_hid_device_t* d) {
         }
         // else, SUCCESS
     } else {
-        uni_hid_device_send_intr_report(d, (uint8_t*)&ff, sizeof(ff));
+        uni_hid_device_send_intr_report_latest(d, UNI_REPORT_KIND_RUMBLE, (uint8_t*)&ff, sizeof(ff));
     }
 }
 
@@ -688,7 +688,7 @@ static void xboxone_play_quad_rumble_now(uni_hid_device_t* d,
             return;
         }
     } else {
-        uni_hid_device_send_intr_report(d, (uint8_t*)&ff, sizeof(ff));
+        uni_hid_device_send_intr_report_latest(d, UNI_REPORT_KIND_RUMBLE, (uint8_t*)&ff, sizeof(ff));
     }
 
     // Set timer to turn off rumble
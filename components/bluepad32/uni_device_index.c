@@ -0,0 +1,55 @@
+// SPDX-License-Identifier: Apache-2.0
+
+#include "uni_device_index.h"
+
+#include <stddef.h>
+
+#define INDEX_MASK (UNI_DEVICE_INDEX_SLOTS - 1)
+
+static unsigned index_hash(uint16_t key) {
+    // Fibonacci hashing: L2CAP cids and connection handles are mostly consecutive numbers.
+    return ((uint16_t)(key * 40503u)) >> (16 - UNI_DEVICE_INDEX_BITS);
+}
+
+void uni_device_index_insert(uni_device_index_t* t, uint16_t key, int idx) {
+    unsigned i = index_hash(key);
+    while (t->slots[i].dev != 0)
+        i = (i + 1) & INDEX_MASK;
+    t->slots[i].key = key;
+    t->slots[i].dev = idx + 1;
+}
+
+void uni_device_index_remove(uni_device_index_t* t, uint16_t key, int idx) {
+    unsigned i = index_hash(key);
+    while (t->slots[i].dev != 0 && (t->slots[i].key != key || t->slots[i].dev != idx + 1))
+        i = (i + 1) & INDEX_MASK;
+    if (t->slots[i].dev == 0)
+        return;
+
+    // Backward shift deletion: move up the following entries of the chain that can't be reached otherwise.
+    unsigned j = i;
+    while (true) {
+        j = (j + 1) & INDEX_MASK;
+        if (t->slots[j].dev == 0)
+            break;
+        unsigned home = index_hash(t->slots[j].key);
+        if (((j - home) & INDEX_MASK) >= ((j - i) & INDEX_MASK)) {
+            t->slots[i] = t->slots[j];
+            i = j;
+        }
+    }
+    t->slots[i].dev = 0;
+}
+
+int uni_device_index_find(const uni_device_index_t* t, uint16_t key, uni_device_index_match_t match, const void* data) {
+    int found = -1;
+    for (unsigned i = index_hash(key); t->slots[i].dev != 0; i = (i + 1) & INDEX_MASK) {
+        int idx = t->slots[i].dev - 1;
+        if (t->slots[i].key != key || (found >= 0 && idx > found))
+            continue;
+        if (match != NULL && !match(idx, data))
+            continue;
+        found = idx;
+    }
+    return found;
+}
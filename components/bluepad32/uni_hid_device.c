@@ -37,6 +37,8 @@
 #include "platform/uni_platform.h"
 #include "uni_common.h"
 #include "uni_config.h"
+#include "uni_device_index.h"
+#include "uni_latency.h"
 #include "uni_log.h"
 #include "uni_virtual_device.h"
 
@@ -55,11 +57,39 @@ enum {
 static uni_hid_device_t g_devices[CONFIG_BLUEPAD32_MAX_DEVICES];
 static const bd_addr_t zero_addr = {0, 0, 0, 0, 0, 0};
 
+// Device lookup indexes (see uni_device_index.h), updated when a key of a device changes.
+enum {
+    DEVICE_KEY_CONTROL_CID,
+    DEVICE_KEY_INTERRUPT_CID,
+    DEVICE_KEY_HIDS_CID,
+    DEVICE_KEY_HANDLE,
+    DEVICE_KEY_ADDRESS,
+    DEVICE_KEY_COUNT,
+};
+
+// Keys of each device that are currently in the indexes.
+typedef struct {
+    uint16_t key[DEVICE_KEY_COUNT];
+    uint8_t valid;  // Bitmask of DEVICE_KEY_xxx
+} device_keys_t;
+
+static uni_device_index_t g_cid_index;
+static uni_device_index_t g_hids_cid_index;
+static uni_device_index_t g_handle_index;
+static uni_device_index_t g_address_index;
+static uni_device_index_t* const g_key_index[DEVICE_KEY_COUNT] = {
+    [DEVICE_KEY_CONTROL_CID] = &g_cid_index,   [DEVICE_KEY_INTERRUPT_CID] = &g_cid_index,
+    [DEVICE_KEY_HIDS_CID] = &g_hids_cid_index, [DEVICE_KEY_HANDLE] = &g_handle_index,
+    [DEVICE_KEY_ADDRESS] = &g_address_index,
+};
+static device_keys_t g_device_keys[CONFIG_BLUEPAD32_MAX_DEVICES];
+
 static void process_misc_button_system(uni_hid_device_t* d);
 static void process_misc_button_home(uni_hid_device_t* d);
 static void misc_button_enable_callback(btstack_timer_source_t* ts);
 static void device_connection_timeout(btstack_timer_source_t* ts);
 static void start_connection_timeout(uni_hid_device_t* d);
+static void device_index_sync(const uni_hid_device_t* d);
 
 void uni_hid_device_setup(void) {
     for (int i = 0; i < CONFIG_BLUEPAD32_MAX_DEVICES; i++)
@@ -73,6 +103,7 @@ uni_hid_device_t* uni_hid_device_create(bd_addr_t address) {
 
             memset(&g_devices[i], 0, sizeof(g_devices[i]));
             bd_addr_copy(g_devices[i].conn.btaddr, address);
+            device_index_sync(&g_devices[i]);
 
             // Delete device if it doesn't have a connection
             start_connection_timeout(&g_devices[i]);
@@ -111,6 +142,7 @@ uni_hid_device_t* uni_hid_device_create_virtual(uni_hid_device_t* parent) {
             g_devices[i].flags |= FLAGS_HAS_CONTROLLER_TYPE;
 
             snprintf(g_devices[i].name, sizeof(g_devices[i].name), "virtual-%d", i);
+            device_index_sync(&g_devices[i]);
 
             return &g_devices[i];
         }
@@ -127,47 +159,87 @@ void uni_hid_device_init(uni_hid_device_t* d) {
     d->hids_cid = 0xffff;
 
     uni_bt_conn_init(&d->conn);
+    device_index_sync(d);
+    uni_report_queue_reset(uni_hid_device_get_idx_for_instance(d));
 }
 
-uni_hid_device_t* uni_hid_device_get_instance_for_address(bd_addr_t addr) {
-    for (int i = 0; i < CONFIG_BLUEPAD32_MAX_DEVICES; i++) {
-        // Ignore virtual devices since they share the same address with their parents
-        if (!uni_hid_device_is_virtual_device(&g_devices[i]) && bd_addr_cmp(addr, g_devices[i].conn.btaddr) == 0) {
-            return &g_devices[i];
-        }
+static uint16_t device_address_key(const bd_addr_t addr) {
+    return big_endian_read_16(addr, 0) ^ big_endian_read_16(addr, 2) ^ big_endian_read_16(addr, 4);
+}
+
+// Address keys are hashes, so the device address must match as well.
+static bool device_address_matches(int idx, const void* addr) {
+    return bd_addr_cmp(addr, g_devices[idx].conn.btaddr) == 0;
+}
+
+// Updates the indexes after the device keys changed.
+static void device_index_sync(const uni_hid_device_t* d) {
+    int idx = uni_hid_device_get_idx_for_instance(d);
+    if (idx < 0)
+        return;
+
+    device_keys_t now = {0};
+    if (d->conn.control_cid != 0) {
+        now.key[DEVICE_KEY_CONTROL_CID] = d->conn.control_cid;
+        now.valid |= BIT(DEVICE_KEY_CONTROL_CID);
     }
-    return NULL;
+    if (d->conn.interrupt_cid != 0) {
+        now.key[DEVICE_KEY_INTERRUPT_CID] = d->conn.interrupt_cid;
+        now.valid |= BIT(DEVICE_KEY_INTERRUPT_CID);
+    }
+    // 0xffff: no HIDS client
+    if (d->hids_cid != 0 && d->hids_cid != 0xffff) {
+        now.key[DEVICE_KEY_HIDS_CID] = d->hids_cid;
+        now.valid |= BIT(DEVICE_KEY_HIDS_CID);
+    }
+    if (d->conn.handle != UNI_BT_CONN_HANDLE_INVALID) {
+        now.key[DEVICE_KEY_HANDLE] = d->conn.handle;
+        now.valid |= BIT(DEVICE_KEY_HANDLE);
+    }
+    // Virtual devices share the address with their parents, and free devices have a zero address.
+    if (!uni_hid_device_is_virtual_device(d) && bd_addr_cmp(d->conn.btaddr, zero_addr) != 0) {
+        now.key[DEVICE_KEY_ADDRESS] = device_address_key(d->conn.btaddr);
+        now.valid |= BIT(DEVICE_KEY_ADDRESS);
+    }
+
+    device_keys_t* old = &g_device_keys[idx];
+    for (int k = 0; k < DEVICE_KEY_COUNT; k++) {
+        bool was_valid = (old->valid & BIT(k)) != 0;
+        bool is_valid = (now.valid & BIT(k)) != 0;
+        if (was_valid == is_valid && (!is_valid || old->key[k] == now.key[k]))
+            continue;
+        if (was_valid)
+            uni_device_index_remove(g_key_index[k], old->key[k], idx);
+        if (is_valid)
+            uni_device_index_insert(g_key_index[k], now.key[k], idx);
+    }
+    *old = now;
+}
+
+uni_hid_device_t* uni_hid_device_get_instance_for_address(bd_addr_t addr) {
+    int idx = uni_device_index_find(&g_address_index, device_address_key(addr), device_address_matches, addr);
+    return idx < 0 ? NULL : &g_devices[idx];
 }
 
 uni_hid_device_t* uni_hid_device_get_instance_for_cid(uint16_t cid) {
     if (cid == 0)
         return NULL;
-    for (int i = 0; i < CONFIG_BLUEPAD32_MAX_DEVICES; i++) {
-        if (g_devices[i].conn.interrupt_cid == cid || g_devices[i].conn.control_cid == cid)
-            return &g_devices[i];
-    }
-    return NULL;
+    int idx = uni_device_index_find(&g_cid_index, cid, NULL, NULL);
+    return idx < 0 ? NULL : &g_devices[idx];
 }
 
 uni_hid_device_t* uni_hid_device_get_instance_for_hids_cid(uint16_t cid) {
     if (cid == 0)
         return NULL;
-    for (int i = 0; i < CONFIG_BLUEPAD32_MAX_DEVICES; i++) {
-        if (g_devices[i].hids_cid == cid)
-            return &g_devices[i];
-    }
-    return NULL;
+    int idx = uni_device_index_find(&g_hids_cid_index, cid, NULL, NULL);
+    return idx < 0 ? NULL : &g_devices[idx];
 }
 
 uni_hid_device_t* uni_hid_device_get_instance_for_connection_handle(hci_con_handle_t handle) {
     if (handle == UNI_BT_CONN_HANDLE_INVALID)
         return NULL;
-    for (int i = 0; i < CONFIG_BLUEPAD32_MAX_DEVICES; i++) {
-        if (g_devices[i].conn.handle == handle) {
-            return &g_devices[i];
-        }
-    }
-    return NULL;
+    int idx = uni_device_index_find(&g_handle_index, handle, NULL, NULL);
+    return idx < 0 ? NULL : &g_devices[idx];
 }
 
 uni_hid_device_t* uni_hid_device_get_instance_with_predicate(uni_hid_device_predicate_t predicate, void* data) {
@@ -387,10 +459,13 @@ void uni_hid_device_set_hid_descriptor(uni_hid_device_t* d, const uint8_t* descr
     }
 
     int min = btstack_min(HID_MAX_DESCRIPTOR_LEN, len);
-    memcpy(d->hid_descriptor, descriptor, len);
+    memcpy(d->hid_descriptor, descriptor, min);
     d->hid_descriptor_len = min;
     d->flags |= FLAGS_HAS_HID_DESCRIPTOR;
 
+    // Build the per-report-ID field tables once, instead of walking the descriptor on each report.
+    uni_hid_parser_compile_descriptor(d);
+
     //    printf_hexdump(descriptor, len);
 }
 
@@ -768,6 +843,22 @@ bool uni_hid_device_has_controller_type(const uni_hid_device_t* d) {
 
 void uni_hid_device_set_connection_handle(uni_hid_device_t* d, hci_con_handle_t handle) {
     d->conn.handle = handle;
+    device_index_sync(d);
+}
+
+void uni_hid_device_set_control_cid(uni_hid_device_t* d, uint16_t cid) {
+    d->conn.control_cid = cid;
+    device_index_sync(d);
+}
+
+void uni_hid_device_set_interrupt_cid(uni_hid_device_t* d, uint16_t cid) {
+    d->conn.interrupt_cid = cid;
+    device_index_sync(d);
+}
+
+void uni_hid_device_set_hids_cid(uni_hid_device_t* d, uint16_t hids_cid) {
+    d->hids_cid = hids_cid;
+    device_index_sync(d);
 }
 
 void uni_hid_device_process_controller(uni_hid_device_t* d) {
@@ -781,6 +872,8 @@ void uni_hid_device_process_controller(uni_hid_device_t* d) {
         d->controller.gamepad = gp;
     }
 
+    uni_latency_mark(UNI_LATENCY_STAGE_CONTROLLER_DATA);
+
     if (uni_get_platform()->on_controller_data != NULL)
         uni_get_platform()->on_controller_data(d, &d->controller);
     else if (uni_get_platform()->on_gamepad_data != NULL)
@@ -794,7 +887,11 @@ void uni_hid_device_process_controller(uni_hid_device_t* d) {
 
 // Try to send the report now. If it can't, queue it and send it in the next
 // event loop.
-void uni_hid_device_send_report(uni_hid_device_t* d, uint16_t cid, const uint8_t* report, uint16_t len) {
+static void send_report(uni_hid_device_t* d,
+                        uint16_t cid,
+                        uni_report_kind_t kind,
+                        const uint8_t* report,
+                        uint16_t len) {
     if (d == NULL) {
         loge("Send report: Invalid device\n");
         return;
@@ -809,16 +906,28 @@ void uni_hid_device_send_report(uni_hid_device_t* d, uint16_t cid, const uint8_t
         return;
     }
 
-    int err = l2cap_send(cid, (uint8_t*)report, len);
-    if (err != 0) {
+    int idx = uni_hid_device_get_idx_for_instance(d);
+    bool queued = !uni_report_queue_is_empty(idx);
+
+    // Reports queued before this one must be sent first. The "can send now" event was already
+    // requested for them.
+    if (!queued) {
+        int err = l2cap_send(cid, (uint8_t*)report, len);
+        if (err == 0)
+            return;
         logd("Could not send report (error=0x%04x). Adding it to queue\n", err);
-        if (uni_circular_buffer_put(&d->outgoing_buffer, cid, report, len) != 0) {
-            loge("ERROR: circular buffer full. Cannot queue report\n");
-        }
     }
-    // Even, if it can send the report, trigger a "can send now event" in case a report was queued.
-    // TODO: Is this really needed?
-    l2cap_request_can_send_now_event(cid);
+
+    if (uni_report_queue_put(idx, cid, kind, report, len) != UNI_REPORT_QUEUE_ERROR_OK) {
+        loge("ERROR: report queue full. Cannot queue report\n");
+        return;
+    }
+    if (!queued)
+        l2cap_request_can_send_now_event(cid);
+}
+
+void uni_hid_device_send_report(uni_hid_device_t* d, uint16_t cid, const uint8_t* report, uint16_t len) {
+    send_report(d, cid, UNI_REPORT_KIND_NONE, report, len);
 }
 
 // Sends an interrupt-report. If it can't, it will queue it and try again later.
@@ -840,26 +949,51 @@ void uni_hid_device_send_ctrl_report(uni_hid_device_t* d, const uint8_t* report,
     uni_hid_device_send_report(d, d->conn.control_cid, report, len);
 }
 
-// Send the reports that are already queued. Uses the "intr" channel.
-void uni_hid_device_send_queued_reports(uni_hid_device_t* d) {
+void uni_hid_device_send_intr_report_latest(uni_hid_device_t* d,
+                                            uni_report_kind_t kind,
+                                            const uint8_t* report,
+                                            uint16_t len) {
     if (d == NULL) {
         loge("Invalid device\n");
         return;
     }
+    send_report(d, d->conn.interrupt_cid, kind, report, len);
+}
 
-    if (uni_circular_buffer_is_empty(&d->outgoing_buffer)) {
-        logd("circular buffer empty?\n");
+void uni_hid_device_send_ctrl_report_latest(uni_hid_device_t* d,
+                                            uni_report_kind_t kind,
+                                            const uint8_t* report,
+                                            uint16_t len) {
+    if (d == NULL) {
+        loge("Invalid device\n");
         return;
     }
+    send_report(d, d->conn.control_cid, kind, report, len);
+}
 
-    void* data;
-    int data_len;
-    int16_t cid;
-    if (uni_circular_buffer_get(&d->outgoing_buffer, &cid, &data, &data_len) != UNI_CIRCULAR_BUFFER_ERROR_OK) {
-        loge("ERROR: could not get buffer from circular buffer.\n");
+// Send the reports that are already queued. Called on L2CAP_EVENT_CAN_SEND_NOW.
+void uni_hid_device_send_queued_reports(uni_hid_device_t* d) {
+    if (d == NULL) {
+        loge("Invalid device\n");
         return;
     }
-    uni_hid_device_send_report(d, cid, data, data_len);
+
+    int idx = uni_hid_device_get_idx_for_instance(d);
+    uint16_t cid;
+    const uint8_t* data;
+    uint16_t data_len;
+
+    // Send as many as possible, in order. Sent directly from the queue, without copying them.
+    while (uni_report_queue_peek(idx, &cid, &data, &data_len)) {
+        int err = l2cap_send(cid, data, data_len);
+        if (err == L2CAP_LOCAL_CID_DOES_NOT_EXIST) {
+            logi("Dropping queued report for closed cid 0x%04x\n", cid);
+        } else if (err != 0) {
+            l2cap_request_can_send_now_event(cid);
+            return;
+        }
+        uni_report_queue_pop(idx);
+    }
 }
 
 bool uni_hid_device_does_require_hid_descriptor(const uni_hid_device_t* d) {
@@ -13,6 +13,7 @@
 #include "uni_config.h"
 #include "uni_console.h"
 #include "uni_hid_device.h"
+#include "uni_latency.h"
 #include "uni_log.h"
 #include "uni_property.h"
 #include "uni_version.h"
@@ -33,6 +34,7 @@ int uni_init(int argc, const char** argv) {
     loge("Version: v" BTSTACK_VERSION_STRING "\n");
 
     uni_property_init();
+    uni_latency_init();
     uni_platform_init(argc, argv);
     uni_hid_device_setup();
 
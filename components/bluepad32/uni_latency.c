@@ -0,0 +1,233 @@
+// SPDX-License-Identifier: Apache-2.0
+
+#include "uni_latency.h"
+
+#include <stdatomic.h>
+#include <string.h>
+
+#include <esp_console.h>
+#include <esp_timer.h>
+#include <freertos/FreeRTOS.h>
+#include <freertos/task.h>
+
+#include "uni_common.h"
+#include "uni_log.h"
+
+#ifdef CONFIG_BLUEPAD32_LATENCY_TRACE
+
+// Log-linear histogram: 4 buckets per power of two.
+// Values 0-3 have their own bucket, and the relative error is at most 25%.
+#define HIST_SUB_BITS 2
+#define HIST_SUB_COUNT (1 << HIST_SUB_BITS)
+#define HIST_BUCKETS ((32 - HIST_SUB_BITS + 1) * HIST_SUB_COUNT)
+
+// Each histogram has a single writer: the task that marks its stage.
+typedef struct {
+    uint32_t buckets[HIST_BUCKETS];
+    uint32_t max;
+} histogram_t;
+
+typedef struct {
+    uint32_t time_us;
+    uint8_t stage;
+} trace_event_t;
+
+static const char* const stage_names[UNI_LATENCY_STAGE_COUNT + 1] = {
+    [UNI_LATENCY_STAGE_HCI_RX] = "hci_rx",
+    [UNI_LATENCY_STAGE_HID_REPORT] = "hid_report",
+    [UNI_LATENCY_STAGE_CONTROLLER_DATA] = "controller_data",
+    [UNI_LATENCY_STAGE_APP_INPUT] = "app_input",
+    [UNI_LATENCY_STAGE_APP_OUTPUT] = "app_output",
+    [UNI_LATENCY_STAGE_COUNT] = "total",
+};
+
+// Last time each stage was reached, and a sequence number so the next stage
+// can tell whether something new came through.
+static volatile uint32_t stage_time_us[UNI_LATENCY_STAGE_COUNT];
+static volatile uint32_t stage_origin_us[UNI_LATENCY_STAGE_COUNT];
+static volatile uint32_t stage_seq[UNI_LATENCY_STAGE_COUNT];
+static uint32_t stage_seen_seq[UNI_LATENCY_STAGE_COUNT];
+
+// [UNI_LATENCY_STAGE_COUNT] holds the end-to-end latency
+static histogram_t histograms[UNI_LATENCY_STAGE_COUNT + 1];
+
+// Per-core event rings. Slots are claimed with an atomic increment, so tasks
+// on the same core can't overwrite each other's slot.
+static trace_event_t rings[portNUM_PROCESSORS][UNI_LATENCY_RING_SIZE];
+static atomic_uint ring_head[portNUM_PROCESSORS];
+
+static esp_timer_handle_t log_timer;
+
+static inline int bucket_index(uint32_t v) {
+    if (v < HIST_SUB_COUNT)
+        return v;
+    int msb = 31 - __builtin_clz(v);
+    int sub = (v >> (msb - HIST_SUB_BITS)) & (HIST_SUB_COUNT - 1);
+    return (msb - HIST_SUB_BITS + 1) * HIST_SUB_COUNT + sub;
+}
+
+static uint32_t bucket_upper_bound(int index) {
+    if (index < HIST_SUB_COUNT)
+        return index;
+    int msb = index / HIST_SUB_COUNT + HIST_SUB_BITS - 1;
+    int sub = index % HIST_SUB_COUNT;
+    uint32_t width = 1u << (msb - HIST_SUB_BITS);
+    return ((HIST_SUB_COUNT + sub) * width) + width - 1;
+}
+
+static inline void histogram_add(histogram_t* h, uint32_t v) {
+    h->buckets[bucket_index(v)]++;
+    if (v > h->max)
+        h->max = v;
+}
+
+static uint32_t histogram_percentile(const histogram_t* h, uint32_t count, uint32_t percent) {
+    uint32_t target = (count * percent + 99) / 100;
+    uint32_t sum = 0;
+    for (int i = 0; i < HIST_BUCKETS; i++) {
+        sum += h->buckets[i];
+        if (sum >= target) {
+            uint32_t upper = bucket_upper_bound(i);
+            return upper < h->max ? upper : h->max;
+        }
+    }
+    return h->max;
+}
+
+void uni_latency_mark(uni_latency_stage_t stage) {
+    uint32_t now = (uint32_t)esp_timer_get_time();
+
+    int core = xPortGetCoreID();
+    unsigned int slot = atomic_fetch_add_explicit(&ring_head[core], 1, memory_order_relaxed);
+    trace_event_t* e = &rings[core][slot % UNI_LATENCY_RING_SIZE];
+    e->time_us = now;
+    e->stage = stage;
+
+    if (stage == UNI_LATENCY_STAGE_HCI_RX) {
+        stage_origin_us[stage] = now;
+    } else {
+        int prev = stage - 1;
+        uint32_t seq = stage_seq[prev];
+        if (seq == stage_seen_seq[stage])
+            return;
+        stage_seen_seq[stage] = seq;
+        histogram_add(&histograms[stage], now - stage_time_us[prev]);
+        stage_origin_us[stage] = stage_origin_us[prev];
+        if (stage == UNI_LATENCY_STAGE_COUNT - 1)
+            histogram_add(&histograms[UNI_LATENCY_STAGE_COUNT], now - stage_origin_us[stage]);
+    }
+    stage_time_us[stage] = now;
+    stage_seq[stage]++;
+}
+
+void uni_latency_get_stats(uni_latency_stage_t stage, uni_latency_stats_t* out) {
+    memset(out, 0, sizeof(*out));
+    if (stage > UNI_LATENCY_STAGE_COUNT)
+        return;
+
+    // Snapshot first: the writer may update it while we walk the buckets.
+    histogram_t copy = histograms[stage];
+
+    uint32_t count = 0;
+    for (int i = 0; i < HIST_BUCKETS; i++)
+        count += copy.buckets[i];
+    if (count == 0)
+        return;
+
+    out->count = count;
+    out->p50_us = histogram_percentile(&copy, count, 50);
+    out->p99_us = histogram_percentile(&copy, count, 99);
+    out->max_us = copy.max;
+}
+
+void uni_latency_reset(void) {
+    memset(histograms, 0, sizeof(histograms));
+}
+
+void uni_latency_log_summary(void) {
+    uni_latency_stats_t stats;
+    for (int i = UNI_LATENCY_STAGE_HID_REPORT; i <= UNI_LATENCY_STAGE_COUNT; i++) {
+        uni_latency_get_stats(i, &stats);
+        if (stats.count == 0)
+            continue;
+        logi("latency %-16s n=%lu p50=%lu p99=%lu max=%lu us\n", stage_names[i], (unsigned long)stats.count,
+             (unsigned long)stats.p50_us, (unsigned long)stats.p99_us, (unsigned long)stats.max_us);
+    }
+}
+
+static void log_timer_cb(void* arg) {
+    ARG_UNUSED(arg);
+    uni_latency_log_summary();
+}
+
+void uni_latency_init(void) {
+#if CONFIG_BLUEPAD32_LATENCY_LOG_PERIOD_MS > 0
+    const esp_timer_create_args_t args = {
+        .callback = &log_timer_cb,
+        .name = "uni_latency",
+    };
+    if (esp_timer_create(&args, &log_timer) != ESP_OK) {
+        loge("latency: failed to create log timer\n");
+        return;
+    }
+    esp_timer_start_periodic(log_timer, CONFIG_BLUEPAD32_LATENCY_LOG_PERIOD_MS * 1000ULL);
+#else
+    ARG_UNUSED(log_timer);
+    ARG_UNUSED(log_timer_cb);
+#endif
+}
+
+static void print_trace(void) {
+    for (int core = 0; core < portNUM_PROCESSORS; core++) {
+        unsigned int head = atomic_load(&ring_head[core]);
+        unsigned int n = head < UNI_LATENCY_RING_SIZE ? head : UNI_LATENCY_RING_SIZE;
+        logi("core %d: last %u events\n", core, n);
+        for (unsigned int i = head - n; i != head; i++) {
+            const trace_event_t* e = &rings[core][i % UNI_LATENCY_RING_SIZE];
+            logi("  %10lu us  %s\n", (unsigned long)e->time_us, stage_names[e->stage]);
+        }
+    }
+}
+
+static int cmd_latency(int argc, char** argv) {
+    if (argc > 1 && strcmp(argv[1], "reset") == 0) {
+        uni_latency_reset();
+        return 0;
+    }
+    if (argc > 1 && strcmp(argv[1], "trace") == 0) {
+        print_trace();
+        return 0;
+    }
+
+    uni_latency_stats_t stats;
+    logi("%-16s %8s %8s %8s %8s\n", "stage", "count", "p50 us", "p99 us", "max us");
+    for (int i = UNI_LATENCY_STAGE_HID_REPORT; i <= UNI_LATENCY_STAGE_COUNT; i++) {
+        uni_latency_get_stats(i, &stats);
+        logi("%-16s %8lu %8lu %8lu %8lu\n", stage_names[i], (unsigned long)stats.count, (unsigned long)stats.p50_us,
+             (unsigned long)stats.p99_us, (unsigned long)stats.max_us);
+    }
+    return 0;
+}
+
+void uni_latency_register_cmds(void) {
+    const esp_console_cmd_t latency = {
+        .command = "latency",
+        .help =
+            "Shows the input latency histograms (each stage measured from the previous one).\n"
+            "  'latency reset' clears them, 'latency trace' dumps the last events per core",
+        .hint = "[reset | trace]",
+        .func = &cmd_latency,
+    };
+
+    ESP_ERROR_CHECK(esp_console_cmd_register(&latency));
+}
+
+// Called by the BTstack ESP32 port for every packet received from the controller.
+// Overrides the weak no-op defined there.
+void btstack_port_esp32_on_hci_packet(uint8_t packet_type) {
+    // HCI_ACL_DATA_PACKET: HID reports arrive as ACL data
+    if (packet_type == 0x02)
+        uni_latency_mark(UNI_LATENCY_STAGE_HCI_RX);
+}
+
+#endif  // CONFIG_BLUEPAD32_LATENCY_TRACE
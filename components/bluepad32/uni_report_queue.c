@@ -0,0 +1,119 @@
+// SPDX-License-Identifier: Apache-2.0
+
+#include "uni_report_queue.h"
+
+#include <string.h>
+
+#include "uni_log.h"
+
+// Packets are stored back to back, in the order they were queued:
+// [header][data][header][data]...
+// Removing a packet moves the following ones down. The queue is almost always empty,
+// and when it isn't, it only has a few packets.
+typedef struct {
+    uint16_t cid;
+    uint16_t len;
+    uint8_t dev_idx;
+    uint8_t kind;
+} packet_header_t;
+
+static uint8_t arena[UNI_REPORT_QUEUE_ARENA_SIZE];
+static uint16_t arena_used;
+static uint16_t device_used[CONFIG_BLUEPAD32_MAX_DEVICES];
+
+static packet_header_t read_header(uint16_t offset) {
+    packet_header_t h;
+    memcpy(&h, &arena[offset], sizeof(h));
+    return h;
+}
+
+// Returns the offset of the first packet of the device that matches the kind (or any kind if NONE),
+// or -1 if there is none.
+static int find_packet(int dev_idx, uint16_t cid, uni_report_kind_t kind) {
+    uint16_t offset = 0;
+    while (offset < arena_used) {
+        packet_header_t h = read_header(offset);
+        if (h.dev_idx == dev_idx && (kind == UNI_REPORT_KIND_NONE || (h.kind == kind && h.cid == cid)))
+            return offset;
+        offset += sizeof(h) + h.len;
+    }
+    return -1;
+}
+
+static void remove_packet(uint16_t offset) {
+    packet_header_t h = read_header(offset);
+    uint16_t size = sizeof(h) + h.len;
+
+    memmove(&arena[offset], &arena[offset + size], arena_used - offset - size);
+    arena_used -= size;
+    device_used[h.dev_idx] -= size;
+}
+
+uint8_t uni_report_queue_put(int dev_idx, uint16_t cid, uni_report_kind_t kind, const uint8_t* data, uint16_t len) {
+    if (dev_idx < 0 || dev_idx >= CONFIG_BLUEPAD32_MAX_DEVICES)
+        return UNI_REPORT_QUEUE_ERROR_QUEUE_FULL;
+
+    uint16_t size = sizeof(packet_header_t) + len;
+    if (size > UNI_REPORT_QUEUE_DEVICE_MAX_SIZE)
+        return UNI_REPORT_QUEUE_ERROR_REPORT_TOO_BIG;
+
+    // The newer report supersedes the queued one. It is added at the end, since it has to be sent
+    // after the reports that were queued before it.
+    if (kind != UNI_REPORT_KIND_NONE) {
+        int offset = find_packet(dev_idx, cid, kind);
+        if (offset >= 0) {
+            logd("Report queue: replacing queued report (kind=%d)\n", kind);
+            remove_packet(offset);
+        }
+    }
+
+    if (arena_used + size > UNI_REPORT_QUEUE_ARENA_SIZE ||
+        device_used[dev_idx] + size > UNI_REPORT_QUEUE_DEVICE_MAX_SIZE)
+        return UNI_REPORT_QUEUE_ERROR_QUEUE_FULL;
+
+    packet_header_t h = {
+        .cid = cid,
+        .len = len,
+        .dev_idx = dev_idx,
+        .kind = kind,
+    };
+    memcpy(&arena[arena_used], &h, sizeof(h));
+    memcpy(&arena[arena_used + sizeof(h)], data, len);
+    arena_used += size;
+    device_used[dev_idx] += size;
+    return UNI_REPORT_QUEUE_ERROR_OK;
+}
+
+bool uni_report_queue_peek(int dev_idx, uint16_t* cid, const uint8_t** data, uint16_t* len) {
+    if (uni_report_queue_is_empty(dev_idx))
+        return false;
+
+    int offset = find_packet(dev_idx, 0, UNI_REPORT_KIND_NONE);
+    if (offset < 0)
+        return false;
+    packet_header_t h = read_header(offset);
+    *cid = h.cid;
+    *data = &arena[offset + sizeof(h)];
+    *len = h.len;
+    return true;
+}
+
+void uni_report_queue_pop(int dev_idx) {
+    if (uni_report_queue_is_empty(dev_idx))
+        return;
+
+    int offset = find_packet(dev_idx, 0, UNI_REPORT_KIND_NONE);
+    if (offset >= 0)
+        remove_packet(offset);
+}
+
+bool uni_report_queue_is_empty(int dev_idx) {
+    if (dev_idx < 0 || dev_idx >= CONFIG_BLUEPAD32_MAX_DEVICES)
+        return true;
+    return device_used[dev_idx] == 0;
+}
+
+void uni_report_queue_reset(int dev_idx) {
+    while (!uni_report_queue_is_empty(dev_idx))
+        uni_report_queue_pop(dev_idx);
+}
@@ -130,6 +130,12 @@ static void panic_sent_called_from_isr(void) {
     printf("host_send_pkt_available_cb called from ISR!\n");
 }
 
+// Called for every packet received from the controller, before it is queued
+// for the BTstack thread. Applications can override it, e.g. for latency tracing.
+void __attribute__((weak)) btstack_port_esp32_on_hci_packet(uint8_t packet_type){
+    (void) packet_type;
+}
+
 // VHCI callbacks, run from VHCI Task "BT Controller"
 
 static void host_send_pkt_available_cb(void){
@@ -149,6 +155,8 @@ static int host_recv_pkt_cb(uint8_t *data, uint16_t len){
         return 0;
     }
 
+    btstack_port_esp32_on_hci_packet(data[0]);
+
     xSemaphoreTake(ring_buffer_mutex, portMAX_DELAY);
 
     // check space
@@ -53,6 +53,13 @@ extern "C" {
 
 uint8_t btstack_init(void);
 
+/**
+ * @brief Hook called from the VHCI task for every packet received from the controller.
+ * Default implementation is empty (weak). Must be fast and must not block.
+ * @param packet_type HCI packet type (H4)
+ */
+void btstack_port_esp32_on_hci_packet(uint8_t packet_type);
+
 #if defined __cplusplus
 }
 #endif
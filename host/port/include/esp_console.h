@@ -0,0 +1,20 @@
+#ifndef ESP_CONSOLE_H
+#define ESP_CONSOLE_H
+
+#include "esp_err.h"
+
+// 호스트 빌드용 esp_console: 등록된 명령은 시나리오의 cmd 줄에서 실행한다 (host/port/sim_console.c)
+typedef int (*esp_console_cmd_func_t)(int argc, char** argv);
+
+typedef struct {
+    const char* command;
+    const char* help;
+    const char* hint;
+    esp_console_cmd_func_t func;
+    void* argtable;
+} esp_console_cmd_t;
+
+// 함수 선언
+esp_err_t esp_console_cmd_register(const esp_console_cmd_t* cmd);
+
+#endif // ESP_CONSOLE_H
@@ -0,0 +1,14 @@
+#ifndef FREERTOS_QUEUE_H
+#define FREERTOS_QUEUE_H
+
+#include "FreeRTOS.h"
+
+typedef struct sim_queue* QueueHandle_t;
+
+// 함수 선언
+QueueHandle_t xQueueCreate(UBaseType_t length, UBaseType_t item_size);
+// 가득 차면 기다리지 않고 errQUEUE_FULL 반환 (main/ 은 대기 시간 0 으로만 보낸다)
+BaseType_t xQueueSend(QueueHandle_t queue, const void* item, TickType_t ticks_to_wait);
+BaseType_t xQueueReceive(QueueHandle_t queue, void* item, TickType_t ticks_to_wait);
+
+#endif // FREERTOS_QUEUE_H
@@ -0,0 +1,11 @@
+#ifndef SDKCONFIG_H
+#define SDKCONFIG_H
+
+// 호스트 빌드용 sdkconfig (sdkconfig.defaults 의 Bluepad32 설정 중 main/ 이 쓰는 값).
+// 기기 수는 기본값 (4) 보다 크게 잡아 번호 4 이상의 컨트롤러도 시나리오에서 다룬다
+#define CONFIG_BLUEPAD32_MAX_DEVICES 8
+#define CONFIG_BLUEPAD32_PLATFORM_CUSTOM 1
+#define CONFIG_BLUEPAD32_LOG_LEVEL_INFO 1
+#define CONFIG_TARGET_POSIX 1
+
+#endif // SDKCONFIG_H
@@ -0,0 +1,42 @@
+#include "sim_console.h"
+#include "esp_console.h"
+#include <stdio.h>
+#include <string.h>
+
+// 호스트 시뮬레이터용 콘솔: 등록만 받아두고 시나리오의 cmd 줄에서 실행한다
+
+#define SIM_CONSOLE_CMDS 48
+#define SIM_CONSOLE_ARGS 16
+#define SIM_CONSOLE_LINE 256
+
+static esp_console_cmd_t cmds[SIM_CONSOLE_CMDS];
+static int cmd_count = 0;
+
+esp_err_t esp_console_cmd_register(const esp_console_cmd_t* cmd) {
+    if (cmd_count >= SIM_CONSOLE_CMDS) {
+        return ESP_ERR_NO_MEM;
+    }
+    cmds[cmd_count++] = *cmd;
+    return ESP_OK;
+}
+
+int sim_console_run(const char* line) {
+    char buf[SIM_CONSOLE_LINE];
+    char* argv[SIM_CONSOLE_ARGS];
+    int argc = 0;
+
+    snprintf(buf, sizeof(buf), "%s", line);
+    for (char* tok = strtok(buf, " \t"); tok != NULL && argc < SIM_CONSOLE_ARGS; tok = strtok(NULL, " \t")) {
+        argv[argc++] = tok;
+    }
+    if (argc == 0) {
+        return -1;
+    }
+    for (int i = 0; i < cmd_count; i++) {
+        if (strcmp(cmds[i].command, argv[0]) == 0) {
+            return cmds[i].func(argc, argv);
+        }
+    }
+    fprintf(stderr, "sim_console: unknown command '%s'\n", argv[0]);
+    return -1;
+}
@@ -0,0 +1,8 @@
+#ifndef SIM_CONSOLE_H
+#define SIM_CONSOLE_H
+
+// 함수 선언
+// 명령 줄을 공백으로 나눠 등록된 콘솔 명령을 실행한다. 명령이 없으면 -1
+int sim_console_run(const char* line);
+
+#endif // SIM_CONSOLE_H
@@ -0,0 +1,135 @@
+#include "nvs.h"
+#include "nvs_flash.h"
+#include <stdbool.h>
+#include <stdlib.h>
+#include <string.h>
+
+// 호스트 시뮬레이터용 NVS: 프로세스 안에서만 유지되는 RAM 저장소 (blob 만 지원)
+
+#define SIM_NVS_ENTRIES    32
+#define SIM_NVS_NAMESPACES 8
+#define SIM_NVS_NAME_LEN   16  // NVS 키/네임스페이스 최대 15자 + NUL
+
+typedef struct {
+    nvs_handle_t ns;
+    char key[SIM_NVS_NAME_LEN];
+    void* value;
+    size_t length;
+} sim_nvs_entry_t;
+
+static char namespaces[SIM_NVS_NAMESPACES][SIM_NVS_NAME_LEN];
+static sim_nvs_entry_t entries[SIM_NVS_ENTRIES];
+static bool initialized = false;
+
+static sim_nvs_entry_t* find_entry(nvs_handle_t ns, const char* key) {
+    for (int i = 0; i < SIM_NVS_ENTRIES; i++) {
+        if (entries[i].value != NULL && entries[i].ns == ns && strcmp(entries[i].key, key) == 0) {
+            return &entries[i];
+        }
+    }
+    return NULL;
+}
+
+esp_err_t nvs_flash_init(void) {
+    initialized = true;
+    return ESP_OK;
+}
+
+esp_err_t nvs_flash_erase(void) {
+    for (int i = 0; i < SIM_NVS_ENTRIES; i++) {
+        free(entries[i].value);
+    }
+    memset(entries, 0, sizeof(entries));
+    memset(namespaces, 0, sizeof(namespaces));
+    return ESP_OK;
+}
+
+esp_err_t nvs_open(const char* name, nvs_open_mode_t open_mode, nvs_handle_t* out_handle) {
+    if (!initialized) {
+        return ESP_ERR_INVALID_STATE;
+    }
+    if (strlen(name) >= SIM_NVS_NAME_LEN) {
+        return ESP_ERR_INVALID_ARG;
+    }
+    for (int i = 0; i < SIM_NVS_NAMESPACES; i++) {
+        if (strcmp(namespaces[i], name) == 0) {
+            *out_handle = i + 1;
+            return ESP_OK;
+        }
+    }
+    // 읽기 전용으로 없는 네임스페이스를 열면 펌웨어처럼 NOT_FOUND
+    if (open_mode == NVS_READONLY) {
+        return ESP_ERR_NVS_NOT_FOUND;
+    }
+    for (int i = 0; i < SIM_NVS_NAMESPACES; i++) {
+        if (namespaces[i][0] == '\0') {
+            strcpy(namespaces[i], name);
+            *out_handle = i + 1;
+            return ESP_OK;
+        }
+    }
+    return ESP_ERR_NO_MEM;
+}
+
+esp_err_t nvs_get_blob(nvs_handle_t handle, const char* key, void* out_value, size_t* length) {
+    sim_nvs_entry_t* e = find_entry(handle, key);
+    if (e == NULL) {
+        return ESP_ERR_NVS_NOT_FOUND;
+    }
+    if (out_value == NULL) {
+        *length = e->length;
+        return ESP_OK;
+    }
+    if (*length < e->length) {
+        *length = e->length;
+        return ESP_ERR_NVS_INVALID_LENGTH;
+    }
+    memcpy(out_value, e->value, e->length);
+    *length = e->length;
+    return ESP_OK;
+}
+
+esp_err_t nvs_set_blob(nvs_handle_t handle, const char* key, const void* value, size_t length) {
+    if (strlen(key) >= SIM_NVS_NAME_LEN) {
+        return ESP_ERR_INVALID_ARG;
+    }
+    void* copy = malloc(length ? length : 1);
+    if (copy == NULL) {
+        return ESP_ERR_NO_MEM;
+    }
+    memcpy(copy, value, length);
+
+    sim_nvs_entry_t* e = find_entry(handle, key);
+    for (int i = 0; e == NULL && i < SIM_NVS_ENTRIES; i++) {
+        if (entries[i].value == NULL) {
+            e = &entries[i];
+            e->ns = handle;
+            strcpy(e->key, key);
+        }
+    }
+    if (e == NULL) {
+        free(copy);
+        return ESP_ERR_NO_MEM;
+    }
+    free(e->value);
+    e->value = copy;
+    e->length = length;
+    return ESP_OK;
+}
+
+esp_err_t nvs_erase_key(nvs_handle_t handle, const char* key) {
+    sim_nvs_entry_t* e = find_entry(handle, key);
+    if (e == NULL) {
+        return ESP_ERR_NVS_NOT_FOUND;
+    }
+    free(e->value);
+    memset(e, 0, sizeof(*e));
+    return ESP_OK;
+}
+
+esp_err_t nvs_commit(nvs_handle_t handle) {
+    return ESP_OK;
+}
+
+void nvs_close(nvs_handle_t handle) {
+}
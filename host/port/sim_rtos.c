@@ -0,0 +1,457 @@
+#include "sim_rtos.h"
+#include "rc_tank_hal.h"
+#include "esp_err.h"
+#include "esp_timer.h"
+#include "freertos/FreeRTOS.h"
+#include "freertos/queue.h"
+#include "freertos/task.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <ucontext.h>
+
+// 호스트 스택은 printf 등으로 펌웨어보다 많이 쓰므로 태스크 스택 크기와 관계없이 고정
+#define SIM_TASK_STACK (256 * 1024)
+#define SIM_FOREVER    INT64_MAX
+
+typedef enum {
+    TASK_READY,
+    TASK_BLOCKED,
+    TASK_DELETED,
+} task_state_t;
+
+typedef enum {
+    WAIT_NONE,
+    WAIT_DELAY,
+    WAIT_NOTIFY,
+    WAIT_QUEUE,
+} wait_kind_t;
+
+struct sim_task {
+    ucontext_t ctx;
+    void* stack;
+    TaskFunction_t fn;
+    void* arg;
+    const char* name;
+    UBaseType_t priority;
+    task_state_t state;
+    wait_kind_t wait;
+    int64_t wake_us;
+    QueueHandle_t wait_queue;
+    uint32_t notify_value;
+    bool notify_pending;
+    uint64_t ready_order;
+    struct sim_task* next;
+};
+
+struct sim_queue {
+    uint8_t* buf;
+    UBaseType_t length;
+    UBaseType_t item_size;
+    UBaseType_t head;
+    UBaseType_t count;
+};
+
+struct esp_timer {
+    sim_event_t event;  // 첫 멤버 (사건 콜백에서 타이머로 변환)
+    esp_timer_cb_t callback;
+    void* arg;
+    uint64_t period_us;  // 0: 한 번
+};
+
+static int64_t now_us = 0;
+static uint64_t next_order = 0;
+static sim_event_t* events = NULL;
+static struct sim_task* tasks = NULL;
+static struct sim_task* current = NULL;
+static ucontext_t sched_ctx;
+
+static void set_time(int64_t time_us) {
+    now_us = time_us;
+    rc_tank_hal_set_sim_time_us(time_us);
+}
+
+void sim_rtos_init(int64_t start_us) {
+    set_time(start_us);
+}
+
+int64_t sim_rtos_now_us(void) {
+    return now_us;
+}
+
+//
+// 사건
+//
+void sim_event_init(sim_event_t* event, sim_event_fn_t fn) {
+    memset(event, 0, sizeof(*event));
+    event->fn = fn;
+}
+
+void sim_event_cancel(sim_event_t* event) {
+    for (sim_event_t** p = &events; *p != NULL; p = &(*p)->next) {
+        if (*p == event) {
+            *p = event->next;
+            break;
+        }
+    }
+    event->queued = false;
+}
+
+void sim_event_schedule(sim_event_t* event, int64_t time_us) {
+    if (event->queued) {
+        sim_event_cancel(event);
+    }
+    event->time_us = time_us < now_us ? now_us : time_us;
+    event->order = next_order++;
+    event->queued = true;
+
+    sim_event_t** p = &events;
+    while (*p != NULL && (*p)->time_us <= event->time_us) {
+        p = &(*p)->next;
+    }
+    event->next = *p;
+    *p = event;
+}
+
+//
+// 태스크
+//
+static void make_ready(struct sim_task* t) {
+    t->state = TASK_READY;
+    t->wait = WAIT_NONE;
+    t->wake_us = SIM_FOREVER;
+    t->wait_queue = NULL;
+    t->ready_order = next_order++;
+}
+
+static void task_entry(void) {
+    current->fn(current->arg);
+    // FreeRTOS 태스크는 반환하면 안 되지만, 반환하면 삭제로 처리
+    vTaskDelete(NULL);
+}
+
+// 현재 태스크를 막고 스케줄러로 돌아간다. 깨어나면 반환
+static void block_current(wait_kind_t wait, TickType_t ticks, QueueHandle_t queue) {
+    if (current == NULL) {
+        fprintf(stderr, "sim_rtos: blocking call outside a task\n");
+        abort();
+    }
+    struct sim_task* t = current;
+    t->state = TASK_BLOCKED;
+    t->wait = wait;
+    t->wait_queue = queue;
+    t->wake_us = ticks == portMAX_DELAY ? SIM_FOREVER : now_us + (int64_t)ticks * portTICK_PERIOD_MS * 1000;
+    swapcontext(&t->ctx, &sched_ctx);
+}
+
+static struct sim_task* pick_ready(void) {
+    struct sim_task* best = NULL;
+    for (struct sim_task* t = tasks; t != NULL; t = t->next) {
+        if (t->state != TASK_READY) {
+            continue;
+        }
+        if (best == NULL || t->priority > best->priority ||
+            (t->priority == best->priority && t->ready_order < best->ready_order)) {
+            best = t;
+        }
+    }
+    return best;
+}
+
+static void reap_deleted(void) {
+    for (struct sim_task** p = &tasks; *p != NULL;) {
+        struct sim_task* t = *p;
+        if (t->state == TASK_DELETED && t != current) {
+            *p = t->next;
+            free(t->stack);
+            free(t);
+        } else {
+            p = &t->next;
+        }
+    }
+}
+
+// 준비된 태스크가 없을 때까지 우선순위 순으로 실행
+static void run_ready_tasks(void) {
+    struct sim_task* t;
+    while ((t = pick_ready()) != NULL) {
+        current = t;
+        swapcontext(&sched_ctx, &t->ctx);
+        current = NULL;
+        reap_deleted();
+    }
+}
+
+void sim_rtos_run_until(int64_t time_us) {
+    run_ready_tasks();
+    for (;;) {
+        int64_t next = events != NULL ? events->time_us : SIM_FOREVER;
+        for (struct sim_task* t = tasks; t != NULL; t = t->next) {
+            if (t->state == TASK_BLOCKED && t->wake_us < next) {
+                next = t->wake_us;
+            }
+        }
+        if (next > time_us) {
+            break;
+        }
+        if (next > now_us) {
+            set_time(next);
+        }
+
+        while (events != NULL && events->time_us <= now_us) {
+            sim_event_t* event = events;
+            events = event->next;
+            event->queued = false;
+            event->fn(event);
+            run_ready_tasks();
+        }
+        for (struct sim_task* t = tasks; t != NULL; t = t->next) {
+            if (t->state == TASK_BLOCKED && t->wake_us <= now_us) {
+                make_ready(t);
+            }
+        }
+        run_ready_tasks();
+    }
+    if (time_us > now_us) {
+        set_time(time_us);
+    }
+}
+
+BaseType_t xTaskCreate(TaskFunction_t task, const char* name, uint32_t stack_depth, void* arg,
+                       UBaseType_t priority, TaskHandle_t* out_handle) {
+    struct sim_task* t = calloc(1, sizeof(*t));
+    if (t == NULL || (t->stack = malloc(SIM_TASK_STACK)) == NULL) {
+        free(t);
+        return pdFAIL;
+    }
+    t->fn = task;
+    t->arg = arg;
+    t->name = name;
+    t->priority = priority;
+
+    getcontext(&t->ctx);
+    t->ctx.uc_stack.ss_sp = t->stack;
+    t->ctx.uc_stack.ss_size = SIM_TASK_STACK;
+    t->ctx.uc_link = &sched_ctx;
+    makecontext(&t->ctx, task_entry, 0);
+
+    make_ready(t);
+    struct sim_task** p = &tasks;
+    while (*p != NULL) {
+        p = &(*p)->next;
+    }
+    *p = t;
+
+    if (out_handle != NULL) {
+        *out_handle = t;
+    }
+    return pdPASS;
+}
+
+void vTaskDelete(TaskHandle_t task) {
+    if (task == NULL || task == current) {
+        current->state = TASK_DELETED;
+        swapcontext(&current->ctx, &sched_ctx);
+        return;  // 도달하지 않음
+    }
+    task->state = TASK_DELETED;
+    reap_deleted();
+}
+
+void vTaskDelay(TickType_t ticks) {
+    if (ticks == 0) {
+        make_ready(current);
+        swapcontext(&current->ctx, &sched_ctx);
+        return;
+    }
+    block_current(WAIT_DELAY, ticks, NULL);
+}
+
+TickType_t xTaskGetTickCount(void) {
+    return (TickType_t)(now_us / 1000 / portTICK_PERIOD_MS);
+}
+
+BaseType_t xTaskNotify(TaskHandle_t task, uint32_t value, eNotifyAction action) {
+    switch (action) {
+        case eSetBits:
+            task->notify_value |= value;
+            break;
+        case eIncrement:
+            task->notify_value++;
+            break;
+        case eSetValueWithOverwrite:
+            task->notify_value = value;
+            break;
+        case eNoAction:
+            break;
+    }
+    task->notify_pending = true;
+    if (task->state == TASK_BLOCKED && task->wait == WAIT_NOTIFY) {
+        make_ready(task);
+    }
+    return pdPASS;
+}
+
+BaseType_t xTaskNotifyGive(TaskHandle_t task) {
+    return xTaskNotify(task, 0, eIncrement);
+}
+
+uint32_t ulTaskNotifyTake(BaseType_t clear_on_exit, TickType_t ticks_to_wait) {
+    struct sim_task* t = current;
+    if (t->notify_value == 0 && ticks_to_wait != 0) {
+        block_current(WAIT_NOTIFY, ticks_to_wait, NULL);
+    }
+    uint32_t value = t->notify_value;
+    if (value != 0) {
+        t->notify_value = clear_on_exit ? 0 : value - 1;
+    }
+    t->notify_pending = false;
+    return value;
+}
+
+BaseType_t xTaskNotifyWait(uint32_t clear_on_entry, uint32_t clear_on_exit, uint32_t* value, TickType_t ticks_to_wait) {
+    struct sim_task* t = current;
+    if (!t->notify_pending) {
+        t->notify_value &= ~clear_on_entry;
+        if (ticks_to_wait != 0) {
+            block_current(WAIT_NOTIFY, ticks_to_wait, NULL);
+        }
+    }
+    if (value != NULL) {
+        *value = t->notify_value;
+    }
+    if (!t->notify_pending) {
+        return pdFALSE;
+    }
+    t->notify_value &= ~clear_on_exit;
+    t->notify_pending = false;
+    return pdTRUE;
+}
+
+//
+// 큐
+//
+QueueHandle_t xQueueCreate(UBaseType_t length, UBaseType_t item_size) {
+    struct sim_queue* q = calloc(1, sizeof(*q));
+    if (q == NULL || (q->buf = malloc(length * item_size)) == NULL) {
+        free(q);
+        return NULL;
+    }
+    q->length = length;
+    q->item_size = item_size;
+    return q;
+}
+
+BaseType_t xQueueSend(QueueHandle_t queue, const void* item, TickType_t ticks_to_wait) {
+    if (queue->count >= queue->length) {
+        return errQUEUE_FULL;
+    }
+    memcpy(&queue->buf[((queue->head + queue->count) % queue->length) * queue->item_size], item, queue->item_size);
+    queue->count++;
+
+    // 기다리는 태스크 중 우선순위가 가장 높은 하나만 깨운다
+    struct sim_task* waiter = NULL;
+    for (struct sim_task* t = tasks; t != NULL; t = t->next) {
+        if (t->state == TASK_BLOCKED && t->wait == WAIT_QUEUE && t->wait_queue == queue &&
+            (waiter == NULL || t->priority > waiter->priority)) {
+            waiter = t;
+        }
+    }
+    if (waiter != NULL) {
+        make_ready(waiter);
+    }
+    return pdTRUE;
+}
+
+BaseType_t xQueueReceive(QueueHandle_t queue, void* item, TickType_t ticks_to_wait) {
+    if (queue->count == 0 && ticks_to_wait != 0) {
+        block_current(WAIT_QUEUE, ticks_to_wait, queue);
+    }
+    if (queue->count == 0) {
+        return errQUEUE_EMPTY;
+    }
+    memcpy(item, &queue->buf[queue->head * queue->item_size], queue->item_size);
+    queue->head = (queue->head + 1) % queue->length;
+    queue->count--;
+    return pdTRUE;
+}
+
+//
+// esp_timer
+//
+static void esp_timer_fire(sim_event_t* event) {
+    struct esp_timer* timer = (struct esp_timer*)event;
+    if (timer->period_us != 0) {
+        sim_event_schedule(&timer->event, event->time_us + (int64_t)timer->period_us);
+    }
+    timer->callback(timer->arg);
+}
+
+int64_t esp_timer_get_time(void) {
+    return rc_tank_hal_time_us();
+}
+
+esp_err_t esp_timer_create(const esp_timer_create_args_t* create_args, esp_timer_handle_t* out_handle) {
+    struct esp_timer* timer = calloc(1, sizeof(*timer));
+    if (timer == NULL) {
+        return ESP_ERR_NO_MEM;
+    }
+    sim_event_init(&timer->event, esp_timer_fire);
+    timer->callback = create_args->callback;
+    timer->arg = create_args->arg;
+    *out_handle = timer;
+    return ESP_OK;
+}
+
+esp_err_t esp_timer_start_once(esp_timer_handle_t timer, uint64_t timeout_us) {
+    if (timer->event.queued) {
+        return ESP_ERR_INVALID_STATE;
+    }
+    timer->period_us = 0;
+    sim_event_schedule(&timer->event, now_us + (int64_t)timeout_us);
+    return ESP_OK;
+}
+
+esp_err_t esp_timer_start_periodic(esp_timer_handle_t timer, uint64_t period) {
+    if (timer->event.queued) {
+        return ESP_ERR_INVALID_STATE;
+    }
+    timer->period_us = period;
+    sim_event_schedule(&timer->event, now_us + (int64_t)period);
+    return ESP_OK;
+}
+
+esp_err_t esp_timer_stop(esp_timer_handle_t timer) {
+    if (!timer->event.queued) {
+        return ESP_ERR_INVALID_STATE;
+    }
+    sim_event_cancel(&timer->event);
+    return ESP_OK;
+}
+
+const char* esp_err_to_name(esp_err_t code) {
+    switch (code) {
+        case ESP_OK:
+            return "ESP_OK";
+        case ESP_FAIL:
+            return "ESP_FAIL";
+        case ESP_ERR_NO_MEM:
+            return "ESP_ERR_NO_MEM";
+        case ESP_ERR_INVALID_ARG:
+            return "ESP_ERR_INVALID_ARG";
+        case ESP_ERR_INVALID_STATE:
+            return "ESP_ERR_INVALID_STATE";
+        case ESP_ERR_INVALID_SIZE:
+            return "ESP_ERR_INVALID_SIZE";
+        case ESP_ERR_NOT_FOUND:
+            return "ESP_ERR_NOT_FOUND";
+        case ESP_ERR_TIMEOUT:
+            return "ESP_ERR_TIMEOUT";
+        case ESP_ERR_NVS_NOT_FOUND:
+            return "ESP_ERR_NVS_NOT_FOUND";
+        case ESP_ERR_NVS_INVALID_LENGTH:
+            return "ESP_ERR_NVS_INVALID_LENGTH";
+        default:
+            return "UNKNOWN ERROR";
+    }
+}
@@ -0,0 +1,34 @@
+#ifndef SIM_RTOS_H
+#define SIM_RTOS_H
+
+#include <stdbool.h>
+#include <stdint.h>
+
+// 호스트 시뮬레이터용 이산 사건 스케줄러
+// FreeRTOS 태스크는 ucontext 코루틴으로 한 번에 하나씩, 막힐 때까지 실행된다.
+// 시계는 다음 사건 (타이머, 태스크 대기 만료) 시각으로 건너뛰므로 실행 결과가 항상 같다.
+// 사건 콜백 (esp_timer, BTstack 타이머, 시나리오 입력) 은 태스크 밖에서 실행되며
+// 펌웨어의 BT 스레드/타이머 태스크 역할을 한다.
+
+typedef struct sim_event sim_event_t;
+typedef void (*sim_event_fn_t)(sim_event_t* event);
+
+struct sim_event {
+    int64_t time_us;
+    sim_event_fn_t fn;
+    uint64_t order;  // 같은 시각이면 먼저 예약한 사건부터
+    bool queued;
+    sim_event_t* next;
+};
+
+// 함수 선언
+void sim_rtos_init(int64_t start_us);
+int64_t sim_rtos_now_us(void);
+// time_us 까지 사건과 태스크를 실행하고 시계를 time_us 로 맞춘다
+void sim_rtos_run_until(int64_t time_us);
+void sim_event_init(sim_event_t* event, sim_event_fn_t fn);
+// 이미 예약된 사건이면 새 시각으로 옮긴다
+void sim_event_schedule(sim_event_t* event, int64_t time_us);
+void sim_event_cancel(sim_event_t* event);
+
+#endif // SIM_RTOS_H
@@ -0,0 +1,100 @@
+#include "sim_uart.h"
+#include "sim_rtos.h"
+#include "dfplayer.h"
+#include "dfplayer_parser.h"
+#include "driver/uart.h"
+#include <string.h>
+
+// 호스트 시뮬레이터용 UART: DFPlayer Mini 모델이 연결되어 있다.
+// 부팅 후 온라인 알림을 보내고, 명령마다 요청되면 ACK 를 돌려준다.
+// 재생한 파일은 SIM_DFPLAYER_TRACK_MS 뒤 재생 완료 알림을 보낸다 (그 전에 다른 파일을 재생하면 보내지 않음).
+
+#define SIM_UART_RX_LEN 256
+
+typedef struct {
+    int64_t time_us;  // 수신 버퍼에 도착하는 시각
+    uint8_t byte;
+} rx_byte_t;
+
+static rx_byte_t rx[SIM_UART_RX_LEN];
+static uint32_t rx_head = 0;
+static uint32_t rx_tail = 0;
+static dfplayer_parser_t tx_parser;
+static sim_dfplayer_play_fn_t play_hook = NULL;
+static int64_t track_end_us = -1;  // -1: 재생 중 아님
+static uint8_t track_file = 0;
+
+void sim_dfplayer_set_play_hook(sim_dfplayer_play_fn_t fn) {
+    play_hook = fn;
+}
+
+// DFPlayer 가 보낸 응답 프레임을 time_us 에 도착하도록 수신 버퍼에 넣는다
+static void respond(int64_t time_us, uint8_t command, uint16_t parameter) {
+    uint8_t frame[DFPLAYER_FRAME_SIZE] = {
+        DFPLAYER_FRAME_START, DFPLAYER_FRAME_VERSION, DFPLAYER_FRAME_LENGTH, command, 0,
+        (uint8_t)(parameter >> 8), (uint8_t)parameter, 0, 0, DFPLAYER_FRAME_END,
+    };
+    uint16_t checksum = dfplayer_checksum(&frame[1], 6);
+    frame[7] = (uint8_t)(checksum >> 8);
+    frame[8] = (uint8_t)checksum;
+
+    for (int i = 0; i < DFPLAYER_FRAME_SIZE && rx_tail - rx_head < SIM_UART_RX_LEN; i++) {
+        rx[rx_tail++ % SIM_UART_RX_LEN] = (rx_byte_t){.time_us = time_us, .byte = frame[i]};
+    }
+}
+
+esp_err_t uart_driver_install(uart_port_t port, int rx_buffer_size, int tx_buffer_size, int queue_size,
+                              void* uart_queue, int intr_alloc_flags) {
+    rx_head = rx_tail = 0;
+    dfplayer_parser_init(&tx_parser);
+    // 온라인 알림 (파라미터 2: SD 카드)
+    respond(sim_rtos_now_us() + SIM_DFPLAYER_BOOT_MS * 1000LL, DFPLAYER_RSP_ONLINE, 0x0002);
+    return ESP_OK;
+}
+
+esp_err_t uart_param_config(uart_port_t port, const uart_config_t* config) {
+    return ESP_OK;
+}
+
+esp_err_t uart_set_pin(uart_port_t port, int tx_io_num, int rx_io_num, int rts_io_num, int cts_io_num) {
+    return ESP_OK;
+}
+
+int uart_write_bytes(uart_port_t port, const void* src, size_t size) {
+    const uint8_t* bytes = src;
+    dfplayer_frame_t frame;
+
+    // 명령 프레임도 응답과 같은 형식이므로 같은 파서로 읽는다
+    for (size_t i = 0; i < size; i++) {
+        if (!dfplayer_parser_feed(&tx_parser, bytes[i], &frame)) {
+            continue;
+        }
+        if (frame.command == DFPLAYER_CMD_PLAY_FILE) {
+            track_file = (uint8_t)frame.parameter;
+            track_end_us = sim_rtos_now_us() + SIM_DFPLAYER_TRACK_MS * 1000LL;
+            if (play_hook != NULL) {
+                play_hook(track_file);
+            }
+        }
+        if (frame.feedback) {
+            respond(sim_rtos_now_us() + SIM_DFPLAYER_ACK_MS * 1000LL, DFPLAYER_RSP_ACK, 0);
+        }
+    }
+    return (int)size;
+}
+
+int uart_read_bytes(uart_port_t port, void* buf, uint32_t length, TickType_t ticks_to_wait) {
+    uint8_t* out = buf;
+    int64_t now = sim_rtos_now_us();
+    uint32_t n = 0;
+
+    // 재생 완료 알림은 도착 순서가 명령 응답과 섞이지 않도록 시각이 된 뒤에 넣는다
+    if (track_end_us >= 0 && now >= track_end_us) {
+        respond(track_end_us, DFPLAYER_RSP_TF_FINISHED, track_file);
+        track_end_us = -1;
+    }
+    while (n < length && rx_head != rx_tail && rx[rx_head % SIM_UART_RX_LEN].time_us <= now) {
+        out[n++] = rx[rx_head++ % SIM_UART_RX_LEN].byte;
+    }
+    return (int)n;
+}
@@ -0,0 +1,17 @@
+#ifndef SIM_UART_H
+#define SIM_UART_H
+
+#include <stdint.h>
+
+// DFPlayer 모델 설정
+#define SIM_DFPLAYER_BOOT_MS 800  // 전원 인가 후 온라인 알림까지
+#define SIM_DFPLAYER_ACK_MS  15   // 명령 수신 후 ACK 도착까지 (9600bps 10바이트 + 처리)
+#define SIM_DFPLAYER_TRACK_MS 500 // 모든 효과음 파일의 재생 길이
+
+typedef void (*sim_dfplayer_play_fn_t)(uint8_t file_number);
+
+// 함수 선언
+// 재생 명령 (PLAY_FILE) 을 받을 때마다 호출할 함수 (시뮬레이터 타임라인 기록용)
+void sim_dfplayer_set_play_hook(sim_dfplayer_play_fn_t fn);
+
+#endif // SIM_UART_H
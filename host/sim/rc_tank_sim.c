@@ -0,0 +1,629 @@
+// RC Tank 호스트 시뮬레이터
+// 펌웨어와 같은 main/ 소스 (my_flatform.c, 제어 루프, 바인딩, 효과, 기록 ...) 를 POSIX HAL 과 이산 사건
+// 스케줄러 (host/port) 위에서 실행한다. 시나리오 파일의 컨트롤러 보고를 my_platform_on_controller_data 로
+// 넣고, 보고와 액추에이터/효과음/진동 변화를 시각과 함께 CSV 타임라인으로 기록한다.
+// 보고마다 콜백이 쓴 시간 (CLOCK_PROCESS_CPUTIME_ID / CLOCK_MONOTONIC) 을 재어 끝에 stderr 로 요약한다.
+//
+// 타임라인: time_us,kind,channel,value. kind: motor servo led sound rumble player_leds declined report
+// (report 의 value 는 그 보고의 콜백 CPU 시간 ns, 실행마다 다르다)
+//
+// 사용법: rc_tank_sim <시나리오> [타임라인.csv]   (CSV 를 생략하면 stdout)
+//
+// 시나리오: 한 줄에 "<시각 ms> <명령> [인자...]". '#' 뒤는 주석.
+// 시각은 리셋 후 ms (타임라인, 부팅 로그와 같은 기준, app_main 은 SIM_START_US) 이고 줄 순서대로 증가해야 한다.
+//   connect <장치> <종류> [stream=<ms>] [ble]  컨트롤러 연결. stream 이 있으면 입력이 같아도 그 주기로 보고
+//                                             (없으면 입력이 바뀔 때만 보고). 종류: ps3 ps4 ps5 switch xboxone 8bitdo generic
+//   pad <장치> <필드>=<값>...                  입력 변경 후 보고. 필드: x y rx ry throttle brake buttons misc dpad
+//   mute <장치> / unmute <장치>                보고 중단/재개 (연결은 유지, 무선 끊김)
+//   rssi <장치> <값>                           링크 RSSI (BR/EDR: 적정 범위와의 차 dB, BLE: dBm)
+//   system <장치>                              시스템 버튼 (좌석 교대)
+//   power <배터리 mV> <전류 mA>                POSIX HAL 전원 센서 값 (기본 8000mV, 0mA)
+//   disconnect <장치>
+//   cmd <콘솔 명령...>                         등록된 콘솔 명령 실행 (예: cmd tank_record start)
+//   expect <종류> <채널> <비교> <값>           마지막 값 확인. 종류/채널: motor left|right|turret,
+//                                             servo mount|cannon, led cannon|headlight, sound last,
+//                                             turret angle (HAL 센서, 0.1도), angle mount|cannon (서보 궤적, 0.001도),
+//                                             rumble|rumble_strong|rumble_gap pad<장치> (연결 후 진동 요청 수,
+//                                             마지막 강한 모터 세기, 요청 사이 최소 간격 ms),
+//                                             leds pad<장치> (마지막 플레이어 LED, 없으면 -1),
+//                                             reports|callback_us pad<장치> (연결 후 보고 수,
+//                                             보고 콜백의 최대 CPU 시간 us).
+//                                             비교: == != < <= > >=
+//   end                                        이 시각까지 실행하고 종료
+
+#include <errno.h>
+#include <inttypes.h>
+#include <stdarg.h>
+#include <stddef.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+
+#include <uni.h>
+#include "rc_tank_boot.h"
+#include "rc_tank_hal.h"
+#include "rc_tank_servo.h"
+#include "sim_bt.h"
+#include "sim_console.h"
+#include "sim_rtos.h"
+#include "sim_uart.h"
+
+// 0 은 부팅 타임라인에서 "도달하지 않음" 이므로 리셋 후 app_main 까지의 시간만큼 늦게 시작한다
+#define SIM_START_US      (300 * 1000)
+// HAL 기록 (RC_TANK_HAL_TRACE_LEN) 이 넘치지 않도록 이 간격마다 타임라인으로 옮긴다
+#define SIM_DRAIN_US      (50 * 1000)
+#define SIM_LINE_LEN      256
+#define SIM_MAX_ARGS      16
+
+// my_flatform.c
+struct uni_platform* get_my_platform(void);
+
+typedef struct {
+    sim_event_t stream_event;  // 첫 멤버 (사건 콜백에서 장치로 변환)
+    bool connected;
+    bool muted;
+    uint32_t stream_ms;        // 0: 입력이 바뀔 때만 보고
+    uni_gamepad_t gamepad;
+    int index;
+    // 연결 후 받은 진동 요청
+    int32_t rumble_count;
+    int32_t rumble_strong;
+    int32_t rumble_gap_ms;     // 요청 사이 최소 간격 (두 번째 요청 전에는 INT32_MAX)
+    int64_t rumble_time_us;
+    int32_t player_leds;
+    // 연결 후 보고 수와 my_platform_on_controller_data 의 최대 CPU 시간
+    int32_t report_count;
+    int64_t callback_max_ns;
+} sim_pad_t;
+
+typedef struct {
+    const char* name;
+    int type;
+} sim_pad_type_t;
+
+static const sim_pad_type_t pad_types[] = {
+    {"ps3", CONTROLLER_TYPE_PS3Controller},
+    {"ps4", CONTROLLER_TYPE_PS4Controller},
+    {"ps5", CONTROLLER_TYPE_PS5Controller},
+    {"switch", CONTROLLER_TYPE_SwitchProController},
+    {"xboxone", CONTROLLER_TYPE_XBoxOneController},
+    {"8bitdo", CONTROLLER_TYPE_8BitdoController},
+    {"generic", CONTROLLER_TYPE_GenericController},
+};
+
+static const char* const trace_kinds[] = {"motor", "servo", "led"};
+static const char* const motor_names[RC_TANK_HAL_MOTOR_MAX] = {"left", "right", "turret"};
+static const char* const servo_names[RC_TANK_HAL_SERVO_MAX] = {"mount", "cannon"};
+static const char* const led_names[RC_TANK_HAL_LED_MAX] = {"cannon", "headlight"};
+
+static struct uni_platform* platform;
+static sim_pad_t pads[SIM_BT_DEVICES];
+static FILE* timeline;
+static const char* scenario_path;
+static int scenario_line;
+static int failures = 0;
+
+// 채널별 마지막 값 (타임라인에는 바뀔 때만 기록)
+static int32_t motor_value[RC_TANK_HAL_MOTOR_MAX];
+static int32_t servo_value[RC_TANK_HAL_SERVO_MAX];
+static int32_t led_value[RC_TANK_HAL_LED_MAX];
+static bool servo_seen[RC_TANK_HAL_SERVO_MAX];
+static int32_t last_sound = 0;
+
+// 전체 보고 콜백 시간 (요약용)
+static int64_t callback_count;
+static int64_t callback_cpu_total_ns;
+static int64_t callback_cpu_max_ns;
+static int64_t callback_wall_max_ns;
+
+static void fail(const char* fmt, ...) {
+    va_list args;
+    fprintf(stderr, "%s:%d: ", scenario_path, scenario_line);
+    va_start(args, fmt);
+    vfprintf(stderr, fmt, args);
+    va_end(args);
+    fputc('\n', stderr);
+    failures++;
+}
+
+static void emit(int64_t time_us, const char* kind, const char* channel, int32_t value) {
+    fprintf(timeline, "%" PRId64 ",%s,%s,%" PRId32 "\n", time_us, kind, channel, value);
+}
+
+// HAL 기록을 타임라인으로 옮긴다 (값이 바뀐 명령만)
+static void drain_trace(void) {
+    uint32_t count = rc_tank_hal_trace_count();
+    for (uint32_t i = 0; i < count; i++) {
+        const rc_tank_hal_trace_t* t = rc_tank_hal_trace_get(i);
+        int32_t* last;
+        const char* channel;
+        switch (t->kind) {
+            case RC_TANK_HAL_TRACE_MOTOR:
+                last = &motor_value[t->channel];
+                channel = motor_names[t->channel];
+                break;
+            case RC_TANK_HAL_TRACE_SERVO:
+                // 서보는 첫 duty 도 기록 (0 이 유효한 값이 아님)
+                if (!servo_seen[t->channel]) {
+                    servo_seen[t->channel] = true;
+                    servo_value[t->channel] = t->value - 1;
+                }
+                last = &servo_value[t->channel];
+                channel = servo_names[t->channel];
+                break;
+            default:
+                last = &led_value[t->channel];
+                channel = led_names[t->channel];
+                break;
+        }
+        if (*last != t->value) {
+            *last = t->value;
+            emit(t->time_us, trace_kinds[t->kind], channel, t->value);
+        }
+    }
+    if (rc_tank_hal_trace_dropped() > 0) {
+        fail("%" PRIu32 " HAL trace entries dropped", rc_tank_hal_trace_dropped());
+    }
+    rc_tank_hal_trace_clear();
+}
+
+// 지금 일어난 사건: 앞선 HAL 기록을 먼저 옮겨 타임라인이 시각 순서를 지키게 한다
+static void emit_now(const char* kind, const char* channel, int32_t value) {
+    drain_trace();
+    emit(sim_rtos_now_us(), kind, channel, value);
+}
+
+static void run_until(int64_t time_us) {
+    while (sim_rtos_now_us() < time_us) {
+        int64_t step = sim_rtos_now_us() + SIM_DRAIN_US;
+        sim_rtos_run_until(step < time_us ? step : time_us);
+        drain_trace();
+    }
+    sim_rtos_run_until(time_us);
+    drain_trace();
+}
+
+//
+// 컨트롤러
+//
+static void on_sound(uint8_t file_number) {
+    last_sound = file_number;
+    emit_now("sound", "play", file_number);
+}
+
+static void on_rumble(uni_hid_device_t* d, uint16_t start_delay_ms, uint16_t duration_ms, uint8_t weak_magnitude,
+                      uint8_t strong_magnitude) {
+    char channel[8];
+    int idx = uni_hid_device_get_idx_for_instance(d);
+    sim_pad_t* pad = &pads[idx];
+    int64_t now = sim_rtos_now_us();
+    if (pad->rumble_count > 0 && (now - pad->rumble_time_us) / 1000 < pad->rumble_gap_ms) {
+        pad->rumble_gap_ms = (int32_t)((now - pad->rumble_time_us) / 1000);
+    }
+    pad->rumble_count++;
+    pad->rumble_strong = strong_magnitude;
+    pad->rumble_time_us = now;
+    snprintf(channel, sizeof(channel), "pad%d", idx);
+    emit_now("rumble", channel, duration_ms);
+}
+
+static void on_player_leds(uni_hid_device_t* d, uint8_t leds) {
+    char channel[8];
+    int idx = uni_hid_device_get_idx_for_instance(d);
+    pads[idx].player_leds = leds;
+    snprintf(channel, sizeof(channel), "pad%d", idx);
+    emit_now("player_leds", channel, leds);
+}
+
+static int64_t clock_ns(clockid_t clock) {
+    struct timespec ts;
+    clock_gettime(clock, &ts);
+    return (int64_t)ts.tv_sec * 1000000000 + ts.tv_nsec;
+}
+
+static void send_report(sim_pad_t* pad) {
+    if (!pad->connected || pad->muted) {
+        return;
+    }
+    uni_controller_t ctl;
+    memset(&ctl, 0, sizeof(ctl));
+    ctl.klass = UNI_CONTROLLER_CLASS_GAMEPAD;
+    ctl.gamepad = pad->gamepad;
+    ctl.battery = UNI_CONTROLLER_BATTERY_NOT_AVAILABLE;
+
+    int64_t wall = clock_ns(CLOCK_MONOTONIC);
+    int64_t cpu = clock_ns(CLOCK_PROCESS_CPUTIME_ID);
+    platform->on_controller_data(sim_bt_device(pad->index), &ctl);
+    cpu = clock_ns(CLOCK_PROCESS_CPUTIME_ID) - cpu;
+    wall = clock_ns(CLOCK_MONOTONIC) - wall;
+
+    pad->report_count++;
+    if (cpu > pad->callback_max_ns) pad->callback_max_ns = cpu;
+    callback_count++;
+    callback_cpu_total_ns += cpu;
+    if (cpu > callback_cpu_max_ns) callback_cpu_max_ns = cpu;
+    if (wall > callback_wall_max_ns) callback_wall_max_ns = wall;
+
+    char channel[8];
+    snprintf(channel, sizeof(channel), "pad%d", pad->index);
+    emit_now("report", channel, (int32_t)(cpu < INT32_MAX ? cpu : INT32_MAX));
+}
+
+static void on_stream(sim_event_t* event) {
+    sim_pad_t* pad = (sim_pad_t*)event;
+    send_report(pad);
+    sim_event_schedule(&pad->stream_event, event->time_us + pad->stream_ms * 1000LL);
+}
+
+//
+// 시나리오
+//
+static bool parse_int(const char* s, long* out) {
+    char* end;
+    errno = 0;
+    *out = strtol(s, &end, 0);
+    return errno == 0 && end != s && *end == '\0';
+}
+
+static sim_pad_t* get_pad(int argc, char** argv, bool connected) {
+    long idx;
+    if (argc < 2 || !parse_int(argv[1], &idx) || idx < 0 || idx >= SIM_BT_DEVICES) {
+        fail("%s: invalid device", argv[0]);
+        return NULL;
+    }
+    if (pads[idx].connected != connected) {
+        fail("%s: device %ld is %s", argv[0], idx, connected ? "not connected" : "already connected");
+        return NULL;
+    }
+    return &pads[idx];
+}
+
+static void cmd_connect(int argc, char** argv) {
+    sim_pad_t* pad = get_pad(argc, argv, false);
+    if (pad == NULL) {
+        return;
+    }
+    int type = -1;
+    for (size_t i = 0; argc > 2 && i < sizeof(pad_types) / sizeof(pad_types[0]); i++) {
+        if (strcmp(argv[2], pad_types[i].name) == 0) {
+            type = pad_types[i].type;
+        }
+    }
+    if (type < 0) {
+        fail("connect: unknown controller type");
+        return;
+    }
+
+    uni_hid_device_t* d = sim_bt_device(pad->index);
+    memset(d, 0, sizeof(*d));
+    d->controller_type = type;
+    d->conn.protocol = UNI_BT_CONN_PROTOCOL_BR_EDR;
+    d->report_parser.play_dual_rumble = on_rumble;
+    d->report_parser.set_player_leds = on_player_leds;
+
+    pad->stream_ms = 0;
+    pad->muted = false;
+    pad->rumble_count = 0;
+    pad->rumble_strong = 0;
+    pad->rumble_gap_ms = INT32_MAX;
+    pad->player_leds = -1;
+    pad->report_count = 0;
+    pad->callback_max_ns = 0;
+    memset(&pad->gamepad, 0, sizeof(pad->gamepad));
+    for (int i = 3; i < argc; i++) {
+        long value;
+        if (strncmp(argv[i], "stream=", 7) == 0 && parse_int(argv[i] + 7, &value) && value > 0) {
+            pad->stream_ms = (uint32_t)value;
+        } else if (strcmp(argv[i], "ble") == 0) {
+            d->conn.protocol = UNI_BT_CONN_PROTOCOL_BLE;
+            d->conn.rssi = (uint8_t)-60;
+        } else {
+            fail("connect: invalid option '%s'", argv[i]);
+        }
+    }
+
+    pad->connected = true;
+    platform->on_device_connected(d);
+    if (platform->on_device_ready(d) != UNI_ERROR_SUCCESS) {
+        emit_now("declined", argv[1], 1);
+    }
+    if (pad->stream_ms > 0) {
+        on_stream(&pad->stream_event);
+    }
+}
+
+static void cmd_pad(int argc, char** argv) {
+    static const struct {
+        const char* name;
+        size_t offset;
+        size_t size;
+    } fields[] = {
+        {"x", offsetof(uni_gamepad_t, axis_x), sizeof(int32_t)},
+        {"y", offsetof(uni_gamepad_t, axis_y), sizeof(int32_t)},
+        {"rx", offsetof(uni_gamepad_t, axis_rx), sizeof(int32_t)},
+        {"ry", offsetof(uni_gamepad_t, axis_ry), sizeof(int32_t)},
+        {"throttle", offsetof(uni_gamepad_t, throttle), sizeof(int32_t)},
+        {"brake", offsetof(uni_gamepad_t, brake), sizeof(int32_t)},
+        {"buttons", offsetof(uni_gamepad_t, buttons), sizeof(uint16_t)},
+        {"misc", offsetof(uni_gamepad_t, misc_buttons), sizeof(uint8_t)},
+        {"dpad", offsetof(uni_gamepad_t, dpad), sizeof(uint8_t)},
+    };
+    sim_pad_t* pad = get_pad(argc, argv, true);
+    if (pad == NULL) {
+        return;
+    }
+
+    for (int i = 2; i < argc; i++) {
+        char* eq = strchr(argv[i], '=');
+        long value;
+        size_t f;
+        if (eq == NULL || !parse_int(eq + 1, &value)) {
+            fail("pad: invalid field '%s'", argv[i]);
+            continue;
+        }
+        *eq = '\0';
+        for (f = 0; f < sizeof(fields) / sizeof(fields[0]); f++) {
+            if (strcmp(argv[i], fields[f].name) == 0) {
+                break;
+            }
+        }
+        if (f == sizeof(fields) / sizeof(fields[0])) {
+            fail("pad: unknown field '%s'", argv[i]);
+            continue;
+        }
+        uint8_t* p = (uint8_t*)&pad->gamepad + fields[f].offset;
+        if (fields[f].size == sizeof(int32_t)) {
+            *(int32_t*)p = (int32_t)value;
+        } else if (fields[f].size == sizeof(uint16_t)) {
+            *(uint16_t*)p = (uint16_t)value;
+        } else {
+            *p = (uint8_t)value;
+        }
+    }
+    send_report(pad);
+}
+
+static void cmd_disconnect(int argc, char** argv) {
+    sim_pad_t* pad = get_pad(argc, argv, true);
+    if (pad == NULL) {
+        return;
+    }
+    sim_event_cancel(&pad->stream_event);
+    pad->connected = false;
+    platform->on_device_disconnected(sim_bt_device(pad->index));
+}
+
+static void cmd_expect(int argc, char** argv) {
+    if (argc != 5) {
+        fail("expect: usage: expect <kind> <channel> <op> <value>");
+        return;
+    }
+
+    const char* const* names = NULL;
+    const int32_t* values = NULL;
+    int count = 0;
+    int32_t actual;
+    long expected;
+
+    if (strcmp(argv[1], "motor") == 0) {
+        names = motor_names, values = motor_value, count = RC_TANK_HAL_MOTOR_MAX;
+    } else if (strcmp(argv[1], "servo") == 0) {
+        names = servo_names, values = servo_value, count = RC_TANK_HAL_SERVO_MAX;
+    } else if (strcmp(argv[1], "led") == 0) {
+        names = led_names, values = led_value, count = RC_TANK_HAL_LED_MAX;
+    }
+
+    int ch = -1;
+    for (int i = 0; i < count; i++) {
+        if (strcmp(argv[2], names[i]) == 0) {
+            ch = i;
+        }
+    }
+    if (ch >= 0) {
+        actual = values[ch];
+    } else if (strcmp(argv[1], "sound") == 0 && strcmp(argv[2], "last") == 0) {
+        actual = last_sound;
+    } else if (strcmp(argv[1], "angle") == 0 && (strcmp(argv[2], "mount") == 0 || strcmp(argv[2], "cannon") == 0)) {
+        actual = rc_tank_servo_get_position(strcmp(argv[2], "mount") == 0 ? RC_TANK_HAL_SERVO_MOUNT
+                                                                          : RC_TANK_HAL_SERVO_CANNON);
+    } else if ((strncmp(argv[1], "rumble", 6) == 0 || strcmp(argv[1], "leds") == 0 || strcmp(argv[1], "reports") == 0 ||
+                strcmp(argv[1], "callback_us") == 0) &&
+               strncmp(argv[2], "pad", 3) == 0) {
+        long idx;
+        if (!parse_int(argv[2] + 3, &idx) || idx < 0 || idx >= SIM_BT_DEVICES) {
+            fail("expect: unknown channel '%s %s'", argv[1], argv[2]);
+            return;
+        }
+        if (strcmp(argv[1], "rumble") == 0) {
+            actual = pads[idx].rumble_count;
+        } else if (strcmp(argv[1], "rumble_strong") == 0) {
+            actual = pads[idx].rumble_strong;
+        } else if (strcmp(argv[1], "rumble_gap") == 0) {
+            actual = pads[idx].rumble_gap_ms;
+        } else if (strcmp(argv[1], "leds") == 0) {
+            actual = pads[idx].player_leds;
+        } else if (strcmp(argv[1], "reports") == 0) {
+            actual = pads[idx].report_count;
+        } else if (strcmp(argv[1], "callback_us") == 0) {
+            // 올림: 0 은 보고가 없었다는 뜻
+            actual = (int32_t)((pads[idx].callback_max_ns + 999) / 1000);
+        } else {
+            fail("expect: unknown channel '%s %s'", argv[1], argv[2]);
+            return;
+        }
+    } else if (strcmp(argv[1], "turret") == 0 && strcmp(argv[2], "angle") == 0) {
+        if (!rc_tank_hal_read_turret_angle(&actual)) {
+            fail("expect: no turret sensor");
+            return;
+        }
+    } else {
+        fail("expect: unknown channel '%s %s'", argv[1], argv[2]);
+        return;
+    }
+    if (!parse_int(argv[4], &expected)) {
+        fail("expect: invalid value '%s'", argv[4]);
+        return;
+    }
+
+    const char* op = argv[3];
+    bool ok = strcmp(op, "==") == 0   ? actual == expected
+              : strcmp(op, "!=") == 0 ? actual != expected
+              : strcmp(op, "<") == 0  ? actual < expected
+              : strcmp(op, "<=") == 0 ? actual <= expected
+              : strcmp(op, ">") == 0  ? actual > expected
+              : strcmp(op, ">=") == 0 ? actual >= expected
+                                      : (fail("expect: unknown operator '%s'", op), true);
+    if (!ok) {
+        fail("expect %s %s %s %ld failed: value is %" PRId32, argv[1], argv[2], op, expected, actual);
+    }
+}
+
+// 한 줄 실행. end 이면 false
+static bool run_line(char* line) {
+    char* argv[SIM_MAX_ARGS];
+    int argc = 0;
+    char* comment = strchr(line, '#');
+    if (comment != NULL) {
+        *comment = '\0';
+    }
+    for (char* tok = strtok(line, " \t\r\n"); tok != NULL && argc < SIM_MAX_ARGS; tok = strtok(NULL, " \t\r\n")) {
+        argv[argc++] = tok;
+    }
+    if (argc == 0) {
+        return true;
+    }
+
+    long time_ms;
+    if (argc < 2 || !parse_int(argv[0], &time_ms)) {
+        fail("expected '<time ms> <command>'");
+        return true;
+    }
+    int64_t time_us = time_ms * 1000LL;
+    if (time_us < sim_rtos_now_us()) {
+        fail("time goes backwards");
+        return true;
+    }
+    run_until(time_us);
+
+    char** args = &argv[1];
+    int nargs = argc - 1;
+    if (strcmp(args[0], "end") == 0) {
+        return false;
+    } else if (strcmp(args[0], "connect") == 0) {
+        cmd_connect(nargs, args);
+    } else if (strcmp(args[0], "pad") == 0) {
+        cmd_pad(nargs, args);
+    } else if (strcmp(args[0], "mute") == 0 || strcmp(args[0], "unmute") == 0) {
+        sim_pad_t* pad = get_pad(nargs, args, true);
+        if (pad != NULL) {
+            pad->muted = strcmp(args[0], "mute") == 0;
+        }
+    } else if (strcmp(args[0], "rssi") == 0) {
+        sim_pad_t* pad = get_pad(nargs, args, true);
+        long rssi;
+        if (pad != NULL && nargs == 3 && parse_int(args[2], &rssi)) {
+            sim_bt_device(pad->index)->conn.rssi = (uint8_t)(int8_t)rssi;
+        } else if (pad != NULL) {
+            fail("rssi: invalid value");
+        }
+    } else if (strcmp(args[0], "system") == 0) {
+        sim_pad_t* pad = get_pad(nargs, args, true);
+        if (pad != NULL) {
+            platform->on_oob_event(UNI_PLATFORM_OOB_GAMEPAD_SYSTEM_BUTTON, sim_bt_device(pad->index));
+        }
+    } else if (strcmp(args[0], "power") == 0) {
+        long battery_mv, current_ma;
+        if (nargs == 3 && parse_int(args[1], &battery_mv) && parse_int(args[2], &current_ma)) {
+            rc_tank_hal_set_sim_power((int32_t)battery_mv, (int32_t)current_ma);
+        } else {
+            fail("power: usage: power <battery mV> <current mA>");
+        }
+    } else if (strcmp(args[0], "disconnect") == 0) {
+        cmd_disconnect(nargs, args);
+    } else if (strcmp(args[0], "cmd") == 0) {
+        // 콘솔 명령 출력도 로그와 함께 stderr 로
+        char cmdline[SIM_LINE_LEN] = "";
+        for (int i = 1; i < nargs; i++) {
+            strncat(cmdline, args[i], sizeof(cmdline) - strlen(cmdline) - 2);
+            strcat(cmdline, " ");
+        }
+        fflush(stdout);
+        int saved = dup(fileno(stdout));
+        dup2(fileno(stderr), fileno(stdout));
+        if (sim_console_run(cmdline) != 0) {
+            fail("cmd: '%s' failed", cmdline);
+        }
+        fflush(stdout);
+        dup2(saved, fileno(stdout));
+        close(saved);
+    } else if (strcmp(args[0], "expect") == 0) {
+        cmd_expect(nargs, args);
+    } else {
+        fail("unknown command '%s'", args[0]);
+    }
+    return true;
+}
+
+// Bluepad32 로그 (logi/loge) 도 stderr 로
+void uni_logv(const char* fmt, va_list args) {
+    vfprintf(stderr, fmt, args);
+}
+
+int main(int argc, char** argv) {
+    if (argc < 2 || argc > 3) {
+        fprintf(stderr, "usage: %s <scenario> [timeline.csv]\n", argv[0]);
+        return 2;
+    }
+    scenario_path = argv[1];
+    FILE* scenario = fopen(scenario_path, "r");
+    if (scenario == NULL) {
+        perror(scenario_path);
+        return 2;
+    }
+    timeline = argc == 3 ? fopen(argv[2], "w") : stdout;
+    if (timeline == NULL) {
+        perror(argv[2]);
+        return 2;
+    }
+    fprintf(timeline, "time_us,kind,channel,value\n");
+
+    for (int i = 0; i < SIM_BT_DEVICES; i++) {
+        pads[i].index = i;
+        sim_event_init(&pads[i].stream_event, on_stream);
+    }
+
+    // app_main 과 같은 순서: 부팅 태스크 시작, Bluepad32 초기화, BT 준비 완료
+    sim_rtos_init(SIM_START_US);
+    sim_dfplayer_set_play_hook(on_sound);
+    rc_tank_boot_start();
+    rc_tank_boot_mark(RC_TANK_BOOT_BTSTACK);
+    platform = get_my_platform();
+    platform->init(0, NULL);
+    platform->register_console_cmds();
+    rc_tank_boot_mark(RC_TANK_BOOT_UNI_INIT);
+    platform->on_init_complete();
+
+    char line[SIM_LINE_LEN];
+    while (fgets(line, sizeof(line), scenario) != NULL) {
+        scenario_line++;
+        if (!run_line(line)) {
+            break;
+        }
+    }
+    fclose(scenario);
+    drain_trace();
+
+    if (timeline != stdout) {
+        fclose(timeline);
+    }
+    if (callback_count > 0) {
+        fprintf(stderr, "%s: %" PRId64 " reports, on_controller_data CPU mean %" PRId64 " ns, max %" PRId64
+                " ns (wall max %" PRId64 " ns)\n",
+                scenario_path, callback_count, callback_cpu_total_ns / callback_count, callback_cpu_max_ns,
+                callback_wall_max_ns);
+    }
+    fprintf(stderr, "%s: %d failure(s)\n", scenario_path, failures);
+    return failures ? 1 : 0;
+}
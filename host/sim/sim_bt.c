@@ -0,0 +1,103 @@
+#include "sim_bt.h"
+#include "sim_rtos.h"
+#include "rc_tank_bench.h"
+
+// my_flatform.c 가 부르는 Bluepad32/BTstack 함수의 시뮬레이터 구현.
+// BTstack 타이머는 시뮬레이션 사건으로 실행되고, 나머지 (검색, 키 삭제, RSSI 조회 등) 는 아무것도 하지 않는다.
+// RSSI 는 시나리오가 장치의 conn.rssi 를 직접 바꾼다.
+
+#define SIM_BT_TIMERS 4
+
+typedef struct {
+    sim_event_t event;  // 첫 멤버 (사건 콜백에서 타이머로 변환)
+    btstack_timer_source_t* ts;
+} sim_bt_timer_t;
+
+static uni_hid_device_t devices[SIM_BT_DEVICES];
+static sim_bt_timer_t timers[SIM_BT_TIMERS];
+
+uni_hid_device_t* sim_bt_device(int idx) {
+    return (idx >= 0 && idx < SIM_BT_DEVICES) ? &devices[idx] : NULL;
+}
+
+int uni_hid_device_get_idx_for_instance(const uni_hid_device_t* d) {
+    if (d < devices || d >= devices + SIM_BT_DEVICES) {
+        return -1;
+    }
+    return (int)(d - devices);
+}
+
+static void timer_fire(sim_event_t* event) {
+    btstack_timer_source_t* ts = ((sim_bt_timer_t*)event)->ts;
+    ts->process(ts);
+}
+
+uint32_t btstack_run_loop_get_time_ms(void) {
+    return (uint32_t)(sim_rtos_now_us() / 1000);
+}
+
+void btstack_run_loop_set_timer(btstack_timer_source_t* timer, uint32_t timeout_in_ms) {
+    timer->timeout = btstack_run_loop_get_time_ms() + timeout_in_ms;
+}
+
+void btstack_run_loop_add_timer(btstack_timer_source_t* timer) {
+    sim_bt_timer_t* slot = NULL;
+    for (int i = 0; i < SIM_BT_TIMERS; i++) {
+        if (timers[i].ts == timer) {
+            slot = &timers[i];
+            break;
+        }
+        if (slot == NULL && timers[i].ts == NULL) {
+            slot = &timers[i];
+        }
+    }
+    if (slot == NULL) {
+        loge("sim_bt: no free timer slot\n");
+        return;
+    }
+    if (slot->ts == NULL) {
+        sim_event_init(&slot->event, timer_fire);
+        slot->ts = timer;
+    }
+    sim_event_schedule(&slot->event, (int64_t)timer->timeout * 1000);
+}
+
+int btstack_run_loop_remove_timer(btstack_timer_source_t* timer) {
+    for (int i = 0; i < SIM_BT_TIMERS; i++) {
+        if (timers[i].ts == timer) {
+            sim_event_cancel(&timers[i].event);
+            timers[i].ts = NULL;
+            return 1;
+        }
+    }
+    return 0;
+}
+
+int gap_read_rssi(hci_con_handle_t con_handle) {
+    return 0;
+}
+
+void gap_set_link_supervision_timeout(uint16_t link_supervision_timeout) {
+}
+
+void uni_bt_allow_incoming_connections(bool allow) {
+}
+
+void uni_bt_del_keys_unsafe(void) {
+}
+
+void uni_bt_list_keys_unsafe(void) {
+}
+
+void uni_bt_start_scanning_and_autoconnect_safe(void) {
+}
+
+void uni_bt_start_scanning_and_autoconnect_unsafe(void) {
+}
+
+void uni_bt_stop_scanning_safe(void) {
+}
+
+// HID 파서 벤치마크는 ESP32 사이클 카운터로 재므로 시뮬레이터에는 등록하지 않는다
+void rc_tank_bench_register_cmds(void) {
+}
@@ -0,0 +1,12 @@
+#ifndef SIM_BT_H
+#define SIM_BT_H
+
+#include <uni.h>
+
+// 시뮬레이터의 컨트롤러 장치 (인덱스 = uni_hid_device_get_idx_for_instance)
+#define SIM_BT_DEVICES CONFIG_BLUEPAD32_MAX_DEVICES
+
+// 함수 선언
+uni_hid_device_t* sim_bt_device(int idx);
+
+#endif // SIM_BT_H
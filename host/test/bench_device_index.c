@@ -0,0 +1,127 @@
+// Bluepad32 패킷마다 하는 기기 조회 벤치마크 (uni_device_index).
+// uni_hid_device 와 같은 크기의 기기 배열을 순차 탐색하는 예전 방식과, cid / 연결 핸들 색인으로 찾는 방식의
+// 조회당 시간을 잰다. 연결된 기기 수를 1 개부터 최대까지 바꾸고, 연결된 기기의 interrupt cid / 핸들과
+// 없는 cid / 핸들 (순차 탐색의 최악) 을 번갈아 찾는다. 두 방식의 결과가 다르면 실패한다.
+// 사용법: bench_device_index [반복 횟수]
+
+#include <stdbool.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#include "uni_device_index.h"
+#include "uni_hid_device.h"
+
+#define DEVICES            CONFIG_BLUEPAD32_MAX_DEVICES
+#define DEFAULT_ITERATIONS 1000000
+
+static uni_hid_device_t devices[DEVICES];
+static uni_device_index_t cid_index;
+static uni_device_index_t handle_index;
+static volatile uintptr_t sink;
+
+// 예전 구현: 기기를 차례로 보며 처음 맞는 기기
+static uni_hid_device_t* scan_for_cid(uint16_t cid) {
+    for (int i = 0; i < DEVICES; i++) {
+        if (devices[i].conn.interrupt_cid == cid || devices[i].conn.control_cid == cid) return &devices[i];
+    }
+    return NULL;
+}
+
+static uni_hid_device_t* scan_for_connection_handle(hci_con_handle_t handle) {
+    for (int i = 0; i < DEVICES; i++) {
+        if (devices[i].conn.handle == handle) return &devices[i];
+    }
+    return NULL;
+}
+
+// uni_hid_device_get_instance_for_cid / _connection_handle 과 같은 조회
+static uni_hid_device_t* index_for_cid(uint16_t cid) {
+    if (cid == 0) return NULL;
+    int idx = uni_device_index_find(&cid_index, cid, NULL, NULL);
+    return idx < 0 ? NULL : &devices[idx];
+}
+
+static uni_hid_device_t* index_for_connection_handle(hci_con_handle_t handle) {
+    if (handle == UNI_BT_CONN_HANDLE_INVALID) return NULL;
+    int idx = uni_device_index_find(&handle_index, handle, NULL, NULL);
+    return idx < 0 ? NULL : &devices[idx];
+}
+
+// 앞의 connected 개 기기만 연결: 제어/인터럽트 cid 와 연결 핸들을 색인에 넣는다
+static void connect_devices(int connected) {
+    memset(devices, 0, sizeof(devices));
+    memset(&cid_index, 0, sizeof(cid_index));
+    memset(&handle_index, 0, sizeof(handle_index));
+    for (int i = 0; i < DEVICES; i++) {
+        devices[i].conn.handle = UNI_BT_CONN_HANDLE_INVALID;
+        if (i >= connected) continue;
+        devices[i].conn.control_cid = (uint16_t)(0x40 + 2 * i);
+        devices[i].conn.interrupt_cid = (uint16_t)(0x41 + 2 * i);
+        devices[i].conn.handle = (hci_con_handle_t)(0x80 + i);
+        uni_device_index_insert(&cid_index, devices[i].conn.control_cid, i);
+        uni_device_index_insert(&cid_index, devices[i].conn.interrupt_cid, i);
+        uni_device_index_insert(&handle_index, devices[i].conn.handle, i);
+    }
+}
+
+static int64_t now_ns(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (int64_t)ts.tv_sec * 1000000000 + ts.tv_nsec;
+}
+
+static int run(int connected, int iterations) {
+    connect_devices(connected);
+
+    // 연결된 기기마다 하나씩, 마지막은 없는 cid / 핸들
+    uint16_t cids[DEVICES + 1];
+    hci_con_handle_t handles[DEVICES + 1];
+    int count = 0;
+    for (int i = 0; i < connected; i++) {
+        cids[count] = devices[i].conn.interrupt_cid;
+        handles[count] = devices[i].conn.handle;
+        count++;
+    }
+    cids[count] = 0x7fff;
+    handles[count] = 0x0eff;
+    count++;
+
+    bool match = true;
+    for (int k = 0; k < count; k++) {
+        match &= index_for_cid(cids[k]) == scan_for_cid(cids[k]);
+        match &= index_for_connection_handle(handles[k]) == scan_for_connection_handle(handles[k]);
+    }
+
+    uintptr_t acc = 0;
+    int64_t start = now_ns();
+    for (int i = 0; i < iterations; i++) {
+        int k = i % count;
+        acc += (uintptr_t)scan_for_cid(cids[k]) + (uintptr_t)scan_for_connection_handle(handles[k]);
+    }
+    int64_t scan_ns = now_ns() - start;
+
+    start = now_ns();
+    for (int i = 0; i < iterations; i++) {
+        int k = i % count;
+        acc += (uintptr_t)index_for_cid(cids[k]) + (uintptr_t)index_for_connection_handle(handles[k]);
+    }
+    int64_t index_ns = now_ns() - start;
+    sink = acc;
+
+    printf("%d connected: scan %.1f ns, index %.1f ns per packet%s\n", connected, (double)scan_ns / iterations,
+           (double)index_ns / iterations, match ? "" : ", RESULT MISMATCH");
+    return match ? 0 : 1;
+}
+
+int main(int argc, char** argv) {
+    int iterations = argc > 1 ? atoi(argv[1]) : DEFAULT_ITERATIONS;
+    if (iterations <= 0) iterations = DEFAULT_ITERATIONS;
+
+    printf("Device lookup (cid + connection handle), %d iterations, max %d devices (%zu bytes each)\n", iterations,
+           DEVICES, sizeof(uni_hid_device_t));
+    int errors = 0;
+    for (int connected = 1; connected <= DEVICES; connected *= 2) errors += run(connected, iterations);
+    return errors ? 1 : 0;
+}
@@ -0,0 +1,142 @@
+// Bluepad32 HID 입력 보고서 해석 벤치마크 (uni_hid_parser).
+// generic, android, mouse, keyboard 파서마다 기술자를 매번 훑는 경로 (uni_hid_parser_walk_report) 와
+// 미리 컴파일한 필드 표 경로 (uni_hid_parser_dispatch_report) 의 보고서당 시간을 잰다.
+// 두 경로가 만든 컨트롤러 상태가 다르면 실패한다.
+// 사용법: bench_hid_parser [반복 횟수]
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#include "parser/uni_hid_parser.h"
+#include "parser/uni_hid_parser_android.h"
+#include "parser/uni_hid_parser_generic.h"
+#include "parser/uni_hid_parser_keyboard.h"
+#include "parser/uni_hid_parser_mouse.h"
+#include "uni_hid_device.h"
+
+#define DEFAULT_ITERATIONS 100000
+
+// uni_gamepad.c, uni_hid_device.c, btstack 대신 (보고서 해석 경로에서는 부르지 않는 연결 설정/LED 함수)
+const int AXIS_NORMALIZE_RANGE = 1024;
+
+void hci_dump_log(int log_level, const char* format, ...) {
+}
+
+bool uni_hid_device_set_ready_complete(uni_hid_device_t* d) {
+    return true;
+}
+
+gap_connection_type_t gap_get_connection_type(hci_con_handle_t connection_handle) {
+    return GAP_CONNECTION_INVALID;
+}
+
+uint8_t hids_client_send_write_report(uint16_t hids_cid,
+                                      uint8_t report_id,
+                                      hid_report_type_t report_type,
+                                      const uint8_t* report,
+                                      uint8_t report_len) {
+    return ERROR_CODE_COMMAND_DISALLOWED;
+}
+
+// 게임패드: 보고 ID 1 = 버튼 16개, 햇, 스틱 4축, 트리거 2개 (10비트) / 보고 ID 2 = 소비자 제어
+static const uint8_t gamepad_descriptor[] = {
+    0x05, 0x01, 0x09, 0x05, 0xA1, 0x01, 0x85, 0x01, 0x05, 0x09, 0x19, 0x01, 0x29, 0x10, 0x15, 0x00, 0x25, 0x01,
+    0x75, 0x01, 0x95, 0x10, 0x81, 0x02, 0x05, 0x01, 0x09, 0x39, 0x15, 0x00, 0x25, 0x07, 0x35, 0x00, 0x46, 0x3B,
+    0x01, 0x65, 0x14, 0x75, 0x04, 0x95, 0x01, 0x81, 0x42, 0x75, 0x04, 0x95, 0x01, 0x81, 0x03, 0x09, 0x30, 0x09,
+    0x31, 0x09, 0x32, 0x09, 0x35, 0x15, 0x81, 0x25, 0x7F, 0x75, 0x08, 0x95, 0x04, 0x81, 0x02, 0x05, 0x02, 0x09,
+    0xC5, 0x09, 0xC4, 0x15, 0x00, 0x26, 0xFF, 0x03, 0x75, 0x0A, 0x95, 0x02, 0x81, 0x02, 0x75, 0x04, 0x95, 0x01,
+    0x81, 0x03, 0xC0, 0x05, 0x0C, 0x09, 0x01, 0xA1, 0x01, 0x85, 0x02, 0x15, 0x00, 0x26, 0xFF, 0x03, 0x19, 0x00,
+    0x2A, 0xFF, 0x03, 0x75, 0x10, 0x95, 0x02, 0x81, 0x00, 0xC0,
+};
+static const uint8_t gamepad_report[] = {0x01, 0x5A, 0xA5, 0x37, 0x80, 0x7F, 0x10, 0xF0, 0xFF, 0x03, 0x55, 0x01};
+
+// 마우스: 버튼 3개, X/Y/휠 (8비트 상대값)
+static const uint8_t mouse_descriptor[] = {
+    0x05, 0x01, 0x09, 0x02, 0xA1, 0x01, 0x09, 0x01, 0xA1, 0x00, 0x05, 0x09, 0x19, 0x01, 0x29, 0x03, 0x15, 0x00,
+    0x25, 0x01, 0x95, 0x03, 0x75, 0x01, 0x81, 0x02, 0x95, 0x01, 0x75, 0x05, 0x81, 0x03, 0x05, 0x01, 0x09, 0x30,
+    0x09, 0x31, 0x09, 0x38, 0x15, 0x81, 0x25, 0x7F, 0x75, 0x08, 0x95, 0x03, 0x81, 0x06, 0xC0, 0xC0,
+};
+static const uint8_t mouse_report[] = {0x01, 0x05, 0xFB, 0x01};
+
+// 키보드 (부트 프로토콜): modifier 8비트, 예약 바이트, 키 배열 6개
+static const uint8_t keyboard_descriptor[] = {
+    0x05, 0x01, 0x09, 0x06, 0xA1, 0x01, 0x05, 0x07, 0x19, 0xE0, 0x29, 0xE7, 0x15, 0x00, 0x25, 0x01, 0x75, 0x01,
+    0x95, 0x08, 0x81, 0x02, 0x95, 0x01, 0x75, 0x08, 0x81, 0x01, 0x95, 0x05, 0x75, 0x01, 0x05, 0x08, 0x19, 0x01,
+    0x29, 0x05, 0x91, 0x02, 0x95, 0x01, 0x75, 0x03, 0x91, 0x01, 0x95, 0x06, 0x75, 0x08, 0x15, 0x00, 0x25, 0x65,
+    0x05, 0x07, 0x19, 0x00, 0x29, 0x65, 0x81, 0x00, 0xC0,
+};
+static const uint8_t keyboard_report[] = {0x02, 0x00, 0x04, 0x05, 0x00, 0x00, 0x00, 0x00};
+
+typedef struct {
+    const char* name;
+    const uint8_t* descriptor;
+    uint16_t descriptor_len;
+    const uint8_t* report;
+    uint16_t report_len;
+    report_init_report_fn_t init_report;
+    report_parse_usage_fn_t parse_usage;
+} bench_case_t;
+
+#define BENCH_CASE(name, desc, report, parser)                                                                   \
+    {name, desc, sizeof(desc), report, sizeof(report), uni_hid_parser_##parser##_init_report,                     \
+     uni_hid_parser_##parser##_parse_usage}
+
+static const bench_case_t cases[] = {
+    BENCH_CASE("generic", gamepad_descriptor, gamepad_report, generic),
+    BENCH_CASE("android", gamepad_descriptor, gamepad_report, android),
+    BENCH_CASE("mouse", mouse_descriptor, mouse_report, mouse),
+    BENCH_CASE("keyboard", keyboard_descriptor, keyboard_report, keyboard),
+};
+
+static uni_hid_device_t device;
+
+static int64_t now_ns(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (int64_t)ts.tv_sec * 1000000000 + ts.tv_nsec;
+}
+
+static int run(const bench_case_t* c, int iterations) {
+    uni_hid_device_t* d = &device;
+    memset(d, 0, sizeof(*d));
+    memcpy(d->hid_descriptor, c->descriptor, c->descriptor_len);
+    d->hid_descriptor_len = c->descriptor_len;
+    d->report_parser.parse_usage = c->parse_usage;
+    if (!uni_hid_parser_compile_descriptor(d)) {
+        printf("%-8s: descriptor not compiled\n", c->name);
+        return 1;
+    }
+
+    int64_t start = now_ns();
+    for (int i = 0; i < iterations; i++) {
+        c->init_report(d);
+        uni_hid_parser_walk_report(d, c->report, c->report_len);
+    }
+    int64_t walk_ns = now_ns() - start;
+    uni_controller_t walked = d->controller;
+
+    start = now_ns();
+    for (int i = 0; i < iterations; i++) {
+        c->init_report(d);
+        uni_hid_parser_dispatch_report(d, c->report, c->report_len);
+    }
+    int64_t compiled_ns = now_ns() - start;
+
+    bool match = memcmp(&walked, &d->controller, sizeof(walked)) == 0;
+    printf("%-8s: walk %.1f ns, compiled %.1f ns per report (%d fields)%s\n", c->name,
+           (double)walk_ns / iterations, (double)compiled_ns / iterations, d->report_table.field_count,
+           match ? "" : ", RESULT MISMATCH");
+    return match ? 0 : 1;
+}
+
+int main(int argc, char** argv) {
+    int iterations = argc > 1 ? atoi(argv[1]) : DEFAULT_ITERATIONS;
+    if (iterations <= 0) iterations = DEFAULT_ITERATIONS;
+
+    printf("HID input report parsing, %d iterations\n", iterations);
+    int errors = 0;
+    for (size_t i = 0; i < sizeof(cases) / sizeof(cases[0]); i++) errors += run(&cases[i], iterations);
+    return errors ? 1 : 0;
+}
@@ -0,0 +1,6 @@
+// uni_controller_list.cmake 가 거부해야 하는 목록: 대소문자만 다른 같은 ID
+static const uni_controller_description_t arrControllers[] = {
+	{ MAKE_CONTROLLER_ID( 0x0079, 0x181a ), k_eControllerType_PS3Controller, NULL },
+	{ MAKE_CONTROLLER_ID( 0x054c, 0x0268 ), k_eControllerType_PS3Controller, NULL },
+	{ MAKE_CONTROLLER_ID( 0x0079, 0x181A ), k_eControllerType_PS4Controller, NULL },
+};
@@ -0,0 +1,4 @@
+# cmake -DINPUT=<목록> -DOUTPUT=<생성 파일> -P controller_list_generate.cmake
+# 빌드 때와 같은 함수로 컨트롤러 목록을 만든다 (잘못된 목록을 거부하는지 확인용)
+include(${CMAKE_CURRENT_LIST_DIR}/../../components/bluepad32/controller/uni_controller_list.cmake)
+uni_generate_controller_list(${INPUT} ${OUTPUT})
@@ -0,0 +1,92 @@
+// 컨트롤러 VID:PID 목록 테스트 (Bluepad32 uni_controller_type).
+// 빌드 때 만든 정렬 목록 (uni_controller_list_sorted.h) 이 손으로 고치는 원본 목록과
+// 같은 항목을 담고 있는지, 이진 탐색이 원본을 차례로 찾은 결과와 같은지 확인한다.
+
+#include <stdbool.h>
+#include <stdio.h>
+#include <string.h>
+
+#include "controller/uni_controller_type.h"
+
+// 원본 목록 (SDL 형식, 정렬 안 됨)
+#include "controller/uni_controller_list.h"
+#undef MAKE_CONTROLLER_ID
+static const uni_controller_description_t* const source = arrControllers;
+static const size_t source_count = sizeof(arrControllers) / sizeof(arrControllers[0]);
+#define arrControllers sorted_controllers
+#include "uni_controller_list_sorted.h"
+#undef arrControllers
+
+#define ARRAY_SIZE(a) (sizeof(a) / sizeof((a)[0]))
+
+static int errors = 0;
+
+// 원본 목록을 처음부터 찾는다 (예전 구현과 같은 방식)
+static const uni_controller_description_t* find_linear(uint32_t id) {
+    for (size_t i = 0; i < source_count; i++) {
+        if (source[i].device_id == id) return &source[i];
+    }
+    return NULL;
+}
+
+static bool same_name(const char* a, const char* b) {
+    return a == b || (a != NULL && b != NULL && strcmp(a, b) == 0);
+}
+
+static void check_lookup(uint32_t id) {
+    uint16_t vid = (uint16_t)(id >> 16);
+    uint16_t pid = (uint16_t)id;
+    const uni_controller_description_t* expected = find_linear(id);
+    uni_controller_type_t type = uni_guess_controller_type(vid, pid);
+    const char* name = uni_guess_controller_name(vid, pid);
+
+    if (expected == NULL) {
+        if (type != k_eControllerType_UnknownNonSteamController || name != NULL) {
+            printf("%04x:%04x: found type %d, not in the list\n", vid, pid, type);
+            errors++;
+        }
+    } else if (type != expected->controller_type || !same_name(name, expected->name)) {
+        printf("%04x:%04x: type %d \"%s\", expected %d \"%s\"\n", vid, pid, type, name ? name : "", expected->controller_type,
+               expected->name ? expected->name : "");
+        errors++;
+    }
+}
+
+int main(void) {
+    // 정렬 목록: 원본과 항목 수가 같고, ID 가 엄격히 증가하고, 모든 항목이 원본에 그대로 있다
+    if (ARRAY_SIZE(sorted_controllers) != source_count) {
+        printf("sorted list has %zu entries, source has %zu\n", ARRAY_SIZE(sorted_controllers), source_count);
+        errors++;
+    }
+    for (size_t i = 0; i < ARRAY_SIZE(sorted_controllers); i++) {
+        const uni_controller_description_t* c = &sorted_controllers[i];
+        const uni_controller_description_t* s = find_linear(c->device_id);
+        if (i > 0 && sorted_controllers[i - 1].device_id >= c->device_id) {
+            printf("sorted list: entry %zu (%08x) is not after %08x\n", i, (unsigned)c->device_id,
+                   (unsigned)sorted_controllers[i - 1].device_id);
+            errors++;
+        }
+        if (s == NULL || s->controller_type != c->controller_type || !same_name(s->name, c->name)) {
+            printf("sorted list: entry %08x differs from the source\n", (unsigned)c->device_id);
+            errors++;
+        }
+    }
+
+    // 모든 ID 와 그 이웃 ID (목록에 없는 값 포함) 를 두 방식으로 찾아 비교한다
+    for (size_t i = 0; i < source_count; i++) {
+        check_lookup(source[i].device_id - 1);
+        check_lookup(source[i].device_id);
+        check_lookup(source[i].device_id + 1);
+    }
+    check_lookup(0x00000000);
+    check_lookup(0xFFFFFFFF);
+    // 주석 처리된 항목 (Logitech G29) 은 빠진다
+    check_lookup(0x046dc24f);
+    if (uni_guess_controller_type(0x046d, 0xc24f) != k_eControllerType_UnknownNonSteamController) {
+        printf("commented-out 046d:c24f is in the list\n");
+        errors++;
+    }
+
+    printf("%zu controllers, %d errors\n", source_count, errors);
+    return errors ? 1 : 0;
+}
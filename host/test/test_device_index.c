@@ -0,0 +1,121 @@
+// uni_device_index 테스트 (Bluepad32 의 cid/핸들/주소 -> 기기 번호 색인).
+// 기기마다 키 두 개 (제어/인터럽트 cid 처럼) 를 무작위로 바꾸면서 색인을 uni_hid_device 와 같은 방식으로
+// 갱신하고, 바꿀 때마다 모든 키를 색인과 순차 탐색 (예전 구현) 으로 찾아 결과를 비교한다.
+// 키 범위를 좁게 잡아 여러 기기가 같은 키를 갖는 경우와 해시 충돌 (긴 탐사 사슬) 이 자주 생기게 한다.
+
+#include <stdbool.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "uni_device_index.h"
+
+#define DEVICES        CONFIG_BLUEPAD32_MAX_DEVICES
+#define KEYS_PER_DEV   2
+#define KEY_RANGE      24      // 0..KEY_RANGE-1, 이 밖의 값은 항상 없어야 한다
+#define CHANGES        200000
+
+typedef struct {
+    bool valid;
+    uint16_t key;     // 색인에 넣은 키
+    uint16_t value;   // 주소처럼 키가 해시일 때의 실제 값
+} key_state_t;
+
+static key_state_t keys[DEVICES][KEYS_PER_DEV];
+static uni_device_index_t table;
+static int errors = 0;
+
+// 주소 색인처럼 키는 실제 값의 해시: 서로 다른 값이 같은 키가 될 수 있다
+static uint16_t hash_key(uint16_t value) {
+    return value % 7;
+}
+
+static bool value_matches(int idx, const void* data) {
+    uint16_t value = *(const uint16_t*)data;
+    for (int s = 0; s < KEYS_PER_DEV; s++) {
+        if (keys[idx][s].valid && keys[idx][s].value == value) return true;
+    }
+    return false;
+}
+
+// 예전 구현: 기기를 차례로 보며 처음 맞는 기기
+static int scan(uint16_t key, bool by_value) {
+    for (int d = 0; d < DEVICES; d++) {
+        for (int s = 0; s < KEYS_PER_DEV; s++) {
+            if (keys[d][s].valid && (by_value ? keys[d][s].value : keys[d][s].key) == key) return d;
+        }
+    }
+    return -1;
+}
+
+static int used_slots(void) {
+    int n = 0;
+    for (int i = 0; i < UNI_DEVICE_INDEX_SLOTS; i++) {
+        if (table.slots[i].dev != 0) n++;
+    }
+    return n;
+}
+
+static void set_key(int dev, int slot, bool valid, uint16_t key, uint16_t value) {
+    key_state_t* k = &keys[dev][slot];
+    if (k->valid == valid && (!valid || k->key == key)) {
+        k->value = value;
+        return;
+    }
+    if (k->valid) uni_device_index_remove(&table, k->key, dev);
+    if (valid) uni_device_index_insert(&table, key, dev);
+    *k = (key_state_t){.valid = valid, .key = key, .value = value};
+}
+
+static int check_all(bool hashed, int change) {
+    int valid = 0;
+    for (int d = 0; d < DEVICES; d++) {
+        for (int s = 0; s < KEYS_PER_DEV; s++) valid += keys[d][s].valid;
+    }
+    if (used_slots() != valid) {
+        printf("change %d: %d slots used for %d keys\n", change, used_slots(), valid);
+        return 1;
+    }
+
+    for (uint16_t v = 0; v < KEY_RANGE + 4; v++) {
+        int expected = scan(v, hashed);
+        int found = hashed ? uni_device_index_find(&table, hash_key(v), value_matches, &v)
+                           : uni_device_index_find(&table, v, NULL, NULL);
+        if (found != expected) {
+            printf("change %d: %s %u found device %d, scan found %d\n", change, hashed ? "value" : "key", v, found,
+                   expected);
+            return 1;
+        }
+    }
+    return 0;
+}
+
+static void run(bool hashed, unsigned seed) {
+    srand(seed);
+    for (int change = 0; change < CHANGES && errors < 10; change++) {
+        int dev = rand() % DEVICES;
+        int slot = rand() % KEYS_PER_DEV;
+        // 1/4 은 키를 지운다 (연결 해제)
+        bool valid = rand() % 4 != 0;
+        uint16_t value = (uint16_t)(rand() % KEY_RANGE);
+        set_key(dev, slot, valid, hashed ? hash_key(value) : value, value);
+        errors += check_all(hashed, change);
+    }
+
+    // 모두 지우면 표가 빈다
+    for (int d = 0; d < DEVICES; d++) {
+        for (int s = 0; s < KEYS_PER_DEV; s++) set_key(d, s, false, 0, 0);
+    }
+    if (used_slots() != 0) {
+        printf("%s: %d slots left after removing every key\n", hashed ? "hashed" : "plain", used_slots());
+        errors++;
+    }
+}
+
+int main(void) {
+    run(false, 1);
+    run(true, 2);
+
+    printf("%d devices, %d slots, %d changes per run, %d errors\n", DEVICES, UNI_DEVICE_INDEX_SLOTS, CHANGES,
+           errors);
+    return errors ? 1 : 0;
+}
@@ -0,0 +1,112 @@
+// dfplayer_parser 테스트.
+// DFPlayer Mini 응답 형식으로 만든 바이트열 (부팅 잡음, 연속 응답, 손상 프레임) 을
+// 여러 조각 크기로 나눠 넣고, 나온 프레임과 통계 (frames, bad_frames, skipped) 를 확인한다.
+
+#include <stdio.h>
+#include <stddef.h>
+
+#include "dfplayer_parser.h"
+
+#define ARRAY_SIZE(a) (sizeof(a) / sizeof((a)[0]))
+#define MAX_FRAMES 8
+
+// 자주 오는 응답 프레임
+#define FRAME_ONLINE_SD   0x7E, 0xFF, 0x06, 0x3F, 0x00, 0x00, 0x02, 0xFE, 0xBA, 0xEF
+#define FRAME_ACK         0x7E, 0xFF, 0x06, 0x41, 0x00, 0x00, 0x00, 0xFE, 0xBA, 0xEF
+#define FRAME_FINISHED_3  0x7E, 0xFF, 0x06, 0x3D, 0x00, 0x00, 0x03, 0xFE, 0xBB, 0xEF
+#define FRAME_FILES_12    0x7E, 0xFF, 0x06, 0x48, 0x00, 0x00, 0x0C, 0xFE, 0xA7, 0xEF
+#define FRAME_FILES_126   0x7E, 0xFF, 0x06, 0x48, 0x00, 0x00, 0x7E, 0xFE, 0x35, 0xEF
+
+typedef struct {
+    const char* name;
+    const uint8_t* bytes;
+    size_t length;
+    dfplayer_frame_t frames[MAX_FRAMES];
+    uint32_t frame_count;
+    uint32_t bad_frames;
+    uint32_t skipped;
+} stream_case_t;
+
+#define STREAM(bytes_) (bytes_), sizeof(bytes_)
+
+// 전원 인가 직후 잡음 뒤 온라인 알림
+static const uint8_t boot_noise[] = {0x00, 0xFF, 0x00, FRAME_ONLINE_SD};
+// ACK, 재생 완료, 파일 수 응답이 연달아 도착
+static const uint8_t back_to_back[] = {FRAME_ACK, FRAME_FINISHED_3, FRAME_FILES_12};
+// 체크섬 하위 바이트가 깨진 ACK 다음 정상 프레임
+static const uint8_t bad_checksum[] = {0x7E, 0xFF, 0x06, 0x41, 0x00, 0x00, 0x00, 0xFE, 0xBB, 0xEF, FRAME_FINISHED_3};
+// 종료 바이트가 빠진 오류 응답 다음 정상 프레임
+static const uint8_t bad_end[] = {0x7E, 0xFF, 0x06, 0x40, 0x00, 0x00, 0x01, 0xFE, 0xBA, 0x00, FRAME_ACK};
+// 중간이 잘린 프레임 바로 뒤 새 프레임: 버퍼 안의 시작 바이트로 재동기화해야 한다
+static const uint8_t truncated[] = {0x7E, 0xFF, 0x06, 0x41, 0x00, FRAME_FINISHED_3};
+// 시작 바이트 중복
+static const uint8_t double_start[] = {0x7E, FRAME_ONLINE_SD};
+// 파라미터에 시작 바이트 값이 들어 있는 정상 프레임
+static const uint8_t start_in_payload[] = {FRAME_FILES_126, FRAME_ACK};
+
+static const stream_case_t cases[] = {
+    {"boot_noise", STREAM(boot_noise), {{0x3F, 0, 2}}, 1, 0, 3},
+    {"back_to_back", STREAM(back_to_back), {{0x41, 0, 0}, {0x3D, 0, 3}, {0x48, 0, 12}}, 3, 0, 0},
+    {"bad_checksum", STREAM(bad_checksum), {{0x3D, 0, 3}}, 1, 1, 10},
+    {"bad_end", STREAM(bad_end), {{0x41, 0, 0}}, 1, 1, 10},
+    {"truncated", STREAM(truncated), {{0x3D, 0, 3}}, 1, 1, 5},
+    {"double_start", STREAM(double_start), {{0x3F, 0, 2}}, 1, 0, 1},
+    {"start_in_payload", STREAM(start_in_payload), {{0x48, 0, 126}, {0x41, 0, 0}}, 2, 0, 0},
+};
+
+// UART 에서 chunk 바이트씩 읽어 넣는 것처럼 먹인다
+static int run_case(const stream_case_t* c, size_t chunk) {
+    dfplayer_parser_t parser;
+    dfplayer_frame_t frame;
+    uint32_t count = 0;
+    int errors = 0;
+
+    dfplayer_parser_init(&parser);
+    for (size_t pos = 0; pos < c->length; pos += chunk) {
+        size_t end = pos + chunk < c->length ? pos + chunk : c->length;
+        for (size_t i = pos; i < end; i++) {
+            if (!dfplayer_parser_feed(&parser, c->bytes[i], &frame)) {
+                continue;
+            }
+            if (count >= c->frame_count) {
+                printf("%s/%zu: unexpected frame cmd 0x%02X\n", c->name, chunk, frame.command);
+                errors++;
+            } else if (frame.command != c->frames[count].command || frame.feedback != c->frames[count].feedback ||
+                       frame.parameter != c->frames[count].parameter) {
+                printf("%s/%zu: frame %u is 0x%02X/%u, expected 0x%02X/%u\n", c->name, chunk, count,
+                       frame.command, frame.parameter, c->frames[count].command, c->frames[count].parameter);
+                errors++;
+            }
+            count++;
+        }
+    }
+
+    if (count != c->frame_count || parser.frames != c->frame_count || parser.bad_frames != c->bad_frames ||
+        parser.skipped != c->skipped) {
+        printf("%s/%zu: frames %u (%u), bad %u, skipped %u; expected %u, %u, %u\n", c->name, chunk, count,
+               parser.frames, parser.bad_frames, parser.skipped, c->frame_count, c->bad_frames, c->skipped);
+        errors++;
+    }
+    return errors;
+}
+
+int main(void) {
+    static const size_t chunks[] = {1, 3, 7, DFPLAYER_FRAME_SIZE, 64};
+    int errors = 0;
+
+    for (size_t i = 0; i < ARRAY_SIZE(cases); i++) {
+        for (size_t j = 0; j < ARRAY_SIZE(chunks); j++) {
+            errors += run_case(&cases[i], chunks[j]);
+        }
+    }
+
+    // 체크섬: version ~ param_lsb 합의 2의 보수
+    static const uint8_t ack[] = {FRAME_ACK};
+    if (dfplayer_checksum(&ack[1], 6) != 0xFEBA) {
+        printf("checksum 0x%04X, expected 0xFEBA\n", dfplayer_checksum(&ack[1], 6));
+        errors++;
+    }
+
+    printf("%zu streams, %d errors\n", ARRAY_SIZE(cases), errors);
+    return errors ? 1 : 0;
+}
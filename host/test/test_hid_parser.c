@@ -0,0 +1,206 @@
+// Bluepad32 HID 보고서 파서 테스트 (uni_hid_parser).
+// 보고서 ID 를 쓰는 게임패드 (Xbox One, 펌웨어 4.8), 부트 키보드, 부트 마우스 기술자마다
+// 무작위 입력 보고서를 만들어, 기술자를 매번 훑는 경로 (uni_hid_parser_walk_report) 와
+// 미리 컴파일한 표로 나누는 경로 (uni_hid_parser_dispatch_report) 가 parse_usage 를
+// 같은 순서, 같은 인자로 부르는지 비교한다. 길이가 모자라거나 넘치는 보고서, 입력이 없는 보고서 ID 도 섞는다.
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "parser/uni_hid_parser.h"
+#include "uni_hid_device.h"
+
+#define MAX_CALLS 256
+#define REPORTS_PER_ID 2000
+
+typedef struct {
+    hid_globals_t globals;
+    uint16_t usage_page;
+    uint16_t usage;
+    int32_t value;
+} usage_call_t;
+
+typedef struct {
+    usage_call_t calls[MAX_CALLS];
+    int count;
+} usage_log_t;
+
+// uni_gamepad.c 와 btstack hci_dump.c 대신 (축 정규화 폭, BTstack 로그)
+const int AXIS_NORMALIZE_RANGE = 1024;
+
+void hci_dump_log(int log_level, const char* format, ...) {
+}
+
+static usage_log_t* current_log;
+static uni_hid_device_t device;
+
+static void record_usage(struct uni_hid_device_s* d,
+                         const hid_globals_t* globals,
+                         uint16_t usage_page,
+                         uint16_t usage,
+                         int32_t value) {
+    if (current_log->count < MAX_CALLS) {
+        current_log->calls[current_log->count++] = (usage_call_t){*globals, usage_page, usage, value};
+    }
+}
+
+// Xbox One 무선 컨트롤러 (펌웨어 4.8): 입력 보고서 ID 1, 2, 4 와 출력 보고서 ID 3
+static const uint8_t xbox_descriptor[] = {
+    0x05, 0x01, 0x09, 0x05, 0xa1, 0x01, 0x85, 0x01, 0x09, 0x01, 0xa1, 0x00, 0x09, 0x30, 0x09, 0x31, 0x15, 0x00, 0x27,
+    0xff, 0xff, 0x00, 0x00, 0x95, 0x02, 0x75, 0x10, 0x81, 0x02, 0xc0, 0x09, 0x01, 0xa1, 0x00, 0x09, 0x32, 0x09, 0x35,
+    0x15, 0x00, 0x27, 0xff, 0xff, 0x00, 0x00, 0x95, 0x02, 0x75, 0x10, 0x81, 0x02, 0xc0, 0x05, 0x02, 0x09, 0xc5, 0x15,
+    0x00, 0x26, 0xff, 0x03, 0x95, 0x01, 0x75, 0x0a, 0x81, 0x02, 0x15, 0x00, 0x25, 0x00, 0x75, 0x06, 0x95, 0x01, 0x81,
+    0x03, 0x05, 0x02, 0x09, 0xc4, 0x15, 0x00, 0x26, 0xff, 0x03, 0x95, 0x01, 0x75, 0x0a, 0x81, 0x02, 0x15, 0x00, 0x25,
+    0x00, 0x75, 0x06, 0x95, 0x01, 0x81, 0x03, 0x05, 0x01, 0x09, 0x39, 0x15, 0x01, 0x25, 0x08, 0x35, 0x00, 0x46, 0x3b,
+    0x01, 0x66, 0x14, 0x00, 0x75, 0x04, 0x95, 0x01, 0x81, 0x42, 0x75, 0x04, 0x95, 0x01, 0x15, 0x00, 0x25, 0x00, 0x35,
+    0x00, 0x45, 0x00, 0x65, 0x00, 0x81, 0x03, 0x05, 0x09, 0x19, 0x01, 0x29, 0x0f, 0x15, 0x00, 0x25, 0x01, 0x75, 0x01,
+    0x95, 0x0f, 0x81, 0x02, 0x15, 0x00, 0x25, 0x00, 0x75, 0x01, 0x95, 0x01, 0x81, 0x03, 0x05, 0x0c, 0x0a, 0x24, 0x02,
+    0x15, 0x00, 0x25, 0x01, 0x95, 0x01, 0x75, 0x01, 0x81, 0x02, 0x15, 0x00, 0x25, 0x00, 0x75, 0x07, 0x95, 0x01, 0x81,
+    0x03, 0x05, 0x0c, 0x09, 0x01, 0x85, 0x02, 0xa1, 0x01, 0x05, 0x0c, 0x0a, 0x23, 0x02, 0x15, 0x00, 0x25, 0x01, 0x95,
+    0x01, 0x75, 0x01, 0x81, 0x02, 0x15, 0x00, 0x25, 0x00, 0x75, 0x07, 0x95, 0x01, 0x81, 0x03, 0xc0, 0x05, 0x0f, 0x09,
+    0x21, 0x85, 0x03, 0xa1, 0x02, 0x09, 0x97, 0x15, 0x00, 0x25, 0x01, 0x75, 0x04, 0x95, 0x01, 0x91, 0x02, 0x15, 0x00,
+    0x25, 0x00, 0x75, 0x04, 0x95, 0x01, 0x91, 0x03, 0x09, 0x70, 0x15, 0x00, 0x25, 0x64, 0x75, 0x08, 0x95, 0x04, 0x91,
+    0x02, 0x09, 0x50, 0x66, 0x01, 0x10, 0x55, 0x0e, 0x15, 0x00, 0x26, 0xff, 0x00, 0x75, 0x08, 0x95, 0x01, 0x91, 0x02,
+    0x09, 0xa7, 0x15, 0x00, 0x26, 0xff, 0x00, 0x75, 0x08, 0x95, 0x01, 0x91, 0x02, 0x65, 0x00, 0x55, 0x00, 0x09, 0x7c,
+    0x15, 0x00, 0x26, 0xff, 0x00, 0x75, 0x08, 0x95, 0x01, 0x91, 0x02, 0xc0, 0x05, 0x06, 0x09, 0x20, 0x85, 0x04, 0x15,
+    0x00, 0x26, 0xff, 0x00, 0x75, 0x08, 0x95, 0x01, 0x81, 0x02, 0xc0,
+};
+
+// HID 1.11 부록 B.1 부트 키보드: 보고서 ID 없음, 키 코드 배열 (Array 필드)
+static const uint8_t keyboard_descriptor[] = {
+    0x05, 0x01, 0x09, 0x06, 0xa1, 0x01, 0x05, 0x07, 0x19, 0xe0, 0x29, 0xe7, 0x15, 0x00, 0x25, 0x01,
+    0x75, 0x01, 0x95, 0x08, 0x81, 0x02, 0x95, 0x01, 0x75, 0x08, 0x81, 0x01, 0x95, 0x05, 0x75, 0x01,
+    0x05, 0x08, 0x19, 0x01, 0x29, 0x05, 0x91, 0x02, 0x95, 0x01, 0x75, 0x03, 0x91, 0x01, 0x95, 0x06,
+    0x75, 0x08, 0x15, 0x00, 0x25, 0x65, 0x05, 0x07, 0x19, 0x00, 0x29, 0x65, 0x81, 0x00, 0xc0,
+};
+
+// HID 1.11 부록 B.2 부트 마우스: 부호 있는 8비트 X/Y
+static const uint8_t mouse_descriptor[] = {
+    0x05, 0x01, 0x09, 0x02, 0xa1, 0x01, 0x09, 0x01, 0xa1, 0x00, 0x05, 0x09, 0x19, 0x01, 0x29, 0x03,
+    0x15, 0x00, 0x25, 0x01, 0x95, 0x03, 0x75, 0x01, 0x81, 0x02, 0x95, 0x01, 0x75, 0x05, 0x81, 0x01,
+    0x05, 0x01, 0x09, 0x30, 0x09, 0x31, 0x15, 0x81, 0x25, 0x7f, 0x75, 0x08, 0x95, 0x02, 0x81, 0x06,
+    0xc0, 0xc0,
+};
+
+// 보고서 ID 가 있는 필드와 없는 필드가 섞인 기술자: 컴파일하지 않고 매번 훑어야 한다
+static const uint8_t mixed_descriptor[] = {
+    0x05, 0x01, 0x09, 0x05, 0xa1, 0x01, 0x09, 0x30, 0x15, 0x00, 0x26, 0xff, 0x00, 0x75, 0x08, 0x95,
+    0x01, 0x81, 0x02, 0x85, 0x01, 0x09, 0x31, 0x81, 0x02, 0xc0,
+};
+
+typedef struct {
+    const char* name;
+    const uint8_t* descriptor;
+    uint16_t descriptor_len;
+    bool compiles;
+    uint8_t report_ids[6];  // 보낼 보고서 ID (0 이면 ID 없음). 입력이 없는 ID 도 넣는다
+    int report_id_count;
+} descriptor_case_t;
+
+static const descriptor_case_t cases[] = {
+    {"xbox", xbox_descriptor, sizeof(xbox_descriptor), true, {1, 2, 3, 4, 5}, 5},
+    {"keyboard", keyboard_descriptor, sizeof(keyboard_descriptor), true, {0}, 1},
+    {"mouse", mouse_descriptor, sizeof(mouse_descriptor), true, {0}, 1},
+    {"mixed", mixed_descriptor, sizeof(mixed_descriptor), false, {0, 1}, 2},
+};
+
+static bool same_globals(const hid_globals_t* a, const hid_globals_t* b) {
+    return a->logical_minimum == b->logical_minimum && a->logical_maximum == b->logical_maximum &&
+           a->usage_page == b->usage_page && a->report_size == b->report_size &&
+           a->report_count == b->report_count && a->report_id == b->report_id;
+}
+
+static int compare_logs(const char* name, const uint8_t* report, uint16_t len, const usage_log_t* walk,
+                        const usage_log_t* dispatch) {
+    int first = -1;
+    for (int i = 0; i < walk->count && i < dispatch->count; i++) {
+        const usage_call_t* a = &walk->calls[i];
+        const usage_call_t* b = &dispatch->calls[i];
+        if (a->usage_page != b->usage_page || a->usage != b->usage || a->value != b->value ||
+            !same_globals(&a->globals, &b->globals)) {
+            first = i;
+            break;
+        }
+    }
+    if (first < 0 && walk->count == dispatch->count) {
+        return 0;
+    }
+
+    printf("%s: report", name);
+    for (uint16_t i = 0; i < len; i++) printf(" %02x", report[i]);
+    printf(" (%u bytes): walk %d calls, dispatch %d calls", len, walk->count, dispatch->count);
+    if (first >= 0) {
+        const usage_call_t* a = &walk->calls[first];
+        const usage_call_t* b = &dispatch->calls[first];
+        printf(", call %d is %04x:%04x=%d vs %04x:%04x=%d", first, a->usage_page, a->usage, a->value, b->usage_page,
+               b->usage, b->value);
+    }
+    printf("\n");
+    return 1;
+}
+
+static int run_case(const descriptor_case_t* c) {
+    static usage_log_t walk_log;
+    static usage_log_t dispatch_log;
+    int errors = 0;
+    int calls = 0;
+
+    memset(&device, 0, sizeof(device));
+    memcpy(device.hid_descriptor, c->descriptor, c->descriptor_len);
+    device.hid_descriptor_len = c->descriptor_len;
+    device.report_parser.parse_usage = record_usage;
+
+    bool compiled = uni_hid_parser_compile_descriptor(&device);
+    if (compiled != c->compiles) {
+        printf("%s: compile returned %d, expected %d\n", c->name, compiled, c->compiles);
+        return 1;
+    }
+
+    for (int r = 0; r < c->report_id_count; r++) {
+        uint8_t id = c->report_ids[r];
+        int size = btstack_hid_get_report_size_for_id(id ? id : HID_REPORT_ID_UNDEFINED, HID_REPORT_TYPE_INPUT,
+                                                      c->descriptor, c->descriptor_len);
+        // 입력 보고서 크기 (ID 바이트 포함), 입력이 없는 ID 는 몇 바이트짜리로 보낸다
+        int full = (size > 0 ? size : 4) + (id ? 1 : 0);
+
+        for (int n = 0; n < REPORTS_PER_ID; n++) {
+            // BTstack 파서는 잘린 보고서에서 끝 다음 바이트를 한 번 읽는다. 컴파일한 경로는 끝 뒤를 0 으로 보므로
+            // 비교할 수 있게 버퍼 나머지를 0 으로 둔다
+            uint8_t report[64] = {0};
+            // 대부분은 온전한 길이, 일부는 잘리거나 남는 바이트가 붙은 보고서
+            uint16_t len = (uint16_t)(n % 4 == 0 ? rand() % (full + 3) : full);
+            if (len > sizeof(report) - 1) len = sizeof(report) - 1;
+            for (uint16_t i = 0; i < len; i++) report[i] = (uint8_t)rand();
+            if (id && len > 0) report[0] = id;
+
+            walk_log.count = 0;
+            current_log = &walk_log;
+            uni_hid_parser_walk_report(&device, report, len);
+
+            dispatch_log.count = 0;
+            current_log = &dispatch_log;
+            uni_hid_parse_input_report(&device, report, len);
+
+            calls += walk_log.count;
+            if (compare_logs(c->name, report, len, &walk_log, &dispatch_log) && ++errors >= 5) {
+                return errors;
+            }
+        }
+    }
+    printf("%s: %s, %d reports, %d parse_usage calls\n", c->name, compiled ? "compiled" : "walked",
+           c->report_id_count * REPORTS_PER_ID, calls);
+    return errors;
+}
+
+int main(void) {
+    int errors = 0;
+
+    srand(1);
+    for (size_t i = 0; i < ARRAY_SIZE(cases); i++) {
+        errors += run_case(&cases[i]);
+    }
+
+    printf("%zu descriptors, %d errors\n", ARRAY_SIZE(cases), errors);
+    return errors ? 1 : 0;
+}
@@ -0,0 +1,136 @@
+// rc_tank_record 테스트.
+// POSIX HAL 의 RAM 플래시와 이산 사건 스케줄러 위에서 기록 태스크를 돌린다.
+// 1. 섹터 세 개가 넘는 기록을 정상 종료하고 요약이 헤더 길이와 맞는지 확인한다.
+// 2. 같은 자리에 새 기록을 시작하고 첫 섹터의 마지막 페이지를 쓴 직후 전원이 끊긴 것으로 본다.
+//    남은 기록은 첫 섹터 안에서 끝나야 하고, 뒤에 남은 이전 기록이 이어 읽히면 안 된다.
+
+#include <stdio.h>
+#include <string.h>
+
+#include "rc_tank.h"
+#include "rc_tank_bindings.h"
+#include "rc_tank_hal.h"
+#include "rc_tank_loop.h"
+#include "rc_tank_record.h"
+#include "sim_rtos.h"
+
+#define TICK_US     (1000000 / RC_TANK_CONTROL_RATE_HZ)
+#define START_US    1000000
+#define OLD_TICKS   (35 * RC_TANK_CONTROL_RATE_HZ)   // 약 14KB: 섹터 세 개를 넘긴다
+#define CUT_PAGE    (RC_TANK_HAL_LOG_SECTOR - RC_TANK_RECORD_PAGE_SIZE)
+#define CUT_SLACK   8   // 섹터 끝에 걸친 레코드는 지운 바이트를 몇 개 (varint 최대 5) 더 읽고 끝난다
+
+// rc_tank_record 가 쓰는 제어 상태와 바인딩 표 (재생하지 않으므로 비워 둔다)
+rc_tank_control_t rc_tank;
+
+void rc_tank_bindings_process(uint8_t seat, uint32_t state, int64_t now_us) {
+}
+
+void rc_tank_bindings_reset_seat(uint8_t seat) {
+}
+
+static int64_t now_us = START_US;
+static int errors = 0;
+
+#define CHECK(cond, ...)                 \
+    do {                                 \
+        if (!(cond)) {                   \
+            printf(__VA_ARGS__);         \
+            printf("\n");                \
+            errors++;                    \
+        }                                \
+    } while (0)
+
+// 제어 틱 하나: 스케줄러를 돌리고 스틱 입력을 기록한다.
+// Y축을 양자화 한 단계씩 흔들어 틱마다 2바이트 레코드가 하나씩 생긴다
+static void control_tick(int16_t base) {
+    static bool odd = false;
+    rc_tank_input_t input = {.link = 0, .active = true};
+
+    now_us += TICK_US;
+    sim_rtos_run_until(now_us);
+    odd = !odd;
+    input.axis_y = (int16_t)(base + (odd ? 1 << RC_TANK_RECORD_AXIS_SHIFT : 0));
+    rc_tank_record_input(&input, now_us);
+}
+
+static bool page_erased(uint32_t offset) {
+    uint8_t buf[RC_TANK_RECORD_PAGE_SIZE];
+    if (!rc_tank_hal_log_read(offset, buf, sizeof(buf))) {
+        return false;
+    }
+    for (size_t i = 0; i < sizeof(buf); i++) {
+        if (buf[i] != 0xFF) return false;
+    }
+    return true;
+}
+
+static void check_complete_session(void) {
+    CHECK(rc_tank_record_start(), "old: start failed");
+    sim_rtos_run_until(now_us);
+    for (int i = 0; i < OLD_TICKS; i++) {
+        control_tick(-256);
+    }
+    rc_tank_record_stop();
+    now_us += 100 * 1000;
+    sim_rtos_run_until(now_us);
+
+    rc_tank_record_info_t info;
+    uint32_t length = 0;
+    CHECK(rc_tank_record_mode() == RC_TANK_RECORD_IDLE, "old: still recording");
+    CHECK(rc_tank_record_scan(&info), "old: scan failed");
+    // 헤더의 length 필드 (magic, version, tick_us 다음)
+    CHECK(rc_tank_hal_log_read(8, &length, sizeof(length)), "old: header read failed");
+    CHECK(info.complete, "old: not complete");
+    CHECK(length > 3 * RC_TANK_HAL_LOG_SECTOR, "old: only %u bytes, expected more than three sectors",
+          (unsigned)length);
+    CHECK(info.bytes == length, "old: scanned %u bytes, header says %u", (unsigned)info.bytes, (unsigned)length);
+    CHECK(info.records >= OLD_TICKS, "old: %u records, expected at least %d", (unsigned)info.records, OLD_TICKS);
+    printf("old session: %u bytes, %u records, %u ms\n", (unsigned)info.bytes, (unsigned)info.records,
+           (unsigned)info.duration_ms);
+}
+
+static void check_cut_session(void) {
+    int64_t start = now_us;
+
+    CHECK(rc_tank_record_start(), "cut: start failed");
+    sim_rtos_run_until(now_us);
+    // 첫 페이지를 쓰며 첫 섹터를 지운 뒤, 그 섹터의 마지막 페이지가 써질 때까지 기록한다
+    // (플러시 한 번에 한 페이지도 차지 않으므로 그 직후가 정확히 섹터 끝이다)
+    int ticks = 0;
+    while (!page_erased(CUT_PAGE) && ticks < OLD_TICKS) {
+        control_tick(256);
+        ticks++;
+    }
+    while (page_erased(CUT_PAGE) && ticks < OLD_TICKS) {
+        control_tick(256);
+        ticks++;
+    }
+    CHECK(!page_erased(CUT_PAGE), "cut: first sector never filled");
+    CHECK(page_erased(RC_TANK_HAL_LOG_SECTOR), "cut: second sector still holds the old session");
+
+    // 여기서 전원이 끊겼다고 보고 (stop 없이) 플래시를 그대로 읽는다
+    rc_tank_record_info_t info;
+    uint32_t elapsed_ms = (uint32_t)((now_us - start) / 1000);
+    CHECK(rc_tank_record_scan(&info), "cut: scan failed");
+    CHECK(!info.complete, "cut: reported complete");
+    CHECK(info.bytes <= RC_TANK_HAL_LOG_SECTOR + CUT_SLACK, "cut: read %u bytes past the cut at %u", (unsigned)info.bytes,
+          RC_TANK_HAL_LOG_SECTOR);
+    CHECK(info.records > 0 && info.records <= (uint32_t)ticks + 1, "cut: %u records for %d ticks",
+          (unsigned)info.records, ticks);
+    CHECK(info.duration_ms <= elapsed_ms, "cut: %u ms recorded in %u ms", (unsigned)info.duration_ms,
+          (unsigned)elapsed_ms);
+    printf("cut session: %u bytes, %u records, %u ms\n", (unsigned)info.bytes, (unsigned)info.records,
+           (unsigned)info.duration_ms);
+}
+
+int main(void) {
+    sim_rtos_init(START_US);
+    rc_tank_record_init();
+
+    check_complete_session();
+    check_cut_session();
+
+    printf("%d errors\n", errors);
+    return errors ? 1 : 0;
+}
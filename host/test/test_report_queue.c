@@ -0,0 +1,174 @@
+// uni_report_queue 테스트 (Bluepad32 의 기기 공용 송신 대기열).
+// 기기별 순서, 같은 종류 보고서 교체, 기기당/전체 한도, 초기화를 확인하고
+// 링크가 보고서를 보내는 속도보다 진동 갱신이 잦을 때 대기열이 늘지 않는지 본다.
+
+#include <stdio.h>
+#include <string.h>
+
+#include "uni_report_queue.h"
+
+#define INTR_CID 0x41
+#define CTRL_CID 0x40
+#define HEADER_SIZE 6  // 보고서마다 붙는 머리 (cid, len, 기기, 종류)
+
+static int errors = 0;
+
+#define CHECK(cond, ...)                 \
+    do {                                 \
+        if (!(cond)) {                   \
+            printf(__VA_ARGS__);         \
+            printf("\n");                \
+            errors++;                    \
+        }                                \
+    } while (0)
+
+static uint8_t put(int dev, uint16_t cid, uni_report_kind_t kind, uint8_t tag, uint16_t len) {
+    uint8_t data[UNI_REPORT_QUEUE_DEVICE_MAX_SIZE];
+    memset(data, tag, sizeof(data));
+    return uni_report_queue_put(dev, cid, kind, data, len);
+}
+
+// 가장 오래된 보고서를 꺼내 첫 바이트 (tag) 를 돌려준다. 비어 있으면 -1
+static int pop(int dev, uint16_t* cid) {
+    const uint8_t* data;
+    uint16_t len;
+    uint16_t c;
+    if (!uni_report_queue_peek(dev, &c, &data, &len)) {
+        return -1;
+    }
+    int tag = len > 0 ? data[0] : 0;
+    for (uint16_t i = 0; i < len; i++) {
+        if (data[i] != tag) {
+            printf("dev %d: report %d corrupted at byte %u\n", dev, tag, i);
+            errors++;
+            break;
+        }
+    }
+    uni_report_queue_pop(dev);
+    if (cid != NULL) *cid = c;
+    return tag;
+}
+
+static void expect_order(const char* name, int dev, const int* tags, int count) {
+    for (int i = 0; i < count; i++) {
+        int tag = pop(dev, NULL);
+        CHECK(tag == tags[i], "%s: report %d is %d, expected %d", name, i, tag, tags[i]);
+    }
+    CHECK(uni_report_queue_is_empty(dev), "%s: queue not empty", name);
+}
+
+static void check_order(void) {
+    // 기기별 FIFO. 다른 기기의 보고서가 사이에 끼어도 순서는 기기마다 유지된다
+    put(0, INTR_CID, UNI_REPORT_KIND_NONE, 1, 10);
+    put(1, INTR_CID, UNI_REPORT_KIND_NONE, 2, 20);
+    put(0, CTRL_CID, UNI_REPORT_KIND_NONE, 3, 30);
+    put(1, INTR_CID, UNI_REPORT_KIND_NONE, 4, 1);
+    put(0, INTR_CID, UNI_REPORT_KIND_NONE, 5, 5);
+
+    uint16_t cid = 0;
+    CHECK(pop(0, &cid) == 1 && cid == INTR_CID, "order: dev 0 first report");
+    CHECK(pop(0, &cid) == 3 && cid == CTRL_CID, "order: dev 0 second report on the control channel");
+    expect_order("order dev 0", 0, (const int[]){5}, 1);
+    expect_order("order dev 1", 1, (const int[]){2, 4}, 2);
+    CHECK(uni_report_queue_is_empty(-1) && uni_report_queue_is_empty(CONFIG_BLUEPAD32_MAX_DEVICES),
+          "order: out of range devices are not empty");
+}
+
+static void check_supersede(void) {
+    // 새 진동 보고서는 대기 중인 진동을 지우고 맨 뒤에 붙는다 (사이에 들어온 명령 뒤에 보내야 한다)
+    put(0, INTR_CID, UNI_REPORT_KIND_RUMBLE, 1, 8);
+    put(0, INTR_CID, UNI_REPORT_KIND_NONE, 2, 8);
+    put(0, INTR_CID, UNI_REPORT_KIND_PLAYER_LEDS, 3, 8);
+    put(0, INTR_CID, UNI_REPORT_KIND_RUMBLE, 4, 8);
+    // 종류가 같아도 채널이 다르면 그대로 둔다
+    put(0, CTRL_CID, UNI_REPORT_KIND_RUMBLE, 5, 8);
+    // 다른 기기의 같은 종류도 그대로 둔다
+    put(1, INTR_CID, UNI_REPORT_KIND_RUMBLE, 6, 8);
+    put(0, INTR_CID, UNI_REPORT_KIND_PLAYER_LEDS, 7, 8);
+    // 명령은 교체되지 않는다
+    put(0, INTR_CID, UNI_REPORT_KIND_NONE, 8, 8);
+
+    expect_order("supersede dev 0", 0, (const int[]){2, 4, 5, 7, 8}, 5);
+    expect_order("supersede dev 1", 1, (const int[]){6}, 1);
+}
+
+static void check_limits(void) {
+    const uint16_t len = 200;
+    uint8_t big[UNI_REPORT_QUEUE_DEVICE_MAX_SIZE] = {0};
+
+    CHECK(uni_report_queue_put(0, INTR_CID, UNI_REPORT_KIND_NONE, big, UNI_REPORT_QUEUE_DEVICE_MAX_SIZE) ==
+              UNI_REPORT_QUEUE_ERROR_REPORT_TOO_BIG,
+          "limits: oversized report accepted");
+    CHECK(put(-1, INTR_CID, UNI_REPORT_KIND_NONE, 1, 1) != UNI_REPORT_QUEUE_ERROR_OK, "limits: device -1 accepted");
+
+    // 기기당 한도: 막힌 기기가 다른 기기 몫을 다 차지하지 못한다
+    int queued = 0;
+    while (put(0, INTR_CID, UNI_REPORT_KIND_NONE, (uint8_t)(10 + queued), len) == UNI_REPORT_QUEUE_ERROR_OK) {
+        queued++;
+    }
+    CHECK(queued > 0 && (queued + 1) * (len + HEADER_SIZE) > UNI_REPORT_QUEUE_DEVICE_MAX_SIZE &&
+              queued * (len + HEADER_SIZE) <= UNI_REPORT_QUEUE_DEVICE_MAX_SIZE,
+          "limits: device 0 queued %d reports of %u bytes", queued, len);
+    CHECK(put(1, INTR_CID, UNI_REPORT_KIND_NONE, 1, len) == UNI_REPORT_QUEUE_ERROR_OK,
+          "limits: device 1 blocked by device 0");
+
+    // 전체 한도: 모든 기기가 한도까지 채우면 공용 영역이 먼저 찬다
+    int total = queued + 1;
+    for (int dev = 1; dev < CONFIG_BLUEPAD32_MAX_DEVICES; dev++) {
+        while (put(dev, INTR_CID, UNI_REPORT_KIND_NONE, 2, len) == UNI_REPORT_QUEUE_ERROR_OK) {
+            total++;
+        }
+    }
+    CHECK(total * (len + HEADER_SIZE) <= UNI_REPORT_QUEUE_ARENA_SIZE &&
+              (total + 1) * (len + HEADER_SIZE) > UNI_REPORT_QUEUE_ARENA_SIZE,
+          "limits: %d reports of %u bytes in a %u byte arena", total, len, UNI_REPORT_QUEUE_ARENA_SIZE);
+
+    // 한 기기를 비우면 그 자리를 다시 쓸 수 있고, 남은 기기의 보고서는 그대로다
+    uni_report_queue_reset(0);
+    CHECK(uni_report_queue_is_empty(0), "limits: reset left reports");
+    CHECK(put(0, INTR_CID, UNI_REPORT_KIND_NONE, 9, len) == UNI_REPORT_QUEUE_ERROR_OK, "limits: no room after reset");
+    CHECK(pop(1, NULL) == 1, "limits: device 1 lost its first report");
+    for (int dev = 0; dev < CONFIG_BLUEPAD32_MAX_DEVICES; dev++) {
+        uni_report_queue_reset(dev);
+        CHECK(uni_report_queue_is_empty(dev), "limits: device %d not empty after reset", dev);
+    }
+}
+
+// 10ms 마다 진동 갱신, 링크는 23ms 마다 보고서 하나만 보낼 수 있다.
+// 진동은 최신 값 하나만 남으므로 대기열이 쌓이지 않고, 보내는 값은 항상 그 시점의 최신 값이다
+static void check_rumble_contention(void) {
+    int newest = -1;
+    int sent = 0;
+    int worst_age_ms = 0;
+    int put_ms[256];
+
+    for (int t = 0; t < 2000; t++) {
+        if (t % 10 == 0) {
+            newest = (t / 10) & 0xFF;
+            put_ms[newest] = t;
+            CHECK(put(0, INTR_CID, UNI_REPORT_KIND_RUMBLE, (uint8_t)newest, 12) == UNI_REPORT_QUEUE_ERROR_OK,
+                  "contention: rumble %d dropped", newest);
+        }
+        if (t % 23 == 0) {
+            int tag = pop(0, NULL);
+            if (tag < 0) continue;
+            CHECK(tag == newest, "contention: sent rumble %d at %d ms, newest is %d", tag, t, newest);
+            CHECK(uni_report_queue_is_empty(0), "contention: more than one rumble queued");
+            if (t - put_ms[tag] > worst_age_ms) worst_age_ms = t - put_ms[tag];
+            sent++;
+        }
+    }
+    CHECK(worst_age_ms < 23, "contention: a sent rumble was %d ms old", worst_age_ms);
+    printf("contention: %d rumbles sent, oldest %d ms\n", sent, worst_age_ms);
+    uni_report_queue_reset(0);
+}
+
+int main(void) {
+    check_order();
+    check_supersede();
+    check_limits();
+    check_rumble_contention();
+
+    printf("%d errors\n", errors);
+    return errors ? 1 : 0;
+}
@@ -0,0 +1,135 @@
+// rc_tank_snapshot 스트레스 테스트.
+// writer 스레드가 게시 번호 n 에서 모든 필드를 만들어 게시하고, reader 스레드들은
+// 읽은 값이 한 번의 게시에서 온 것인지 (찢어진 읽기 없음), 반환된 게시 횟수와
+// 값이 일치하는지, 게시 횟수가 줄지 않는지 확인한다.
+
+#include <pthread.h>
+#include <stdatomic.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "rc_tank_snapshot.h"
+
+#define PUBLISH_COUNT 2000000u
+#define READER_COUNT 3
+
+static rc_tank_input_snapshot_t snap;
+static atomic_bool writer_done;
+
+static void make_input(uint32_t n, rc_tank_input_t* input) {
+    input->axis_y = (int16_t)(n & 0xFFFF);
+    input->axis_ry = (int16_t)(n >> 16);
+    input->axis_x = (int16_t)(n * 3u);
+    input->axis_rx = (int16_t)(n ^ 0x5A5Au);
+    input->throttle = (int16_t)(n >> 3);
+    input->brake = (int16_t)~n;
+    input->dpad_x = (int8_t)(n % 3) - 1;
+    input->dpad_y = (int8_t)((n / 3) % 3) - 1;
+    input->link = (int8_t)(n & 0x7F);
+    input->active = (n & 1) != 0;
+}
+
+static uint32_t input_number(const rc_tank_input_t* input) {
+    return (uint16_t)input->axis_y | ((uint32_t)(uint16_t)input->axis_ry << 16);
+}
+
+static bool input_equal(const rc_tank_input_t* a, const rc_tank_input_t* b) {
+    return a->axis_y == b->axis_y && a->axis_ry == b->axis_ry && a->axis_x == b->axis_x &&
+           a->axis_rx == b->axis_rx && a->throttle == b->throttle && a->brake == b->brake &&
+           a->dpad_x == b->dpad_x && a->dpad_y == b->dpad_y && a->link == b->link && a->active == b->active;
+}
+
+static void* writer_main(void* arg) {
+    rc_tank_input_t input;
+    for (uint32_t n = 1; n <= PUBLISH_COUNT; n++) {
+        make_input(n, &input);
+        rc_tank_input_snapshot_publish(&snap, &input);
+    }
+    atomic_store(&writer_done, true);
+    return NULL;
+}
+
+typedef struct {
+    unsigned long reads;
+    unsigned long errors;
+} reader_result_t;
+
+static void* reader_main(void* arg) {
+    reader_result_t* result = arg;
+    uint32_t last = 0;
+    rc_tank_input_t input, expected;
+
+    while (!atomic_load(&writer_done)) {
+        uint32_t seq = rc_tank_input_snapshot_read(&snap, &input);
+        uint32_t n = input_number(&input);
+        result->reads++;
+
+        if (seq == 0) {
+            // 아직 게시 전: 초기화된 0 값
+            if (n != 0) result->errors++;
+            continue;
+        }
+        make_input(n, &expected);
+        if (n != seq || seq < last || !input_equal(&input, &expected)) {
+            if (result->errors++ < 5) {
+                fprintf(stderr, "torn read: seq %u, value %u, last %u\n", seq, n, last);
+            }
+        }
+        last = seq;
+    }
+    return NULL;
+}
+
+// writer 가 게시 도중 멈춘 상태 (seq 홀수) 에서도 reader 는 기다리지 않고 직전 값을 읽어야 한다.
+// 같은 코어에서 writer 를 선점한 높은 우선순위 태스크의 경우다.
+static int check_mid_publish(void) {
+    rc_tank_input_snapshot_t s;
+    rc_tank_input_t input, out;
+
+    rc_tank_input_snapshot_init(&s);
+    make_input(1, &input);
+    rc_tank_input_snapshot_publish(&s, &input);
+
+    // 두 번째 게시가 data[0] 을 쓰는 중
+    atomic_store(&s.seq, 3);
+    make_input(0xDEAD, &s.data[0]);
+
+    uint32_t seq = rc_tank_input_snapshot_read(&s, &out);
+    if (seq != 1 || !input_equal(&out, &input)) {
+        fprintf(stderr, "mid-publish read: seq %u, value %u\n", seq, input_number(&out));
+        return 1;
+    }
+    return 0;
+}
+
+int main(void) {
+    pthread_t writer, readers[READER_COUNT];
+    reader_result_t results[READER_COUNT] = {0};
+    unsigned long errors = 0;
+
+    if (check_mid_publish()) {
+        return 1;
+    }
+
+    rc_tank_input_snapshot_init(&snap);
+    for (int i = 0; i < READER_COUNT; i++) {
+        pthread_create(&readers[i], NULL, reader_main, &results[i]);
+    }
+    pthread_create(&writer, NULL, writer_main, NULL);
+
+    pthread_join(writer, NULL);
+    for (int i = 0; i < READER_COUNT; i++) {
+        pthread_join(readers[i], NULL);
+        printf("reader %d: %lu reads, %lu errors\n", i, results[i].reads, results[i].errors);
+        errors += results[i].errors;
+    }
+
+    rc_tank_input_t out, expected;
+    uint32_t seq = rc_tank_input_snapshot_read(&snap, &out);
+    make_input(PUBLISH_COUNT, &expected);
+    if (seq != PUBLISH_COUNT || !input_equal(&out, &expected)) {
+        fprintf(stderr, "final read: seq %u, value %u\n", seq, input_number(&out));
+        errors++;
+    }
+    return errors ? 1 : 0;
+}
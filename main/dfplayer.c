@@ -1,7 +1,12 @@
 #include "dfplayer.h"
+#include "dfplayer_parser.h"
 #include "rc_tank.h"
+#include "rc_tank_boot.h"
 #include "driver/uart.h"
 #include "esp_log.h"
+#include "esp_timer.h"
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
 #include <string.h>
 
 static const char* TAG = "DFPLAYER";
@@ -25,44 +30,306 @@ typedef struct {
     uint8_t end_byte;      // 0xEF
 } dfplayer_packet_t;
 
-// 체크섬 계산
-static uint16_t calculate_checksum(uint8_t* data, uint8_t length) {
-    uint16_t sum = 0;
-    for (int i = 0; i < length; i++) {
-        sum += data[i];
+// 병합 가능한 명령 종류. 같은 종류의 대기 명령은 최신 명령으로 교체된다.
+typedef enum {
+    CMD_CLASS_NONE = 0,  // 병합하지 않음
+    CMD_CLASS_PLAYBACK,  // 재생/일시정지 (마지막 요청만 의미 있음)
+    CMD_CLASS_VOLUME,
+    CMD_CLASS_EQ,
+    CMD_CLASS_MODE,
+    CMD_CLASS_MAX
+} cmd_class_t;
+
+typedef struct {
+    uint8_t command;
+    uint8_t cmd_class;
+    uint16_t parameter;
+} dfplayer_cmd_t;
+
+// 명령 링 (cmd_mux 로 보호)
+static dfplayer_cmd_t cmd_ring[DFPLAYER_CMD_RING_SIZE];
+static uint32_t ring_head = 0;  // 다음에 보낼 위치
+static uint32_t ring_tail = 0;  // 다음에 넣을 위치
+static int32_t pending_slot[CMD_CLASS_MAX] = {[0 ... CMD_CLASS_MAX - 1] = -1};  // 종류별 대기 중인 링 위치 (-1: 없음)
+static portMUX_TYPE cmd_mux = portMUX_INITIALIZER_UNLOCKED;
+
+static TaskHandle_t dfplayer_task_handle = NULL;
+static volatile bool player_online = false;
+static volatile bool player_playing = false;
+static dfplayer_stats_t player_stats = {0};  // 여러 태스크가 쓰는 카운터와 스냅샷 복사는 cmd_mux 로 보호
+static dfplayer_parser_t rx_parser;
+
+// 효과음 우선순위. 재생 중인 효과음보다 우선순위가 낮은 요청은 무시된다.
+// max_ms: 종료 응답이 오지 않을 때 재생이 끝난 것으로 보는 시간 (0: 계속 재생)
+typedef struct {
+    uint8_t priority;
+    uint16_t max_ms;
+} sound_info_t;
+
+static const sound_info_t sound_info[] = {
+    [SOUND_IDLE] = {DFPLAYER_PRIORITY_IDLE, 0},
+    [SOUND_CANNON_FIRE] = {DFPLAYER_PRIORITY_CANNON, 3000},
+    [SOUND_MACHINE_GUN] = {DFPLAYER_PRIORITY_MACHINE_GUN, 4000},
+    [SOUND_CONNECT] = {DFPLAYER_PRIORITY_SYSTEM, 3000},
+};
+static const sound_info_t sound_info_default = {DFPLAYER_PRIORITY_MACHINE_GUN, 3000};
+
+// 현재 재생 중인 효과음 (sound_mux 로 보호)
+static uint8_t current_sound = 0;  // 0: 없음
+static int64_t current_expire_us = 0;
+static portMUX_TYPE sound_mux = portMUX_INITIALIZER_UNLOCKED;
+
+static cmd_class_t command_class(uint8_t command) {
+    switch (command) {
+        case DFPLAYER_CMD_PLAY_NEXT:
+        case DFPLAYER_CMD_PLAY_PREV:
+        case DFPLAYER_CMD_PLAY_FILE:
+        case DFPLAYER_CMD_PLAY:
+        case DFPLAYER_CMD_PAUSE:
+        case DFPLAYER_CMD_PLAY_FOLDER:
+        case DFPLAYER_CMD_REPEAT_PLAY:
+            return CMD_CLASS_PLAYBACK;
+        case DFPLAYER_CMD_SET_VOLUME:
+            return CMD_CLASS_VOLUME;
+        case DFPLAYER_CMD_SET_EQ:
+            return CMD_CLASS_EQ;
+        case DFPLAYER_CMD_PLAY_MODE:
+            return CMD_CLASS_MODE;
+        default:
+            return CMD_CLASS_NONE;
     }
-    return -sum;
 }
 
-// DFPlayer에 명령 전송
+// DFPlayer에 명령 전송 (드라이버 태스크에서만 호출)
 static esp_err_t dfplayer_send_command(uint8_t command, uint16_t parameter) {
     dfplayer_packet_t packet;
     packet.start_byte = 0x7E;
     packet.version = 0xFF;
     packet.length = 0x06;
     packet.command = command;
-    packet.feedback = 0x00;
+    packet.feedback = 0x01;  // ACK 요청
     packet.param_msb = (parameter >> 8) & 0xFF;
     packet.param_lsb = parameter & 0xFF;
-    
-    uint16_t checksum = calculate_checksum((uint8_t*)&packet.version, 6);
+
+    uint16_t checksum = dfplayer_checksum((uint8_t*)&packet.version, 6);
     packet.checksum_msb = (checksum >> 8) & 0xFF;
     packet.checksum_lsb = checksum & 0xFF;
     packet.end_byte = 0xEF;
-    
+
     int written = uart_write_bytes(UART_NUM, &packet, sizeof(packet));
     if (written != sizeof(packet)) {
         ESP_LOGE(TAG, "DFPlayer command transmission failed");
         return ESP_FAIL;
     }
-    
+
     ESP_LOGD(TAG, "DFPlayer command sent: CMD=0x%02X, PARAM=0x%04X", command, parameter);
     return ESP_OK;
 }
 
+// 명령 링에 추가. 같은 종류의 대기 명령이 있으면 그 자리에서 교체한다. O(1)
+static bool enqueue_command(uint8_t command, uint16_t parameter) {
+    cmd_class_t cls = command_class(command);
+    bool ok = true;
+
+    portENTER_CRITICAL(&cmd_mux);
+    if (cls != CMD_CLASS_NONE && pending_slot[cls] >= 0) {
+        dfplayer_cmd_t* pending = &cmd_ring[pending_slot[cls] % DFPLAYER_CMD_RING_SIZE];
+        pending->command = command;
+        pending->parameter = parameter;
+        player_stats.merged++;
+    } else if (ring_tail - ring_head >= DFPLAYER_CMD_RING_SIZE) {
+        player_stats.dropped++;
+        ok = false;
+    } else {
+        if (cls != CMD_CLASS_NONE) {
+            pending_slot[cls] = (int32_t)ring_tail;
+        }
+        cmd_ring[ring_tail % DFPLAYER_CMD_RING_SIZE] = (dfplayer_cmd_t){
+            .command = command,
+            .cmd_class = cls,
+            .parameter = parameter,
+        };
+        ring_tail++;
+    }
+    portEXIT_CRITICAL(&cmd_mux);
+
+    if (!ok) {
+        ESP_LOGW(TAG, "DFPlayer command ring full, CMD=0x%02X dropped", command);
+        return false;
+    }
+    if (dfplayer_task_handle != NULL) {
+        xTaskNotifyGive(dfplayer_task_handle);
+    }
+    return true;
+}
+
+static bool dequeue_command(dfplayer_cmd_t* out) {
+    bool ok = false;
+
+    portENTER_CRITICAL(&cmd_mux);
+    if (ring_head != ring_tail) {
+        *out = cmd_ring[ring_head % DFPLAYER_CMD_RING_SIZE];
+        if (out->cmd_class != CMD_CLASS_NONE && pending_slot[out->cmd_class] == (int32_t)ring_head) {
+            pending_slot[out->cmd_class] = -1;
+        }
+        ring_head++;
+        ok = true;
+    }
+    portEXIT_CRITICAL(&cmd_mux);
+
+    return ok;
+}
+
+static const sound_info_t* get_sound_info(uint8_t file_number) {
+    // 표에 없는 파일은 기본 우선순위로 취급
+    if (file_number == SOUND_IDLE ||
+        (file_number < sizeof(sound_info) / sizeof(sound_info[0]) && sound_info[file_number].max_ms != 0)) {
+        return &sound_info[file_number];
+    }
+    return &sound_info_default;
+}
+
+static void set_current_sound(uint8_t file_number) {
+    const sound_info_t* info = get_sound_info(file_number);
+    int64_t now = esp_timer_get_time();
+
+    portENTER_CRITICAL(&sound_mux);
+    current_sound = file_number;
+    current_expire_us = info->max_ms ? now + info->max_ms * 1000LL : 0;
+    portEXIT_CRITICAL(&sound_mux);
+}
+
+static void clear_current_sound(uint8_t file_number) {
+    portENTER_CRITICAL(&sound_mux);
+    if (file_number == 0 || file_number == current_sound) {
+        current_sound = 0;
+    }
+    portEXIT_CRITICAL(&sound_mux);
+}
+
+// 보낸 명령으로 재생 상태 추정 (피드백으로 보정됨)
+static void update_state_on_send(uint8_t command) {
+    switch (command) {
+        case DFPLAYER_CMD_PLAY_NEXT:
+        case DFPLAYER_CMD_PLAY_PREV:
+        case DFPLAYER_CMD_PLAY_FILE:
+        case DFPLAYER_CMD_PLAY:
+        case DFPLAYER_CMD_PLAY_FOLDER:
+        case DFPLAYER_CMD_REPEAT_PLAY:
+            player_playing = true;
+            break;
+        case DFPLAYER_CMD_PAUSE:
+        case DFPLAYER_CMD_STANDBY:
+        case DFPLAYER_CMD_RESET:
+            player_playing = false;
+            break;
+        default:
+            break;
+    }
+}
+
+// 피드백 프레임 처리. ACK 이면 true
+static bool handle_feedback(uint8_t command, uint16_t parameter) {
+    switch (command) {
+        case DFPLAYER_RSP_ACK:
+            player_stats.acks++;
+            return true;
+        case DFPLAYER_RSP_ONLINE:
+            ESP_LOGI(TAG, "DFPlayer online: 0x%04X", parameter);
+            player_online = true;
+            break;
+        case DFPLAYER_RSP_USB_FINISHED:
+        case DFPLAYER_RSP_TF_FINISHED:
+        case DFPLAYER_RSP_FLASH_FINISHED:
+            ESP_LOGD(TAG, "DFPlayer track finished: %d", parameter);
+            player_playing = false;
+            clear_current_sound(parameter & 0xFF);
+            break;
+        case DFPLAYER_RSP_ERROR:
+            ESP_LOGW(TAG, "DFPlayer error: 0x%04X", parameter);
+            player_stats.errors++;
+            player_playing = false;
+            clear_current_sound(0);
+            break;
+        case DFPLAYER_RSP_STATUS:
+            // 하위 바이트: 0 정지, 1 재생, 2 일시정지
+            player_playing = (parameter & 0xFF) == 1;
+            break;
+        default:
+            ESP_LOGD(TAG, "DFPlayer feedback: CMD=0x%02X, PARAM=0x%04X", command, parameter);
+            break;
+    }
+    return false;
+}
+
+// UART 수신 바이트를 파서에 넣어 응답 프레임 처리. ACK 수신 여부 반환
+static bool read_feedback(void) {
+    uint8_t buf[32];
+    bool acked = false;
+    dfplayer_frame_t frame;
+
+    int len;
+    while ((len = uart_read_bytes(UART_NUM, buf, sizeof(buf), 0)) > 0) {
+        for (int i = 0; i < len; i++) {
+            if (dfplayer_parser_feed(&rx_parser, buf[i], &frame) && handle_feedback(frame.command, frame.parameter)) {
+                acked = true;
+            }
+        }
+    }
+    player_stats.bad_frames = rx_parser.bad_frames;
+    return acked;
+}
+
+static void dfplayer_task(void* arg) {
+    // DFPlayer 부팅 대기: 온라인 응답을 받거나 최대 대기 시간이 지날 때까지
+    int64_t boot_deadline = esp_timer_get_time() + DFPLAYER_BOOT_TIMEOUT_MS * 1000LL;
+    while (!player_online && esp_timer_get_time() < boot_deadline) {
+        vTaskDelay(pdMS_TO_TICKS(DFPLAYER_POLL_MS));
+        read_feedback();
+    }
+    if (!player_online) {
+        ESP_LOGW(TAG, "DFPlayer online frame not received, continuing");
+    }
+    rc_tank_boot_mark(RC_TANK_BOOT_DFPLAYER_ONLINE);
+
+    int64_t next_send_us = 0;
+    bool waiting_ack = false;
+    int64_t ack_deadline_us = 0;
+
+    for (;;) {
+        if (read_feedback() && waiting_ack) {
+            // ACK 수신 후 최소 간격만 지키면 다음 명령 전송 가능
+            waiting_ack = false;
+        }
+
+        int64_t now = esp_timer_get_time();
+        if (waiting_ack && now >= ack_deadline_us) {
+            player_stats.ack_timeouts++;
+            waiting_ack = false;
+        }
+
+        dfplayer_cmd_t cmd;
+        if (!waiting_ack && now >= next_send_us && dequeue_command(&cmd)) {
+            if (dfplayer_send_command(cmd.command, cmd.parameter) == ESP_OK) {
+                update_state_on_send(cmd.command);
+                player_stats.sent++;
+                waiting_ack = true;
+                ack_deadline_us = now + DFPLAYER_ACK_TIMEOUT_MS * 1000LL;
+            }
+            next_send_us = now + DFPLAYER_MIN_CMD_GAP_MS * 1000LL;
+            continue;
+        }
+
+        // 새 명령 알림 또는 다음 수신 확인까지 대기
+        ulTaskNotifyTake(pdTRUE, pdMS_TO_TICKS(DFPLAYER_POLL_MS));
+    }
+}
+
 void dfplayer_init(void) {
     ESP_LOGI(TAG, "DFPlayer initialization started");
-    
+
+    dfplayer_parser_init(&rx_parser);
+
     // UART 설정
     uart_config_t uart_config = {
         .baud_rate = 9600,
@@ -72,73 +339,110 @@ void dfplayer_init(void) {
         .flow_ctrl = UART_HW_FLOWCTRL_DISABLE,
         .source_clk = UART_SCLK_APB,
     };
-    
+
     esp_err_t ret = uart_driver_install(UART_NUM, BUF_SIZE * 2, 0, 0, NULL, 0);
     if (ret != ESP_OK) {
         ESP_LOGE(TAG, "UART driver installation failed: %s", esp_err_to_name(ret));
         return;
     }
-    
+
     ret = uart_param_config(UART_NUM, &uart_config);
     if (ret != ESP_OK) {
         ESP_LOGE(TAG, "UART parameter configuration failed: %s", esp_err_to_name(ret));
         return;
     }
-    
+
     ret = uart_set_pin(UART_NUM, DFPLAYER_TX_PIN, DFPLAYER_RX_PIN, UART_PIN_NO_CHANGE, UART_PIN_NO_CHANGE);
     if (ret != ESP_OK) {
         ESP_LOGE(TAG, "UART pin configuration failed: %s", esp_err_to_name(ret));
         return;
     }
-    
-    // DFPlayer 초기화 명령
-    vTaskDelay(pdMS_TO_TICKS(1000));  // DFPlayer 부팅 대기
-    
+
+    // 초기화 명령은 링에 넣어두고, 드라이버 태스크가 부팅 대기 후 순서대로 보낸다
     // 볼륨 설정 (20/30)
-    dfplayer_set_volume(20);
-    vTaskDelay(pdMS_TO_TICKS(100));
-    
+    dfplayer_set_volume(DFPLAYER_DEFAULT_VOLUME);
+
     // EQ 설정 (Normal)
-    dfplayer_send_command(DFPLAYER_CMD_SET_EQ, 0);
-    vTaskDelay(pdMS_TO_TICKS(100));
-    
+    enqueue_command(DFPLAYER_CMD_SET_EQ, 0);
+
     // 재생 모드 설정 (Repeat all)
-    dfplayer_send_command(DFPLAYER_CMD_PLAY_MODE, 0);
-    vTaskDelay(pdMS_TO_TICKS(100));
-    
+    enqueue_command(DFPLAYER_CMD_PLAY_MODE, 0);
+
     // 대기 효과음 재생 시작
     dfplayer_play_file(SOUND_IDLE);
-    
+
+    if (xTaskCreate(dfplayer_task, "dfplayer", DFPLAYER_TASK_STACK, NULL, DFPLAYER_TASK_PRIORITY,
+                    &dfplayer_task_handle) != pdPASS) {
+        ESP_LOGE(TAG, "DFPlayer task creation failed");
+        return;
+    }
+
     ESP_LOGI(TAG, "DFPlayer initialization completed");
 }
 
 void dfplayer_play_file(uint8_t file_number) {
     ESP_LOGI(TAG, "DFPlayer playing file: %d", file_number);
-    dfplayer_send_command(DFPLAYER_CMD_PLAY_FILE, file_number);
+    set_current_sound(file_number);
+    enqueue_command(DFPLAYER_CMD_PLAY_FILE, file_number);
+}
+
+bool dfplayer_play_sound(uint8_t file_number) {
+    const sound_info_t* info = get_sound_info(file_number);
+    int64_t now = esp_timer_get_time();
+    bool allowed;
+
+    portENTER_CRITICAL(&sound_mux);
+    bool current_active = current_sound != 0 && (current_expire_us == 0 || now < current_expire_us);
+    allowed = !current_active || info->priority >= get_sound_info(current_sound)->priority;
+    portEXIT_CRITICAL(&sound_mux);
+
+    if (!allowed) {
+        ESP_LOGD(TAG, "DFPlayer sound %d rejected, %d is playing", file_number, current_sound);
+        // 여러 태스크에서 호출되므로 다른 카운터와 같은 cmd_mux 아래에서 증가
+        portENTER_CRITICAL(&cmd_mux);
+        player_stats.rejected++;
+        portEXIT_CRITICAL(&cmd_mux);
+        return false;
+    }
+
+    dfplayer_play_file(file_number);
+    return true;
 }
 
 void dfplayer_set_volume(uint8_t volume) {
     if (volume > 30) volume = 30;
     ESP_LOGI(TAG, "DFPlayer volume set: %d", volume);
-    dfplayer_send_command(DFPLAYER_CMD_SET_VOLUME, volume);
+    enqueue_command(DFPLAYER_CMD_SET_VOLUME, volume);
 }
 
 void dfplayer_pause(void) {
     ESP_LOGI(TAG, "DFPlayer paused");
-    dfplayer_send_command(DFPLAYER_CMD_PAUSE, 0);
+    clear_current_sound(0);
+    enqueue_command(DFPLAYER_CMD_PAUSE, 0);
 }
 
 void dfplayer_resume(void) {
     ESP_LOGI(TAG, "DFPlayer resumed");
-    dfplayer_send_command(DFPLAYER_CMD_PLAY, 0);
+    enqueue_command(DFPLAYER_CMD_PLAY, 0);
 }
 
 void dfplayer_stop(void) {
     ESP_LOGI(TAG, "DFPlayer stopped");
-    dfplayer_send_command(DFPLAYER_CMD_PAUSE, 0);
+    clear_current_sound(0);
+    enqueue_command(DFPLAYER_CMD_PAUSE, 0);
+}
+
+void dfplayer_query_status(void) {
+    enqueue_command(DFPLAYER_CMD_QUERY_STATUS, 0);
 }
 
 bool dfplayer_is_playing(void) {
-    // 간단한 구현 - 실제로는 DFPlayer로부터 상태를 읽어와야 함
-    return true;
+    // 보낸 명령과 DFPlayer 피드백 (트랙 종료, 에러, 상태 응답)으로 추적한 상태
+    return player_playing;
+}
+
+void dfplayer_get_stats(dfplayer_stats_t* stats) {
+    portENTER_CRITICAL(&cmd_mux);
+    *stats = player_stats;
+    portEXIT_CRITICAL(&cmd_mux);
 }
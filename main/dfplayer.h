@@ -22,6 +22,25 @@
 #define DFPLAYER_CMD_PLAY_FOLDER    0x0F
 #define DFPLAYER_CMD_VOLUME_ADJUST  0x10
 #define DFPLAYER_CMD_REPEAT_PLAY    0x11
+#define DFPLAYER_CMD_QUERY_STATUS   0x42
+
+// DFPlayer 응답 (피드백)
+#define DFPLAYER_RSP_USB_FINISHED   0x3C
+#define DFPLAYER_RSP_TF_FINISHED    0x3D
+#define DFPLAYER_RSP_FLASH_FINISHED 0x3E
+#define DFPLAYER_RSP_ONLINE         0x3F
+#define DFPLAYER_RSP_ERROR          0x40
+#define DFPLAYER_RSP_ACK            0x41
+#define DFPLAYER_RSP_STATUS         0x42
+
+// 드라이버 태스크 설정
+#define DFPLAYER_TASK_STACK         3072
+#define DFPLAYER_TASK_PRIORITY      3
+#define DFPLAYER_CMD_RING_SIZE      16
+#define DFPLAYER_BOOT_TIMEOUT_MS    1500  // 온라인 응답 최대 대기
+#define DFPLAYER_MIN_CMD_GAP_MS     30    // 명령 사이 최소 간격
+#define DFPLAYER_ACK_TIMEOUT_MS     100
+#define DFPLAYER_POLL_MS            20    // 수신 확인 주기
 
 // 효과음 파일 번호
 #define SOUND_IDLE          1   // 대기 시 반복 재생
@@ -29,13 +48,40 @@
 #define SOUND_MACHINE_GUN   3   // 기관총 발사 시 재생
 #define SOUND_CONNECT       4   // 게임 패드 연결 시 재생
 
+// 효과음 우선순위 (높을수록 우선). 같거나 높은 우선순위만 재생 중인 효과음을 끊을 수 있다.
+#define DFPLAYER_PRIORITY_IDLE         0
+#define DFPLAYER_PRIORITY_MACHINE_GUN  1
+#define DFPLAYER_PRIORITY_CANNON       2
+#define DFPLAYER_PRIORITY_SYSTEM       3   // 연결 효과음 등
+
+// 기본 볼륨 (0 ~ 30)
+#define DFPLAYER_DEFAULT_VOLUME 20
+
+// 드라이버 통계
+typedef struct {
+    uint32_t sent;
+    uint32_t merged;        // 대기 중인 명령과 병합됨
+    uint32_t dropped;       // 링이 가득 차서 버림
+    uint32_t acks;
+    uint32_t ack_timeouts;
+    uint32_t errors;
+    uint32_t bad_frames;
+    uint32_t rejected;      // 우선순위에 밀려 재생하지 않은 효과음
+} dfplayer_stats_t;
+
 // 함수 선언
+// 모든 명령은 링에 넣고 바로 반환한다. 전송은 드라이버 태스크가 한다.
 void dfplayer_init(void);
+// 우선순위와 관계없이 바로 재생
 void dfplayer_play_file(uint8_t file_number);
+// 재생 중인 효과음보다 우선순위가 낮으면 무시하고 false 반환
+bool dfplayer_play_sound(uint8_t file_number);
 void dfplayer_set_volume(uint8_t volume);
 void dfplayer_pause(void);
 void dfplayer_resume(void);
 void dfplayer_stop(void);
+void dfplayer_query_status(void);
 bool dfplayer_is_playing(void);
+void dfplayer_get_stats(dfplayer_stats_t* stats);
 
 #endif // DFPLAYER_H
@@ -0,0 +1,71 @@
+#include "dfplayer_parser.h"
+#include <string.h>
+
+// 체크섬 계산 (version ~ param_lsb 6바이트 합의 2의 보수)
+uint16_t dfplayer_checksum(const uint8_t* data, uint8_t length) {
+    uint16_t sum = 0;
+    for (int i = 0; i < length; i++) {
+        sum += data[i];
+    }
+    return -sum;
+}
+
+void dfplayer_parser_init(dfplayer_parser_t* parser) {
+    memset(parser, 0, sizeof(*parser));
+}
+
+// 버퍼 안에서 다음 시작 바이트를 찾아 앞으로 당긴다 (재동기화)
+static void resync(dfplayer_parser_t* parser) {
+    uint8_t i;
+    for (i = 1; i < parser->len; i++) {
+        if (parser->buf[i] == DFPLAYER_FRAME_START) {
+            break;
+        }
+    }
+    parser->skipped += i;
+    parser->len -= i;
+    memmove(parser->buf, &parser->buf[i], parser->len);
+}
+
+// 헤더 (시작/버전/길이) 중 이미 받은 부분이 올바른지 확인
+static bool header_valid(const dfplayer_parser_t* parser) {
+    if (parser->len > 1 && parser->buf[1] != DFPLAYER_FRAME_VERSION) return false;
+    if (parser->len > 2 && parser->buf[2] != DFPLAYER_FRAME_LENGTH) return false;
+    return true;
+}
+
+bool dfplayer_parser_feed(dfplayer_parser_t* parser, uint8_t byte, dfplayer_frame_t* out) {
+    if (parser->len == 0 && byte != DFPLAYER_FRAME_START) {
+        parser->skipped++;
+        return false;
+    }
+
+    parser->buf[parser->len++] = byte;
+
+    // 헤더가 어긋나면 버퍼 안의 다음 시작 바이트부터 다시 맞춘다
+    while (parser->len > 0 && !header_valid(parser)) {
+        resync(parser);
+    }
+
+    if (parser->len < DFPLAYER_FRAME_SIZE) {
+        return false;
+    }
+
+    const uint8_t* b = parser->buf;
+    uint16_t checksum = dfplayer_checksum(&b[1], 6);
+    if (b[9] != DFPLAYER_FRAME_END || b[7] != (checksum >> 8) || b[8] != (checksum & 0xFF)) {
+        parser->bad_frames++;
+        resync(parser);
+        while (parser->len > 0 && !header_valid(parser)) {
+            resync(parser);
+        }
+        return false;
+    }
+
+    out->command = b[3];
+    out->feedback = b[4];
+    out->parameter = (uint16_t)((b[5] << 8) | b[6]);
+    parser->frames++;
+    parser->len = 0;
+    return true;
+}
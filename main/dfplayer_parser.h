@@ -0,0 +1,36 @@
+#ifndef DFPLAYER_PARSER_H
+#define DFPLAYER_PARSER_H
+
+#include <stdint.h>
+#include <stdbool.h>
+
+// DFPlayer 프레임: 7E FF 06 CMD FB PH PL CH CL EF
+#define DFPLAYER_FRAME_SIZE    10
+#define DFPLAYER_FRAME_START   0x7E
+#define DFPLAYER_FRAME_VERSION 0xFF
+#define DFPLAYER_FRAME_LENGTH  0x06
+#define DFPLAYER_FRAME_END     0xEF
+
+// 수신 프레임
+typedef struct {
+    uint8_t command;
+    uint8_t feedback;
+    uint16_t parameter;
+} dfplayer_frame_t;
+
+// 스트리밍 파서 상태. UART 에서 읽은 바이트를 조각 단위로 넣어도 된다.
+typedef struct {
+    uint8_t buf[DFPLAYER_FRAME_SIZE];
+    uint8_t len;
+    uint32_t frames;
+    uint32_t bad_frames;   // 체크섬/종료 바이트 오류
+    uint32_t skipped;      // 동기화 중 버린 바이트
+} dfplayer_parser_t;
+
+// 함수 선언
+uint16_t dfplayer_checksum(const uint8_t* data, uint8_t length);
+void dfplayer_parser_init(dfplayer_parser_t* parser);
+// 한 바이트 입력. 올바른 프레임이 완성되면 out 을 채우고 true 반환
+bool dfplayer_parser_feed(dfplayer_parser_t* parser, uint8_t byte, dfplayer_frame_t* out);
+
+#endif // DFPLAYER_PARSER_H
@@ -12,6 +12,8 @@
 
 #include "sdkconfig.h"
 
+#include "rc_tank_boot.h"
+
 // Sanity check
 #ifndef CONFIG_BLUEPAD32_PLATFORM_CUSTOM
 #error "Must use BLUEPAD32_PLATFORM_CUSTOM"
@@ -31,14 +33,19 @@ int app_main(void) {
 #endif  // CONFIG_BLUEPAD32_USB_CONSOLE_ENABLE
 #endif  // CONFIG_ESP_CONSOLE_UART
 
+    // NVS init, then actuators and DFPlayer come up in a boot task while Bluetooth starts.
+    rc_tank_boot_start();
+
     // Configure BTstack for ESP32 VHCI Controller
     btstack_init();
+    rc_tank_boot_mark(RC_TANK_BOOT_BTSTACK);
 
     // Must be called before uni_init()
     uni_platform_set_custom(get_my_platform());
 
     // Init Bluepad32.
     uni_init(0 /* argc */, NULL /* argv */);
+    rc_tank_boot_mark(RC_TANK_BOOT_UNI_INIT);
 
     // Does not return.
     btstack_run_loop_execute();
@@ -5,20 +5,51 @@
 
 #include <uni.h>
 #include "rc_tank.h"
+#include "rc_tank_bench.h"
+#include "rc_tank_bindings.h"
+#include "rc_tank_boot.h"
+#include "rc_tank_crew.h"
+#include "rc_tank_drive.h"
+#include "rc_tank_effects.h"
+#include "rc_tank_failsafe.h"
+#include "rc_tank_haptics.h"
+#include "rc_tank_loop.h"
+#include "rc_tank_power.h"
+#include "rc_tank_record.h"
+#include "rc_tank_servo.h"
+#include "rc_tank_settings.h"
+#include "rc_tank_turret.h"
 #include "dfplayer.h"
-#include "driver/gpio.h"
 #include "esp_timer.h"
-#include "freertos/FreeRTOS.h"
-#include "freertos/task.h"
+
+// 좌석 표시 자리에 배터리 잔량을 잠깐 보여 주는 시간 (라이트바와 플레이어 LED 가 모두 있으면 라이트바에 계속 표시)
+#define BATTERY_FLASH_MS 2000
 
 // Custom "instance"
 typedef struct my_platform_instance_s {
     uni_gamepad_seat_t gamepad_seat;  // which "seat" is being used
+    int8_t battery_level;             // 컨트롤러에 마지막으로 표시한 배터리 잔량 단계
+    int64_t battery_flash_until_us;   // 0 이 아니면 좌석 표시 대신 배터리 표시 중 (이 시각에 좌석 표시로 복귀)
 } my_platform_instance_t;
 
+// 승무원 좌석 (BT 스레드 전용). 인덱스는 rc_tank_seat_t, 좌석 A = 조종수, B = 포수
+static uni_hid_device_t* crew_seats[RC_TANK_CREW_SEATS];
+// 좌석별 마지막 보고 (같은 보고는 다시 처리하지 않는다)
+static uni_controller_t seat_prev[RC_TANK_CREW_SEATS];
+// 좌석 주기 타이머 (BT 스레드): 진동 출력 보고, HOLD 바인딩, 링크 RSSI, 좌석 표시 복귀
+static btstack_timer_source_t seat_timer;
+
 // Declarations
 static void trigger_event_on_gamepad(uni_hid_device_t* d);
+static void show_seat_on_gamepad(uni_hid_device_t* d);
+static void show_battery_on_gamepad(uni_hid_device_t* d);
+static void on_seat_timer(btstack_timer_source_t* ts);
 static my_platform_instance_t* get_my_platform_instance(uni_hid_device_t* d);
+static void on_tank_action(rc_tank_action_t action, int8_t arg, uint8_t seat);
+static int get_crew_seat(uni_hid_device_t* d);
+static void take_crew_seat(int seat, uni_hid_device_t* d);
+static void vacate_crew_seat(int seat);
+static bool reports_on_change(const uni_hid_device_t* d);
 
 //
 // Platform Overrides
@@ -28,12 +59,12 @@ static void my_platform_init(int argc, const char** argv) {
     ARG_UNUSED(argv);
 
     logi("custom: init()\n");
-    
-    // RC Tank 초기화
-    rc_tank_init();
-    
-    // DFPlayer 초기화
-    dfplayer_init();
+
+    // 버튼 바인딩 (NVS 는 app_main 에서 이미 초기화됨)
+    rc_tank_bindings_init(on_tank_action);
+
+    // 액추에이터/DFPlayer/설정/제어 루프는 app_main 에서 시작한 부팅 태스크가
+    // 블루투스 초기화와 동시에 초기화한다 (rc_tank_boot.c)
 
 #if 0
     uni_gamepad_mappings_t mappings = GAMEPAD_DEFAULT_MAPPINGS;
@@ -63,6 +94,14 @@ static void my_platform_on_init_complete(void) {
     uni_bt_start_scanning_and_autoconnect_unsafe();
     uni_bt_allow_incoming_connections(true);
 
+    // 변화 시에만 보고하는 컨트롤러는 연결 해제로 끊김을 판정하므로 BR/EDR 링크 감시 시간을 줄인다
+    gap_set_link_supervision_timeout(RC_TANK_FAILSAFE_SUPERVISION_MS * 8 / 5);  // 0.625 ms 단위
+
+    // 진동 출력 보고 등은 BT 스레드 타이머에서 좌석마다 처리한다
+    seat_timer.process = &on_seat_timer;
+    btstack_run_loop_set_timer(&seat_timer, RC_TANK_HAPTICS_MIN_INTERVAL_MS);
+    btstack_run_loop_add_timer(&seat_timer);
+
     // Based on runtime condition, you can delete or list the stored BT keys.
     if (1)
         uni_bt_del_keys_unsafe();
@@ -93,56 +132,195 @@ static void my_platform_on_device_connected(uni_hid_device_t* d) {
 
 static void my_platform_on_device_disconnected(uni_hid_device_t* d) {
     logi("custom: device disconnected: %p\n", d);
-    
-    // 게임패드 연결 해제 시 대기 효과음 재생
-    rc_tank.is_connected = false;
-    rc_tank_stop();  // 모터 정지
-    dfplayer_play_file(SOUND_IDLE);
+    rc_tank_failsafe_on_disconnect(uni_hid_device_get_idx_for_instance(d));
+
+    // 좌석 없이 끊긴 장치 (준비 전이거나 좌석이 없어 거절됨) 는 다른 승무원에 영향을 주지 않는다
+    int seat = get_crew_seat(d);
+    if (seat < 0) {
+        return;
+    }
+
+    // 이 좌석의 입력만 멈추고, 남은 승무원이 그 역할을 이어받는다
+    vacate_crew_seat(seat);
+    rc_tank.is_connected = crew_seats[RC_TANK_SEAT_DRIVER] != NULL || crew_seats[RC_TANK_SEAT_GUNNER] != NULL;
+
+    // 마지막 게임패드 연결 해제 시 대기 효과음 재생
+    if (!rc_tank.is_connected) {
+        rc_tank_effects_cancel_all();
+        dfplayer_play_file(SOUND_IDLE);
+    }
+
+    // 변경된 설정이 있으면 바로 저장
+    rc_tank_settings_flush();
 }
 
 static uni_error_t my_platform_on_device_ready(uni_hid_device_t* d) {
     logi("custom: device ready: %p\n", d);
     my_platform_instance_t* ins = get_my_platform_instance(d);
-    ins->gamepad_seat = GAMEPAD_SEAT_A;
+
+    // 빈 좌석 중 앞 좌석 (조종수 먼저). 두 좌석이 모두 차 있으면 거절
+    int seat = crew_seats[RC_TANK_SEAT_DRIVER] == NULL ? RC_TANK_SEAT_DRIVER
+               : crew_seats[RC_TANK_SEAT_GUNNER] == NULL ? RC_TANK_SEAT_GUNNER
+                                                         : -1;
+    if (seat < 0) {
+        logi("custom: crew seats are full, declining %p\n", d);
+        ins->gamepad_seat = GAMEPAD_SEAT_NONE;
+        return UNI_ERROR_NO_SLOTS;
+    }
+    take_crew_seat(seat, d);
+    ins->battery_level = -1;
+    ins->battery_flash_until_us = 0;
+    rc_tank_failsafe_on_connect(uni_hid_device_get_idx_for_instance(d), reports_on_change(d));
 
     // 게임패드 연결 시 효과음 재생
-    dfplayer_pause();  // 대기 효과음 중단
-    dfplayer_play_file(SOUND_CONNECT);
+    // 대기 효과음은 대기 중인 재생 명령과 병합되어 중단된다
+    dfplayer_play_sound(SOUND_CONNECT);
     
-    // RC Tank 연결 상태 설정
-    rc_tank.is_connected = true;
+    rc_tank_boot_mark(RC_TANK_BOOT_CONTROLLER);
 
     trigger_event_on_gamepad(d);
     return UNI_ERROR_SUCCESS;
 }
 
+// 입력이 바뀔 때만 보고하는 컨트롤러인지 (페일세이프가 보고 간격을 신선도로 쓰지 않는다).
+// 입력이 같아도 고정 주기로 보고하는 것으로 확인된 종류만 스트리밍으로 본다
+static bool reports_on_change(const uni_hid_device_t* d) {
+    switch (d->controller_type) {
+        case CONTROLLER_TYPE_PS3Controller:
+        case CONTROLLER_TYPE_PS4Controller:
+        case CONTROLLER_TYPE_PS5Controller:
+        case CONTROLLER_TYPE_SwitchProController:
+        case CONTROLLER_TYPE_SwitchJoyConLeft:
+        case CONTROLLER_TYPE_SwitchJoyConRight:
+        case CONTROLLER_TYPE_SwitchJoyConPair:
+            return false;
+        default:
+            return true;
+    }
+}
+
+// 동작을 맡는 역할. -1 이면 어느 좌석에서나 허용
+static int action_role(rc_tank_action_t action) {
+    switch (action) {
+        case RC_TANK_ACTION_CANNON_FIRE:
+        case RC_TANK_ACTION_MACHINE_GUN:
+            return RC_TANK_ROLE_WEAPONS;
+        case RC_TANK_ACTION_LEFT_SPEED_STEP:
+        case RC_TANK_ACTION_RIGHT_SPEED_STEP:
+        case RC_TANK_ACTION_DRIVE_MODE:
+            return RC_TANK_ROLE_TRACKS;
+        case RC_TANK_ACTION_TURRET_CENTER:
+            return RC_TANK_ROLE_TURRET;
+        default:
+            return -1;
+    }
+}
+
+// 재생 중에도 실행하는 동작: 효과와 터렛만.
+// 속도 배율/주행 모드는 설정에 저장되고 블루투스 검색은 BT 스레드 상태이므로 재생이 바꾸지 않는다
+static bool action_replays(rc_tank_action_t action) {
+    switch (action) {
+        case RC_TANK_ACTION_CANNON_FIRE:
+        case RC_TANK_ACTION_MACHINE_GUN:
+        case RC_TANK_ACTION_HEADLIGHT_TOGGLE:
+        case RC_TANK_ACTION_TURRET_CENTER:
+            return true;
+        default:
+            return false;
+    }
+}
+
+// 바인딩 표에서 발생한 동작 처리 (BT 스레드, 재생 중에는 tank_record 태스크)
+static void on_tank_action(rc_tank_action_t action, int8_t arg, uint8_t seat) {
+    static bool scanning = true;
+    float step = arg * 0.01f;
+
+    // 재생 중에는 기록된 버튼이 그대로 들어오므로 좌석 역할은 보지 않고, 재생할 동작만 받는다.
+    // 승무원이 둘이면 역할을 맡은 좌석의 버튼만 받는다 (혼자면 모든 역할을 맡는다)
+    if (rc_tank_record_mode() == RC_TANK_RECORD_REPLAYING) {
+        if (!action_replays(action)) {
+            return;
+        }
+    } else {
+        int role = action_role(action);
+        if (role >= 0 && rc_tank_crew_role_seat((rc_tank_role_t)role) != seat) {
+            return;
+        }
+    }
+
+    switch (action) {
+        case RC_TANK_ACTION_CANNON_FIRE:
+            // LED 깜빡임/효과음/포신 반동/진동은 효과 태스크에서 재생된다. 반동 진동은 승무원 모두에게
+            rc_tank_effects_trigger(RC_TANK_EFFECT_CANNON_FIRE, RC_TANK_HAPTICS_ALL_SEATS);
+            break;
+        case RC_TANK_ACTION_MACHINE_GUN:
+            rc_tank_effects_trigger(RC_TANK_EFFECT_MACHINE_GUN, 1u << seat);
+            break;
+        case RC_TANK_ACTION_HEADLIGHT_TOGGLE:
+            // 디바운싱은 효과 슬롯에서 처리
+            rc_tank_effects_trigger(RC_TANK_EFFECT_HEADLIGHT_TOGGLE, 0);
+            break;
+        case RC_TANK_ACTION_LEFT_SPEED_STEP:
+            rc_tank_settings_set_speed_multipliers(rc_tank.left_speed_multiplier + step,
+                                                   rc_tank.right_speed_multiplier);
+            break;
+        case RC_TANK_ACTION_RIGHT_SPEED_STEP:
+            rc_tank_settings_set_speed_multipliers(rc_tank.left_speed_multiplier,
+                                                   rc_tank.right_speed_multiplier + step);
+            break;
+        case RC_TANK_ACTION_SCAN_TOGGLE:
+            // Toggle Bluetooth connections
+            if (scanning) {
+                logi("*** Stop scanning\n");
+                uni_bt_stop_scanning_safe();
+            } else {
+                logi("*** Start scanning\n");
+                uni_bt_start_scanning_and_autoconnect_safe();
+            }
+            scanning = !scanning;
+            break;
+        case RC_TANK_ACTION_TURRET_CENTER:
+            rc_tank_turret_center();
+            break;
+        case RC_TANK_ACTION_DRIVE_MODE:
+            // 다음 모드로 순환 (곡선 표 재계산 후 다음 제어 틱부터 적용, 설정에 저장)
+            rc_tank_settings_set_drive_mode((rc_tank_drive_get_mode() + 1) % RC_TANK_DRIVE_MODE_MAX);
+            logi("*** Drive mode: %s\n", rc_tank_drive_mode_name(rc_tank_drive_get_mode()));
+            break;
+        default:
+            break;
+    }
+}
+
 static void my_platform_on_controller_data(uni_hid_device_t* d, uni_controller_t* ctl) {
-    static uint8_t leds = 0;
-    static uint8_t enabled = true;
-    static uni_controller_t prev = {0};
-    static bool cannon_firing = false;
-    static bool machine_gun_firing = false;
-    static uint32_t cannon_start_time = 0;
-    static uint32_t machine_gun_start_time = 0;
     uni_gamepad_t* gp;
 
+    // 입력 신선도 (내용이 같아도 보고가 왔다는 사실을 기록)
+    int link = uni_hid_device_get_idx_for_instance(d);
+    rc_tank_failsafe_on_report(link, esp_timer_get_time());
+
+    // 탱크 배터리 잔량이 바뀌면 컨트롤러 LED 로 표시
+    show_battery_on_gamepad(d);
+
+    int seat = get_crew_seat(d);
+    if (seat < 0) {
+        return;
+    }
+
     // Optimization to avoid processing the previous data so that the console
     // does not get spammed with a lot of logs, but remove it from your project.
-    if (memcmp(&prev, ctl, sizeof(*ctl)) == 0) {
+    // 좌석마다 비교하므로 두 컨트롤러가 번갈아 보고해도 중복만 걸러진다
+    if (memcmp(&seat_prev[seat], ctl, sizeof(*ctl)) == 0) {
         return;
     }
-    prev = *ctl;
+    seat_prev[seat] = *ctl;
 
     switch (ctl->klass) {
         case UNI_CONTROLLER_CLASS_GAMEPAD:
             gp = &ctl->gamepad;
 
-            // RC Tank 제어
-            if (rc_tank.is_connected) {
-                // 트랙 제어 (좌측 스틱 Y축, 우측 스틱 Y축)
-                float left_y = (float)gp->axis_y / 512.0f;   // -1.0 ~ 1.0
-                float right_y = (float)gp->axis_ry / 512.0f; // -1.0 ~ 1.0
-                
+            // RC Tank 제어 (부팅 태스크가 액추에이터 초기화를 끝낸 후부터)
+            if (rc_tank_boot_is_ready()) {
                 // D-PAD 제어
                 int dpad_x = 0, dpad_y = 0;
                 if (gp->dpad & DPAD_LEFT) dpad_x = -1;
@@ -150,109 +328,31 @@ static void my_platform_on_controller_data(uni_hid_device_t* d, uni_controller_t
                 if (gp->dpad & DPAD_UP) dpad_y = -1;
                 if (gp->dpad & DPAD_DOWN) dpad_y = 1;
                 
-                // RC Tank 제어
-                rc_tank_control_from_gamepad(left_y, right_y, dpad_x, dpad_y);
-                
-                // 포신 발사 (B 버튼) - A/B 버튼이 뒤바뀜
-                if ((gp->buttons & BUTTON_B) && !cannon_firing) {
-                    cannon_firing = true;
-                    cannon_start_time = esp_timer_get_time() / 1000; // ms
-                    
-                    // 포신 LED 깜빡임
-                    for (int i = 0; i < 5; i++) {
-                        gpio_set_level(CANNON_LED_PIN, 1);
-                        vTaskDelay(pdMS_TO_TICKS(50));
-                        gpio_set_level(CANNON_LED_PIN, 0);
-                        vTaskDelay(pdMS_TO_TICKS(50));
-                    }
-                    
-                    // 포신 효과음 재생
-                    dfplayer_play_file(SOUND_CANNON_FIRE);
-                    
-                    // 포신 서보 모터 제어 (당기기)
-                    rc_tank_set_cannon_angle(45);
-                    vTaskDelay(pdMS_TO_TICKS(500));
-                    rc_tank_set_cannon_angle(0);
-                }
-                
-                // 기관총 발사 (A 버튼) - A/B 버튼이 뒤바뀜
-                if ((gp->buttons & BUTTON_A) && !machine_gun_firing) {
-                    machine_gun_firing = true;
-                    machine_gun_start_time = esp_timer_get_time() / 1000; // ms
-                    
-                    // 기관총 효과음 재생
-                    dfplayer_play_file(SOUND_MACHINE_GUN);
-                }
+                // 좌석 입력 게시. 제어 루프가 역할별 담당 좌석 입력을 합쳐
+                // 트랙/터렛/마운트를 고정 주기로 구동한다
+                rc_tank_input_t input = {
+                    .axis_y = (int16_t)gp->axis_y,
+                    .axis_ry = (int16_t)gp->axis_ry,
+                    .axis_x = (int16_t)gp->axis_x,
+                    .axis_rx = (int16_t)gp->axis_rx,
+                    .throttle = (int16_t)gp->throttle,
+                    .brake = (int16_t)gp->brake,
+                    .dpad_x = (int8_t)dpad_x,
+                    .dpad_y = (int8_t)dpad_y,
+                    .link = (int8_t)link,
+                    .active = true,
+                };
+                rc_tank_crew_publish(seat, &input);
+                uni_latency_mark(UNI_LATENCY_STAGE_APP_INPUT);
                 
-                // 헤드라이트 토글 (R1 버튼)
-                if (gp->buttons & BUTTON_SHOULDER_R) {
-                    rc_tank_toggle_headlight();
-                    vTaskDelay(pdMS_TO_TICKS(200)); // 디바운싱
+                // 버튼 동작은 바인딩 표에서 처리 (효과/속도 조절/검색 토글).
+                // 재생 중에는 기록된 버튼만 처리한다
+                uint32_t state = RC_TANK_INPUT_STATE(gp->buttons, gp->misc_buttons, gp->dpad);
+                int64_t now = esp_timer_get_time();
+                if (rc_tank_record_mode() != RC_TANK_RECORD_REPLAYING) {
+                    rc_tank_bindings_process(seat, state, now);
                 }
-                
-                // 속도 조절 (X/Y 버튼 + D-PAD)
-                if (gp->buttons & BUTTON_X) {
-                    if (dpad_y > 0) {
-                        rc_tank.left_speed_multiplier += 0.02f;
-                        if (rc_tank.left_speed_multiplier > 2.0f) rc_tank.left_speed_multiplier = 2.0f;
-                        rc_tank_save_speed_multipliers();
-                    } else if (dpad_y < 0) {
-                        rc_tank.left_speed_multiplier -= 0.02f;
-                        if (rc_tank.left_speed_multiplier < 0.1f) rc_tank.left_speed_multiplier = 0.1f;
-                        rc_tank_save_speed_multipliers();
-                    }
-                }
-                
-                if (gp->buttons & BUTTON_Y) {
-                    if (dpad_y > 0) {
-                        rc_tank.right_speed_multiplier += 0.02f;
-                        if (rc_tank.right_speed_multiplier > 2.0f) rc_tank.right_speed_multiplier = 2.0f;
-                        rc_tank_save_speed_multipliers();
-                    } else if (dpad_y < 0) {
-                        rc_tank.right_speed_multiplier -= 0.02f;
-                        if (rc_tank.right_speed_multiplier < 0.1f) rc_tank.right_speed_multiplier = 0.1f;
-                        rc_tank_save_speed_multipliers();
-                    }
-                }
-                
-                // 기관총 발사 시간 체크 (3초)
-                if (machine_gun_firing) {
-                    uint32_t current_time = esp_timer_get_time() / 1000;
-                    if (current_time - machine_gun_start_time >= 3000) {
-                        machine_gun_firing = false;
-                        // 포신 LED 점멸 중단
-                        gpio_set_level(CANNON_LED_PIN, 0);
-                    } else {
-                        // 포신 LED 점멸 (500ms 간격)
-                        static uint32_t last_blink = 0;
-                        if (current_time - last_blink >= 500) {
-                            static bool led_state = false;
-                            led_state = !led_state;
-                            gpio_set_level(CANNON_LED_PIN, led_state ? 1 : 0);
-                            last_blink = current_time;
-                        }
-                    }
-                }
-                
-                // 포신 발사 시간 체크 (500ms)
-                if (cannon_firing) {
-                    uint32_t current_time = esp_timer_get_time() / 1000;
-                    if (current_time - cannon_start_time >= 500) {
-                        cannon_firing = false;
-                    }
-                }
-            }
-
-            // Toggle Bluetooth connections
-            if ((gp->buttons & BUTTON_SHOULDER_L) && enabled) {
-                logi("*** Stop scanning\n");
-                uni_bt_stop_scanning_safe();
-                enabled = false;
-            }
-            if ((gp->buttons & BUTTON_SHOULDER_R) && !enabled) {
-                logi("*** Start scanning\n");
-                uni_bt_start_scanning_and_autoconnect_safe();
-                enabled = true;
+                rc_tank_record_buttons(seat, state, now);
             }
             break;
         default:
@@ -260,6 +360,21 @@ static void my_platform_on_controller_data(uni_hid_device_t* d, uni_controller_t
     }
 }
 
+static void my_platform_register_console_cmds(void) {
+    rc_tank_loop_register_cmds();
+    rc_tank_bench_register_cmds();
+    rc_tank_bindings_register_cmds();
+    rc_tank_boot_register_cmds();
+    rc_tank_failsafe_register_cmds();
+    rc_tank_turret_register_cmds();
+    rc_tank_servo_register_cmds();
+    rc_tank_power_register_cmds();
+    rc_tank_crew_register_cmds();
+    rc_tank_record_register_cmds();
+    rc_tank_haptics_register_cmds();
+    rc_tank_drive_register_cmds();
+}
+
 static const uni_property_t* my_platform_get_property(uni_property_idx_t idx) {
     ARG_UNUSED(idx);
     return NULL;
@@ -276,10 +391,22 @@ static void my_platform_on_oob_event(uni_platform_oob_event_t event, void* data)
             }
             logi("custom: on_device_oob_event(): %d\n", event);
 
-            my_platform_instance_t* ins = get_my_platform_instance(d);
-            ins->gamepad_seat = ins->gamepad_seat == GAMEPAD_SEAT_A ? GAMEPAD_SEAT_B : GAMEPAD_SEAT_A;
+            // 다른 좌석이 비어 있으면 옮겨 앉고, 차 있으면 두 컨트롤러의 좌석을 맞바꾼다
+            int seat = get_crew_seat(d);
+            if (seat < 0) {
+                return;
+            }
+            int other = seat == RC_TANK_SEAT_DRIVER ? RC_TANK_SEAT_GUNNER : RC_TANK_SEAT_DRIVER;
+            uni_hid_device_t* mate = crew_seats[other];
 
+            vacate_crew_seat(seat);
+            vacate_crew_seat(other);
+            take_crew_seat(other, d);
             trigger_event_on_gamepad(d);
+            if (mate != NULL) {
+                take_crew_seat(seat, mate);
+                trigger_event_on_gamepad(mate);
+            }
             break;
         }
 
@@ -300,19 +427,55 @@ static my_platform_instance_t* get_my_platform_instance(uni_hid_device_t* d) {
     return (my_platform_instance_t*)&d->platform_data[0];
 }
 
-static void trigger_event_on_gamepad(uni_hid_device_t* d) {
-    my_platform_instance_t* ins = get_my_platform_instance(d);
+// 장치가 앉은 좌석 (rc_tank_seat_t). 좌석이 없으면 -1
+static int get_crew_seat(uni_hid_device_t* d) {
+    for (int i = 0; i < RC_TANK_CREW_SEATS; i++) {
+        if (crew_seats[i] == d) {
+            return i;
+        }
+    }
+    return -1;
+}
+
+static void take_crew_seat(int seat, uni_hid_device_t* d) {
+    crew_seats[seat] = d;
+    get_my_platform_instance(d)->gamepad_seat = (uni_gamepad_seat_t)BIT(seat);
+    rc_tank.is_connected = true;
+    logi("custom: %p takes seat %c\n", d, 'A' + seat);
+}
 
-    if (d->report_parser.play_dual_rumble != NULL) {
-        d->report_parser.play_dual_rumble(d, 0 /* delayed start ms */, 150 /* duration ms */, 128 /* weak magnitude */,
-                                          40 /* strong magnitude */);
+// 좌석을 비운다: 입력 비활성 게시 (그 좌석이 맡던 구동 정지), 버튼 상태와 중복 비교 초기화
+static void vacate_crew_seat(int seat) {
+    if (crew_seats[seat] != NULL) {
+        get_my_platform_instance(crew_seats[seat])->gamepad_seat = GAMEPAD_SEAT_NONE;
     }
+    crew_seats[seat] = NULL;
+    rc_tank_crew_publish(seat, &(rc_tank_input_t){.link = -1, .active = false});
+    rc_tank_bindings_reset_seat(seat);
+    rc_tank_haptics_reset_seat(seat);
+    rc_tank_record_buttons(seat, 0, esp_timer_get_time());
+    memset(&seat_prev[seat], 0, sizeof(seat_prev[seat]));
+}
 
-    if (d->report_parser.set_player_leds != NULL) {
-        d->report_parser.set_player_leds(d, ins->gamepad_seat);
+static void trigger_event_on_gamepad(uni_hid_device_t* d) {
+    // 진동은 햅틱 스케줄러를 거쳐 다음 타이머에서 보낸다
+    int seat = get_crew_seat(d);
+    if (seat >= 0) {
+        rc_tank_haptics_post(RC_TANK_HAPTIC_CONNECT, 1u << seat);
     }
 
-    if (d->report_parser.set_lightbar_color != NULL) {
+    // 배터리를 잠깐 보여 주던 중이어도 바뀐 좌석을 바로 표시한다
+    get_my_platform_instance(d)->battery_flash_until_us = 0;
+    show_seat_on_gamepad(d);
+}
+
+// 좌석 표시: 플레이어 LED 가 있으면 LED, 없으면 (DS4, PS Move) 라이트바 색상
+static void show_seat_on_gamepad(uni_hid_device_t* d) {
+    my_platform_instance_t* ins = get_my_platform_instance(d);
+
+    if (d->report_parser.set_player_leds != NULL) {
+        d->report_parser.set_player_leds(d, ins->gamepad_seat);
+    } else if (d->report_parser.set_lightbar_color != NULL) {
         uint8_t red = (ins->gamepad_seat & 0x01) ? 0xff : 0;
         uint8_t green = (ins->gamepad_seat & 0x02) ? 0xff : 0;
         uint8_t blue = (ins->gamepad_seat & 0x04) ? 0xff : 0;
@@ -320,6 +483,77 @@ static void trigger_event_on_gamepad(uni_hid_device_t* d) {
     }
 }
 
+// 배터리 잔량 단계 표시 (BT 스레드). 단계가 바뀔 때만 출력 보고를 보낸다.
+// 좌석 표시와 겹치지 않게 라이트바와 플레이어 LED 가 모두 있으면 (DS5) 라이트바에 녹색 -> 노란색 -> 주황색 -> 빨간색으로
+// 계속 표시하고, 하나뿐이면 그 자리에 BATTERY_FLASH_MS 동안 보여 준 뒤 좌석 표시로 돌아간다 (on_seat_timer)
+static void show_battery_on_gamepad(uni_hid_device_t* d) {
+    static const uint8_t level_colors[RC_TANK_POWER_LEVELS][3] = {
+        {0xff, 0x00, 0x00},
+        {0xff, 0x60, 0x00},
+        {0xc0, 0xc0, 0x00},
+        {0x00, 0xff, 0x00},
+    };
+    my_platform_instance_t* ins = get_my_platform_instance(d);
+    int level = rc_tank_power_get_level();
+
+    if (level < 0 || level == ins->battery_level) {
+        return;
+    }
+    ins->battery_level = (int8_t)level;
+
+    if (d->report_parser.set_lightbar_color != NULL) {
+        d->report_parser.set_lightbar_color(d, level_colors[level][0], level_colors[level][1], level_colors[level][2]);
+        if (d->report_parser.set_player_leds != NULL) {
+            // 좌석은 플레이어 LED 에 그대로 있다
+            return;
+        }
+    } else if (d->report_parser.set_player_leds != NULL) {
+        d->report_parser.set_player_leds(d, (1 << (level + 1)) - 1);
+    } else {
+        return;
+    }
+    ins->battery_flash_until_us = esp_timer_get_time() + BATTERY_FLASH_MS * 1000LL;
+}
+
+// 좌석마다 햅틱 스케줄러가 정한 진동 요청을 보낸다 (BT 스레드 타이머).
+// 같은 주기로 HOLD 바인딩의 유지 시간을 판정하고, 보고가 없어도 링크 RSSI 를 조회하고, 배터리 표시 후 좌석 표시를 되돌린다
+static void on_seat_timer(btstack_timer_source_t* ts) {
+    int64_t now = esp_timer_get_time();
+    rc_tank_bindings_tick(now);
+    for (int seat = 0; seat < RC_TANK_CREW_SEATS; seat++) {
+        uni_hid_device_t* d = crew_seats[seat];
+        if (d == NULL) {
+            continue;
+        }
+
+        int link = uni_hid_device_get_idx_for_instance(d);
+        if (rc_tank_failsafe_rssi_due(link, now)) {
+            // 결과는 GAP_EVENT_RSSI_MEASUREMENT 로 d->conn.rssi 에 반영된다
+            gap_read_rssi(d->conn.handle);
+        }
+        rc_tank_failsafe_on_rssi(link, (int8_t)d->conn.rssi, d->conn.protocol == UNI_BT_CONN_PROTOCOL_BLE, now);
+
+        // 배터리 표시 시간이 끝나면 좌석 표시로 돌아간다
+        my_platform_instance_t* ins = get_my_platform_instance(d);
+        if (ins->battery_flash_until_us != 0 && now >= ins->battery_flash_until_us) {
+            ins->battery_flash_until_us = 0;
+            show_seat_on_gamepad(d);
+        }
+
+        rc_tank_rumble_t rumble;
+        if (!rc_tank_haptics_poll(seat, now, &rumble)) {
+            continue;
+        }
+        if (d->report_parser.play_dual_rumble != NULL) {
+            d->report_parser.play_dual_rumble(d, 0 /* delayed start ms */, rumble.duration_ms, rumble.weak,
+                                              rumble.strong);
+        }
+    }
+
+    btstack_run_loop_set_timer(ts, RC_TANK_HAPTICS_MIN_INTERVAL_MS);
+    btstack_run_loop_add_timer(ts);
+}
+
 //
 // Entry Point
 //
@@ -335,6 +569,7 @@ struct uni_platform* get_my_platform(void) {
         .on_oob_event = my_platform_on_oob_event,
         .on_controller_data = my_platform_on_controller_data,
         .get_property = my_platform_get_property,
+        .register_console_cmds = my_platform_register_console_cmds,
     };
 
     return &plat;
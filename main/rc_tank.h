@@ -3,6 +3,7 @@
 
 #include <stdint.h>
 #include <stdbool.h>
+#include "rc_tank_snapshot.h"
 
 // RC Tank 핀 정의
 #define LEFT_TRACK_IN1_PIN    25  // 좌측 트랙 IN1
@@ -20,6 +21,24 @@
 #define CANNON_SERVO_PIN      18  // 포신 서보 모터
 #define MOUNT_SERVO_PIN       19  // 포 마운트 서보 모터
 
+// 터렛 위치 센서 (둘 중 하나를 RC_TANK_TURRET_SENSOR 로 선택)
+#define RC_TANK_TURRET_SENSOR_POT      0   // 가변저항 (ADC 연속 변환, DMA)
+#define RC_TANK_TURRET_SENSOR_ENCODER  1   // 쿼드러처 엔코더 (PCNT)
+#define RC_TANK_TURRET_SENSOR          RC_TANK_TURRET_SENSOR_POT
+#define TURRET_POT_PIN        34  // 가변저항 와이퍼 (ADC1)
+#define TURRET_POT_RANGE_DEG  270 // 가변저항 전체 회전각
+#define TURRET_ENC_A_PIN      34  // 엔코더 A상 (가변저항 대신 장착, 외부 풀업 필요)
+#define TURRET_ENC_B_PIN      35  // 엔코더 B상 (외부 풀업 필요)
+#define TURRET_ENC_COUNTS_PER_REV 1440  // 터렛 1회전당 카운트 (4체배 후)
+
+// 전원 감시 (ADC1, 터렛 가변저항과 같은 연속 변환에서 샘플링)
+#define BATTERY_SENSE_PIN     36  // 배터리 분압 (VP)
+#define CURRENT_SENSE_PIN     39  // 모터 전류 센서 출력 (VN)
+#define BATTERY_DIVIDER_NUM   133 // 분압비 (100k + 33k) / 33k
+#define BATTERY_DIVIDER_DEN   33
+#define CURRENT_SENSE_OFFSET_MV 1650  // 0A 일 때 센서 출력
+#define CURRENT_SENSE_MV_PER_A  110   // 감도
+
 // DFPlayer 핀
 #define DFPLAYER_RX_PIN       32  // DFPlayer RX
 #define DFPLAYER_TX_PIN       33  // DFPlayer TX
@@ -34,6 +53,7 @@
 #define LEDC_CHANNEL_MOUNT      LEDC_CHANNEL_0
 #define LEDC_CHANNEL_CANNON     LEDC_CHANNEL_1
 #define LEDC_DUTY_RES           LEDC_TIMER_13_BIT
+#define RC_TANK_SERVO_DUTY_BITS 13  // LEDC_DUTY_RES 와 같아야 함
 #define LEDC_FREQUENCY          50  // 50Hz for servo motors
 
 // 서보 모터 각도 범위
@@ -42,6 +62,10 @@
 #define CANNON_MIN_ANGLE      0
 #define CANNON_MAX_ANGLE      90
 
+// D-PAD를 누르고 있을 때 포 마운트 이동 (50ms마다 5도)
+#define MOUNT_STEP_ANGLE      5
+#define MOUNT_STEP_INTERVAL_MS 50
+
 // RC Tank 상태
 typedef enum {
     RC_TANK_STOP = 0,
@@ -56,6 +80,11 @@ typedef enum {
 } rc_tank_state_t;
 
 // RC Tank 제어 구조체
+// 필드마다 쓰는 스레드는 하나뿐이다:
+// - 트랙/터렛/마운트: 제어 루프 태스크
+// - 포신 각도/헤드라이트: 효과 태스크
+// - 연결 상태/속도 배율: BT 스레드
+// 게임패드 입력은 이 구조체가 아니라 좌석별 입력 스냅샷으로 전달된다 (rc_tank_crew).
 typedef struct {
     rc_tank_state_t state;
     int left_track_speed;
@@ -64,7 +93,7 @@ typedef struct {
     int mount_angle;
     int cannon_angle;
     bool headlight_on;
-    bool is_connected;
+    bool is_connected;  // 좌석에 앉은 컨트롤러가 하나라도 있음
     float left_speed_multiplier;
     float right_speed_multiplier;
 } rc_tank_control_t;
@@ -77,10 +106,18 @@ void rc_tank_set_mount_angle(int angle);
 void rc_tank_set_cannon_angle(int angle);
 void rc_tank_toggle_headlight(void);
 void rc_tank_stop(void);
-void rc_tank_control_from_gamepad(float left_y, float right_y, int dpad_x, int dpad_y);
+// 가감속을 한 틱 진행하고 MCPWM 출력 갱신 (제어 루프에서 호출)
+void rc_tank_update_outputs(void);
+// 합친 입력으로 트랙 (rc_tank_drive 주행 모드) 과 터렛/마운트 (D-PAD) 목표 설정
+void rc_tank_control_from_gamepad(const rc_tank_input_t* input);
+// 센서 입력 갱신 및 전원 감시 (제어 루프에서 매 틱 가장 먼저 호출)
 void rc_tank_update_state(void);
-void rc_tank_save_speed_multipliers(void);
-void rc_tank_load_speed_multipliers(void);
+void rc_tank_set_speed_multipliers(float left, float right);
+// 트랙 목표 속도 상한 (0 ~ 255, 배율 적용 후)
+void rc_tank_set_track_limit(int max_speed);
+// 트랙/터렛 출력 배율 (Q8, 256 = 제한 없음)
+void rc_tank_set_output_scale(int scale_q8);
+uint32_t rc_tank_mount_angle_to_duty(int angle);
 
 extern rc_tank_control_t rc_tank;
 
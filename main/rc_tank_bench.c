@@ -0,0 +1,81 @@
+#include "rc_tank_bench.h"
+#include "rc_tank.h"
+#include "rc_tank_fixed.h"
+#include "driver/ledc.h"
+#include "esp_console.h"
+#include "esp_cpu.h"
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+#define BENCH_DEFAULT_ITERATIONS 10000
+
+// 결과가 최적화로 사라지지 않도록 누적
+static volatile uint32_t bench_sink;
+
+// 이전 float 경로: 축 -> float -> 데드존 -> 속도 -> 배율 -> MCPWM 틱, 서보 duty %
+static uint32_t float_path(int32_t axis, float multiplier, int angle) {
+    const float DEADZONE = 0.1f;
+    const uint32_t period_ticks = MCPWM_TIMER_RESOLUTION / MCPWM_FREQ;
+
+    float y = (float)axis / 512.0f;
+    if (fabsf(y) < DEADZONE) y = 0;
+    int speed = (int)(y * 255);
+    speed = (int)(speed * multiplier);
+    uint32_t ticks = (uint32_t)((abs(speed) * period_ticks) / 255);
+
+    float duty_percent = 2.5f + (angle * 10.0f) / 180.0f;
+    uint32_t duty = (uint32_t)((duty_percent / 100.0f) * ((1 << LEDC_DUTY_RES) - 1));
+    return ticks + duty;
+}
+
+// 정수 경로: Q15 -> 속도 -> Q8 배율 -> Q16 틱, 서보 LUT
+static uint32_t fixed_path(int32_t axis, int32_t gain_q8, int angle) {
+    int32_t q = rc_tank_q15_deadzone(rc_tank_axis_to_q15(axis), RC_TANK_DEADZONE_Q15);
+    int32_t speed = rc_tank_apply_gain_q8(rc_tank_q15_to_speed(q), gain_q8);
+    uint32_t ticks = rc_tank_speed_to_ticks(abs(speed));
+    return ticks + rc_tank_mount_angle_to_duty(angle);
+}
+
+static int cmd_tank_bench(int argc, char** argv) {
+    int iterations = BENCH_DEFAULT_ITERATIONS;
+    if (argc > 1) {
+        iterations = atoi(argv[1]);
+        if (iterations <= 0) iterations = BENCH_DEFAULT_ITERATIONS;
+    }
+
+    const float multiplier = 1.3f;
+    const int32_t gain_q8 = (int32_t)(multiplier * RC_TANK_GAIN_Q8_ONE);
+    uint32_t acc = 0;
+
+    esp_cpu_cycle_count_t start = esp_cpu_get_cycle_count();
+    for (int i = 0; i < iterations; i++) {
+        acc += float_path((i & 1023) - 512, multiplier, i % 181);
+    }
+    uint32_t float_cycles = esp_cpu_get_cycle_count() - start;
+
+    start = esp_cpu_get_cycle_count();
+    for (int i = 0; i < iterations; i++) {
+        acc += fixed_path((i & 1023) - 512, gain_q8, i % 181);
+    }
+    uint32_t fixed_cycles = esp_cpu_get_cycle_count() - start;
+    bench_sink = acc;
+
+    printf("Actuator pipeline, %d iterations\n", iterations);
+    printf("  float: %lu cycles/update\n", (unsigned long)(float_cycles / iterations));
+    printf("  fixed: %lu cycles/update\n", (unsigned long)(fixed_cycles / iterations));
+    return 0;
+}
+
+void rc_tank_bench_register_cmds(void) {
+    const esp_console_cmd_t bench_cmd = {
+        .command = "tank_bench",
+        .help =
+            "Measures cycles per update of the float and fixed-point actuator paths.\n"
+            "  Default iterations: 10000",
+        .hint = "[iterations]",
+        .func = &cmd_tank_bench,
+    };
+
+    ESP_ERROR_CHECK(esp_console_cmd_register(&bench_cmd));
+}
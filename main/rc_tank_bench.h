@@ -0,0 +1,8 @@
+#ifndef RC_TANK_BENCH_H
+#define RC_TANK_BENCH_H
+
+// 구동 파이프라인 마이크로 벤치마크 (콘솔 명령 'tank_bench')
+// (Bluepad32 HID 보고 해석 / 기기 조회는 호스트의 bench_hid_parser, bench_device_index)
+void rc_tank_bench_register_cmds(void);
+
+#endif // RC_TANK_BENCH_H
@@ -0,0 +1,412 @@
+#include "rc_tank_bindings.h"
+#include "rc_tank_settings.h"
+#include "controller/uni_gamepad.h"
+#include "esp_console.h"
+#include "esp_log.h"
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+#include "nvs.h"
+#include <stddef.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+static const char* TAG = "RC_TANK_BIND";
+
+#define DPAD(x) ((uint32_t)(x) << RC_TANK_INPUT_DPAD_SHIFT)
+#define MISC(x) ((uint32_t)(x) << RC_TANK_INPUT_MISC_SHIFT)
+
+// 기본 바인딩. R1 은 헤드라이트 전용이고 검색 토글은 L1 길게 누르기로 옮겼다.
+static const rc_tank_binding_t default_bindings[] = {
+    // A/B 버튼이 뒤바뀜
+    {.mask = BUTTON_B, .trigger = RC_TANK_TRIGGER_PRESS, .action = RC_TANK_ACTION_CANNON_FIRE},
+    {.mask = BUTTON_A, .trigger = RC_TANK_TRIGGER_PRESS, .action = RC_TANK_ACTION_MACHINE_GUN},
+    {.mask = BUTTON_SHOULDER_R, .trigger = RC_TANK_TRIGGER_PRESS, .action = RC_TANK_ACTION_HEADLIGHT_TOGGLE},
+    // 속도 조절 (X/Y 버튼 + D-PAD 위/아래)
+    {.mask = BUTTON_X | DPAD(DPAD_UP), .trigger = RC_TANK_TRIGGER_PRESS, .action = RC_TANK_ACTION_LEFT_SPEED_STEP,
+     .arg = -2},
+    {.mask = BUTTON_X | DPAD(DPAD_DOWN), .trigger = RC_TANK_TRIGGER_PRESS, .action = RC_TANK_ACTION_LEFT_SPEED_STEP,
+     .arg = 2},
+    {.mask = BUTTON_Y | DPAD(DPAD_UP), .trigger = RC_TANK_TRIGGER_PRESS, .action = RC_TANK_ACTION_RIGHT_SPEED_STEP,
+     .arg = -2},
+    {.mask = BUTTON_Y | DPAD(DPAD_DOWN), .trigger = RC_TANK_TRIGGER_PRESS, .action = RC_TANK_ACTION_RIGHT_SPEED_STEP,
+     .arg = 2},
+    // 블루투스 검색 시작/중지 (L1 1초)
+    {.mask = BUTTON_SHOULDER_L, .hold_ms = 1000, .trigger = RC_TANK_TRIGGER_HOLD, .action = RC_TANK_ACTION_SCAN_TOGGLE},
+    // 터렛 정면 복귀 (R3)
+    {.mask = BUTTON_THUMB_R, .trigger = RC_TANK_TRIGGER_PRESS, .action = RC_TANK_ACTION_TURRET_CENTER},
+    // 주행 모드 전환 (Select)
+    {.mask = MISC(MISC_BUTTON_SELECT), .trigger = RC_TANK_TRIGGER_PRESS, .action = RC_TANK_ACTION_DRIVE_MODE},
+};
+
+static const char* const trigger_names[RC_TANK_TRIGGER_MAX] = {"press", "release", "hold"};
+static const char* const action_names[RC_TANK_ACTION_MAX] = {
+    "none", "cannon", "machine_gun", "headlight", "left_speed", "right_speed", "scan_toggle", "turret_center",
+    "drive_mode",
+};
+
+// 컴파일된 바인딩 표
+typedef struct {
+    rc_tank_binding_t bindings[RC_TANK_BINDINGS_MAX];
+    uint8_t count;
+    uint32_t by_bit[32];  // 입력 비트별로 그 비트를 쓰는 바인딩 집합
+} binding_map_t;
+
+// NVS 저장 형식
+typedef struct {
+    uint16_t version;
+    uint8_t count;
+    uint8_t reserved;
+    rc_tank_binding_t bindings[RC_TANK_BINDINGS_MAX];
+} binding_blob_t;
+
+// 처리 스레드는 활성 표만 읽고, 교체는 비활성 표에 컴파일한 뒤 포인터만 바꾼다.
+// 처리 상태와 포인터 교체는 bindings_mux 로 보호
+static binding_map_t maps[2];
+static binding_map_t* active_map = &maps[0];
+
+// 좌석별 처리 상태. 두 컨트롤러의 버튼 변화가 서로의 이전 상태를 덮어쓰지 않도록 따로 둔다.
+typedef struct {
+    uint32_t prev_state;
+    uint32_t hold_pending;  // 유지 시간을 기다리는 HOLD 바인딩 집합
+    int64_t hold_start_us[RC_TANK_BINDINGS_MAX];
+} binding_seat_t;
+
+static binding_seat_t seats[RC_TANK_CREW_SEATS];
+static portMUX_TYPE bindings_mux = portMUX_INITIALIZER_UNLOCKED;
+static rc_tank_action_handler_t action_handler = NULL;
+
+static bool binding_valid(const rc_tank_binding_t* b) {
+    return b->mask != 0 && b->trigger < RC_TANK_TRIGGER_MAX && b->action < RC_TANK_ACTION_MAX;
+}
+
+static void compile(binding_map_t* map, const rc_tank_binding_t* bindings, uint8_t count) {
+    memset(map, 0, sizeof(*map));
+    for (int i = 0; i < count && map->count < RC_TANK_BINDINGS_MAX; i++) {
+        if (!binding_valid(&bindings[i]) || bindings[i].action == RC_TANK_ACTION_NONE) {
+            continue;
+        }
+        uint8_t index = map->count++;
+        map->bindings[index] = bindings[i];
+        for (uint32_t bits = bindings[i].mask; bits; bits &= bits - 1) {
+            map->by_bit[__builtin_ctz(bits)] |= 1u << index;
+        }
+    }
+}
+
+bool rc_tank_bindings_set(const rc_tank_binding_t* bindings, uint8_t count) {
+    if (count > RC_TANK_BINDINGS_MAX) {
+        return false;
+    }
+    for (int i = 0; i < count; i++) {
+        if (!binding_valid(&bindings[i])) {
+            return false;
+        }
+    }
+
+    binding_map_t* next = (active_map == &maps[0]) ? &maps[1] : &maps[0];
+    compile(next, bindings, count);
+
+    portENTER_CRITICAL(&bindings_mux);
+    active_map = next;
+    for (int i = 0; i < RC_TANK_CREW_SEATS; i++) {
+        seats[i].hold_pending = 0;
+    }
+    portEXIT_CRITICAL(&bindings_mux);
+    return true;
+}
+
+uint8_t rc_tank_bindings_get(rc_tank_binding_t* out, uint8_t max) {
+    portENTER_CRITICAL(&bindings_mux);
+    uint8_t count = active_map->count < max ? active_map->count : max;
+    memcpy(out, active_map->bindings, count * sizeof(*out));
+    portEXIT_CRITICAL(&bindings_mux);
+    return count;
+}
+
+void rc_tank_bindings_reset_defaults(void) {
+    rc_tank_bindings_set(default_bindings, sizeof(default_bindings) / sizeof(default_bindings[0]));
+}
+
+static bool load(void) {
+    nvs_handle_t nvs_handle;
+    if (nvs_open(RC_TANK_SETTINGS_NAMESPACE, NVS_READONLY, &nvs_handle) != ESP_OK) {
+        return false;
+    }
+
+    binding_blob_t blob;
+    size_t size = sizeof(blob);
+    esp_err_t err = nvs_get_blob(nvs_handle, RC_TANK_BINDINGS_KEY, &blob, &size);
+    nvs_close(nvs_handle);
+    if (err != ESP_OK) {
+        return false;
+    }
+
+    size_t header = offsetof(binding_blob_t, bindings);
+    if (size < header || blob.version != RC_TANK_BINDINGS_VERSION || blob.count > RC_TANK_BINDINGS_MAX ||
+        size != header + blob.count * sizeof(rc_tank_binding_t)) {
+        ESP_LOGW(TAG, "Unknown bindings (version=%d, size=%d), using defaults", blob.version, (int)size);
+        return false;
+    }
+    if (!rc_tank_bindings_set(blob.bindings, blob.count)) {
+        ESP_LOGW(TAG, "Invalid stored bindings, using defaults");
+        return false;
+    }
+    ESP_LOGI(TAG, "Bindings loaded: %d", blob.count);
+    return true;
+}
+
+bool rc_tank_bindings_save(void) {
+    binding_blob_t blob = {.version = RC_TANK_BINDINGS_VERSION};
+    blob.count = rc_tank_bindings_get(blob.bindings, RC_TANK_BINDINGS_MAX);
+
+    nvs_handle_t nvs_handle;
+    esp_err_t err = nvs_open(RC_TANK_SETTINGS_NAMESPACE, NVS_READWRITE, &nvs_handle);
+    if (err != ESP_OK) {
+        ESP_LOGE(TAG, "NVS open failed: %s", esp_err_to_name(err));
+        return false;
+    }
+    err = nvs_set_blob(nvs_handle, RC_TANK_BINDINGS_KEY, &blob,
+                       offsetof(binding_blob_t, bindings) + blob.count * sizeof(rc_tank_binding_t));
+    if (err == ESP_OK) {
+        err = nvs_commit(nvs_handle);
+    }
+    nvs_close(nvs_handle);
+
+    if (err != ESP_OK) {
+        ESP_LOGE(TAG, "Bindings save failed: %s", esp_err_to_name(err));
+        return false;
+    }
+    ESP_LOGI(TAG, "Bindings saved: %d", blob.count);
+    return true;
+}
+
+void rc_tank_bindings_init(rc_tank_action_handler_t handler) {
+    action_handler = handler;
+    if (!load()) {
+        rc_tank_bindings_reset_defaults();
+    }
+}
+
+// 유지 시간이 지난 HOLD 바인딩을 대기 집합에서 빼고 반환 (bindings_mux 안에서 호출)
+static uint32_t take_due_holds(binding_seat_t* st, const binding_map_t* map, int64_t now_us) {
+    uint32_t due = 0;
+    for (uint32_t set = st->hold_pending; set; set &= set - 1) {
+        int i = __builtin_ctz(set);
+        if (now_us - st->hold_start_us[i] >= map->bindings[i].hold_ms * 1000LL) {
+            due |= 1u << i;
+        }
+    }
+    st->hold_pending &= ~due;
+    return due;
+}
+
+// 발생한 바인딩을 events 에 복사하고 개수를 반환 (bindings_mux 안에서 호출).
+// 같은 때 더 큰 코드가 성립했으면 그 부분 조합은 버린다 (X+위 를 누를 때 위 단독 바인딩 등)
+static uint8_t collect_events(const binding_map_t* map, uint32_t fired, rc_tank_binding_t* events) {
+    uint8_t event_count = 0;
+    for (uint32_t set = fired; set; set &= set - 1) {
+        int i = __builtin_ctz(set);
+        uint32_t mask = map->bindings[i].mask;
+        bool shadowed = false;
+        for (uint32_t other = fired & ~(1u << i); other; other &= other - 1) {
+            uint32_t other_mask = map->bindings[__builtin_ctz(other)].mask;
+            if ((other_mask & mask) == mask && other_mask != mask) {
+                shadowed = true;
+                break;
+            }
+        }
+        if (!shadowed) {
+            events[event_count++] = map->bindings[i];
+        }
+    }
+    return event_count;
+}
+
+// 처리기는 큐 전송 등을 하므로 임계 구역 밖에서 호출
+static void dispatch(const rc_tank_binding_t* events, uint8_t event_count, uint8_t seat) {
+    for (int i = 0; i < event_count; i++) {
+        if (action_handler != NULL) {
+            action_handler((rc_tank_action_t)events[i].action, events[i].arg, seat);
+        }
+    }
+}
+
+void rc_tank_bindings_process(uint8_t seat, uint32_t state, int64_t now_us) {
+    uint32_t fired = 0;
+    rc_tank_binding_t events[RC_TANK_BINDINGS_MAX];
+    uint8_t event_count = 0;
+
+    if (seat >= RC_TANK_CREW_SEATS) {
+        return;
+    }
+    binding_seat_t* st = &seats[seat];
+
+    portENTER_CRITICAL(&bindings_mux);
+    const binding_map_t* map = active_map;
+    uint32_t changed = state ^ st->prev_state;
+
+    // 바뀐 비트에 걸린 바인딩만 후보로 모은다
+    uint32_t candidates = 0;
+    for (uint32_t bits = changed; bits; bits &= bits - 1) {
+        candidates |= map->by_bit[__builtin_ctz(bits)];
+    }
+
+    for (uint32_t set = candidates; set; set &= set - 1) {
+        int i = __builtin_ctz(set);
+        const rc_tank_binding_t* b = &map->bindings[i];
+        bool was = (st->prev_state & b->mask) == b->mask;
+        bool is = (state & b->mask) == b->mask;
+        if (was == is) {
+            continue;
+        }
+        switch (b->trigger) {
+            case RC_TANK_TRIGGER_PRESS:
+                if (is) fired |= 1u << i;
+                break;
+            case RC_TANK_TRIGGER_RELEASE:
+                if (!is) fired |= 1u << i;
+                break;
+            case RC_TANK_TRIGGER_HOLD:
+                if (is) {
+                    st->hold_start_us[i] = now_us;
+                    st->hold_pending |= 1u << i;
+                } else {
+                    st->hold_pending &= ~(1u << i);
+                }
+                break;
+        }
+    }
+
+    // hold_ms 가 0 이면 누르는 보고에서 바로 발생한다. 나머지는 rc_tank_bindings_tick 에서 판정
+    fired |= take_due_holds(st, map, now_us);
+    event_count = collect_events(map, fired, events);
+
+    st->prev_state = state;
+    portEXIT_CRITICAL(&bindings_mux);
+
+    dispatch(events, event_count, seat);
+}
+
+void rc_tank_bindings_tick(int64_t now_us) {
+    rc_tank_binding_t events[RC_TANK_BINDINGS_MAX];
+
+    for (uint8_t seat = 0; seat < RC_TANK_CREW_SEATS; seat++) {
+        uint8_t event_count = 0;
+        portENTER_CRITICAL(&bindings_mux);
+        if (seats[seat].hold_pending != 0) {
+            const binding_map_t* map = active_map;
+            event_count = collect_events(map, take_due_holds(&seats[seat], map, now_us), events);
+        }
+        portEXIT_CRITICAL(&bindings_mux);
+
+        dispatch(events, event_count, seat);
+    }
+}
+
+void rc_tank_bindings_reset_seat(uint8_t seat) {
+    if (seat >= RC_TANK_CREW_SEATS) {
+        return;
+    }
+    portENTER_CRITICAL(&bindings_mux);
+    seats[seat].prev_state = 0;
+    seats[seat].hold_pending = 0;
+    portEXIT_CRITICAL(&bindings_mux);
+}
+
+static int find_name(const char* const* names, int count, const char* name) {
+    for (int i = 0; i < count; i++) {
+        if (strcmp(names[i], name) == 0) {
+            return i;
+        }
+    }
+    return -1;
+}
+
+static void print_bindings(void) {
+    rc_tank_binding_t bindings[RC_TANK_BINDINGS_MAX];
+    uint8_t count = rc_tank_bindings_get(bindings, RC_TANK_BINDINGS_MAX);
+
+    printf("Bindings: %d\n", count);
+    for (int i = 0; i < count; i++) {
+        const rc_tank_binding_t* b = &bindings[i];
+        printf("  %2d: mask=0x%08lx %-7s %-11s arg=%d", i, (unsigned long)b->mask, trigger_names[b->trigger],
+               action_names[b->action], b->arg);
+        if (b->trigger == RC_TANK_TRIGGER_HOLD) {
+            printf(" hold=%d ms", b->hold_ms);
+        }
+        printf("\n");
+    }
+}
+
+static int cmd_tank_bind(int argc, char** argv) {
+    if (argc < 2 || strcmp(argv[1], "list") == 0) {
+        print_bindings();
+        return 0;
+    }
+
+    if (strcmp(argv[1], "reset") == 0) {
+        rc_tank_bindings_reset_defaults();
+        print_bindings();
+        return 0;
+    }
+
+    if (strcmp(argv[1], "save") == 0) {
+        return rc_tank_bindings_save() ? 0 : 1;
+    }
+
+    rc_tank_binding_t bindings[RC_TANK_BINDINGS_MAX];
+    uint8_t count = rc_tank_bindings_get(bindings, RC_TANK_BINDINGS_MAX);
+
+    if (strcmp(argv[1], "del") == 0 && argc >= 3) {
+        int index = atoi(argv[2]);
+        if (index < 0 || index >= count) {
+            printf("Invalid index\n");
+            return 1;
+        }
+        memmove(&bindings[index], &bindings[index + 1], (count - index - 1) * sizeof(bindings[0]));
+        rc_tank_bindings_set(bindings, count - 1);
+        print_bindings();
+        return 0;
+    }
+
+    if (strcmp(argv[1], "add") == 0 && argc >= 5) {
+        int trigger = find_name(trigger_names, RC_TANK_TRIGGER_MAX, argv[3]);
+        int action = find_name(action_names, RC_TANK_ACTION_MAX, argv[4]);
+        rc_tank_binding_t b = {
+            .mask = strtoul(argv[2], NULL, 0),
+            .trigger = trigger,
+            .action = action,
+            .arg = (argc > 5) ? atoi(argv[5]) : 0,
+            .hold_ms = (argc > 6) ? atoi(argv[6]) : 0,
+        };
+        if (trigger < 0 || action < 0 || !binding_valid(&b) || count >= RC_TANK_BINDINGS_MAX) {
+            printf("Invalid binding\n");
+            return 1;
+        }
+        bindings[count++] = b;
+        rc_tank_bindings_set(bindings, count);
+        print_bindings();
+        return 0;
+    }
+
+    printf("Unknown command\n");
+    return 1;
+}
+
+void rc_tank_bindings_register_cmds(void) {
+    const esp_console_cmd_t bind_cmd = {
+        .command = "tank_bind",
+        .help =
+            "Lists or changes the button bindings.\n"
+            "  'tank_bind add <mask> <press|release|hold> <action> [arg] [hold_ms]'\n"
+            "  'tank_bind del <index>', 'tank_bind reset', 'tank_bind save' (to NVS)\n"
+            "  mask: buttons in bits 0-15, misc buttons in 16-23, dpad in 24-27\n"
+            "  actions: cannon, machine_gun, headlight, left_speed, right_speed, scan_toggle,\n"
+            "           turret_center, drive_mode",
+        .hint = "[list|add|del|reset|save]",
+        .func = &cmd_tank_bind,
+    };
+
+    ESP_ERROR_CHECK(esp_console_cmd_register(&bind_cmd));
+}
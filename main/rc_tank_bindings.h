@@ -0,0 +1,76 @@
+#ifndef RC_TANK_BINDINGS_H
+#define RC_TANK_BINDINGS_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "rc_tank_crew.h"
+
+// 입력 상태 워드 (32비트): 버튼 / 기타 버튼 / D-PAD 를 한 워드에 모아 XOR 로 변화 비트를 구한다
+#define RC_TANK_INPUT_BUTTONS_SHIFT  0    // uni_gamepad_t.buttons (16비트)
+#define RC_TANK_INPUT_MISC_SHIFT     16   // uni_gamepad_t.misc_buttons (8비트)
+#define RC_TANK_INPUT_DPAD_SHIFT     24   // uni_gamepad_t.dpad (4비트)
+#define RC_TANK_INPUT_STATE(buttons, misc, dpad)                                                  \
+    (((uint32_t)(uint16_t)(buttons) << RC_TANK_INPUT_BUTTONS_SHIFT) |                             \
+     ((uint32_t)(uint8_t)(misc) << RC_TANK_INPUT_MISC_SHIFT) |                                     \
+     ((uint32_t)((dpad) & 0x0F) << RC_TANK_INPUT_DPAD_SHIFT))
+
+// 바인딩 최대 개수 (바인딩 집합을 32비트 마스크로 다룬다)
+#define RC_TANK_BINDINGS_MAX         32
+
+// NVS 저장 위치 (설정과 같은 네임스페이스)
+#define RC_TANK_BINDINGS_KEY         "bindings"
+#define RC_TANK_BINDINGS_VERSION     1
+
+// 발생 조건. mask 의 비트가 모두 눌린 상태를 "조합 성립"으로 본다 (비트가 여러 개면 코드).
+typedef enum {
+    RC_TANK_TRIGGER_PRESS = 0,   // 조합이 성립하는 순간
+    RC_TANK_TRIGGER_RELEASE,     // 조합이 깨지는 순간
+    RC_TANK_TRIGGER_HOLD,        // 조합을 hold_ms 이상 유지 (누를 때마다 한 번)
+    RC_TANK_TRIGGER_MAX
+} rc_tank_trigger_t;
+
+// 동작
+typedef enum {
+    RC_TANK_ACTION_NONE = 0,
+    RC_TANK_ACTION_CANNON_FIRE,
+    RC_TANK_ACTION_MACHINE_GUN,
+    RC_TANK_ACTION_HEADLIGHT_TOGGLE,
+    RC_TANK_ACTION_LEFT_SPEED_STEP,   // arg: 0.01 단위 증감
+    RC_TANK_ACTION_RIGHT_SPEED_STEP,  // arg: 0.01 단위 증감
+    RC_TANK_ACTION_SCAN_TOGGLE,       // 블루투스 검색 시작/중지
+    RC_TANK_ACTION_TURRET_CENTER,     // 터렛 정면 복귀
+    RC_TANK_ACTION_DRIVE_MODE,        // 다음 주행 모드 (rc_tank_drive)
+    RC_TANK_ACTION_MAX
+} rc_tank_action_t;
+
+// 바인딩 (NVS 에 그대로 저장되는 형식)
+typedef struct {
+    uint32_t mask;       // 입력 상태 워드 비트
+    uint16_t hold_ms;    // HOLD 조건일 때만 사용
+    uint8_t trigger;     // rc_tank_trigger_t
+    uint8_t action;      // rc_tank_action_t
+    int8_t arg;
+    uint8_t reserved[3];
+} rc_tank_binding_t;
+
+// 동작 처리기 (입력 콜백 스레드에서 호출된다). seat: 버튼을 누른 좌석 (rc_tank_seat_t)
+typedef void (*rc_tank_action_handler_t)(rc_tank_action_t action, int8_t arg, uint8_t seat);
+
+// 함수 선언
+// NVS 에 저장된 바인딩을 읽어 컴파일한다. 없거나 잘못되면 기본 바인딩 사용.
+void rc_tank_bindings_init(rc_tank_action_handler_t handler);
+// 좌석의 현재 입력 상태를 처리한다. 그 좌석의 이전 상태와 다른 비트에 걸린 바인딩만 검사한다.
+void rc_tank_bindings_process(uint8_t seat, uint32_t state, int64_t now_us);
+// 주기적으로 호출: 유지 중인 HOLD 바인딩의 시간을 판정한다. 버튼을 누르고 있는 동안에는
+// 보고가 중복으로 걸러지거나 (변화 시에만 보고하는 컨트롤러) 오지 않으므로 입력 처리와 따로 본다.
+void rc_tank_bindings_tick(int64_t now_us);
+// 좌석을 비우거나 바꿀 때 이전 상태를 지운다 (동작은 발생하지 않음)
+void rc_tank_bindings_reset_seat(uint8_t seat);
+// 바인딩 교체 (다음 입력부터 적용). 저장은 rc_tank_bindings_save() 로 따로 한다.
+bool rc_tank_bindings_set(const rc_tank_binding_t* bindings, uint8_t count);
+uint8_t rc_tank_bindings_get(rc_tank_binding_t* out, uint8_t max);
+void rc_tank_bindings_reset_defaults(void);
+bool rc_tank_bindings_save(void);
+void rc_tank_bindings_register_cmds(void);
+
+#endif // RC_TANK_BINDINGS_H
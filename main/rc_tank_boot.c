@@ -0,0 +1,148 @@
+#include "rc_tank_boot.h"
+#include "rc_tank.h"
+#include "rc_tank_effects.h"
+#include "rc_tank_loop.h"
+#include "rc_tank_record.h"
+#include "rc_tank_settings.h"
+#include "rc_tank_crew.h"
+#include "dfplayer.h"
+#include "esp_console.h"
+#include "esp_log.h"
+#include "esp_timer.h"
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+#include "nvs_flash.h"
+#include <stdio.h>
+
+static const char* TAG = "RC_TANK_BOOT";
+
+static const char* const stage_names[RC_TANK_BOOT_STAGE_MAX] = {
+    [RC_TANK_BOOT_APP_MAIN] = "app_main",
+    [RC_TANK_BOOT_NVS] = "nvs",
+    [RC_TANK_BOOT_BTSTACK] = "btstack_init",
+    [RC_TANK_BOOT_UNI_INIT] = "uni_init",
+    [RC_TANK_BOOT_DFPLAYER] = "dfplayer",
+    [RC_TANK_BOOT_ACTUATORS] = "actuators",
+    [RC_TANK_BOOT_SETTINGS] = "settings",
+    [RC_TANK_BOOT_DRIVE_READY] = "drive_ready",
+    [RC_TANK_BOOT_DFPLAYER_ONLINE] = "dfplayer_online",
+    [RC_TANK_BOOT_CONTROLLER] = "controller",
+};
+
+// 단계별 도달 시각 (esp_timer 기준 us, 0: 아직 도달하지 않음)
+static int64_t stage_us[RC_TANK_BOOT_STAGE_MAX];
+static portMUX_TYPE boot_mux = portMUX_INITIALIZER_UNLOCKED;
+static volatile bool boot_ready = false;
+
+void rc_tank_boot_mark(rc_tank_boot_stage_t stage) {
+    if (stage >= RC_TANK_BOOT_STAGE_MAX) {
+        return;
+    }
+
+    int64_t now = esp_timer_get_time();
+    bool first = false;
+    int64_t drive_us = 0;
+    int64_t controller_us = 0;
+
+    portENTER_CRITICAL(&boot_mux);
+    if (stage_us[stage] == 0) {
+        stage_us[stage] = now;
+        first = true;
+        drive_us = stage_us[RC_TANK_BOOT_DRIVE_READY];
+        controller_us = stage_us[RC_TANK_BOOT_CONTROLLER];
+    }
+    portEXIT_CRITICAL(&boot_mux);
+
+    if (!first) {
+        return;
+    }
+    ESP_LOGI(TAG, "BOOT %-16s %6ld ms", stage_names[stage], (long)(now / 1000));
+
+    // 구동 준비와 게임패드 준비가 모두 끝난 시점이 처음 조종 가능한 시점
+    if ((stage == RC_TANK_BOOT_DRIVE_READY || stage == RC_TANK_BOOT_CONTROLLER) && drive_us != 0 &&
+        controller_us != 0) {
+        ESP_LOGI(TAG, "First controllable drive at %ld ms", (long)(now / 1000));
+    }
+}
+
+bool rc_tank_boot_is_ready(void) {
+    return boot_ready;
+}
+
+// 액추에이터 -> 설정 -> 효과/제어 루프 순으로 초기화. 블루투스 초기화와 동시에 실행된다.
+static void boot_task(void* arg) {
+    // DFPlayer 는 UART 설정만 하고 부팅 대기는 드라이버 태스크에서 진행
+    dfplayer_init();
+    rc_tank_boot_mark(RC_TANK_BOOT_DFPLAYER);
+
+    rc_tank_init();
+    rc_tank_boot_mark(RC_TANK_BOOT_ACTUATORS);
+
+    // 저장된 설정 적용 (속도 배율, 데드존, 볼륨, 가감속, 서보 보정)
+    rc_tank_settings_init();
+    rc_tank_boot_mark(RC_TANK_BOOT_SETTINGS);
+
+    rc_tank_effects_init();
+    rc_tank_record_init();
+    rc_tank_loop_init();
+    boot_ready = true;
+    rc_tank_boot_mark(RC_TANK_BOOT_DRIVE_READY);
+
+    vTaskDelete(NULL);
+}
+
+void rc_tank_boot_start(void) {
+    rc_tank_boot_mark(RC_TANK_BOOT_APP_MAIN);
+
+    // NVS 는 BTstack 과 부팅 태스크가 함께 쓰므로 동시에 초기화되지 않도록 먼저 처리
+    esp_err_t ret = nvs_flash_init();
+    if (ret == ESP_ERR_NVS_NO_FREE_PAGES || ret == ESP_ERR_NVS_NEW_VERSION_FOUND) {
+        ESP_ERROR_CHECK(nvs_flash_erase());
+        ret = nvs_flash_init();
+    }
+    ESP_ERROR_CHECK(ret);
+    rc_tank_boot_mark(RC_TANK_BOOT_NVS);
+
+    // 게임패드 콜백이 먼저 올 수 있으므로 좌석별 입력 스냅샷은 바로 초기화
+    rc_tank_crew_init();
+
+    if (xTaskCreate(boot_task, "tank_boot", RC_TANK_BOOT_TASK_STACK, NULL, RC_TANK_BOOT_TASK_PRIORITY, NULL) !=
+        pdPASS) {
+        ESP_LOGE(TAG, "Boot task creation failed, initializing inline");
+        boot_task(NULL);
+    }
+}
+
+void rc_tank_boot_print_timeline(void) {
+    int64_t snapshot[RC_TANK_BOOT_STAGE_MAX];
+    portENTER_CRITICAL(&boot_mux);
+    for (int i = 0; i < RC_TANK_BOOT_STAGE_MAX; i++) {
+        snapshot[i] = stage_us[i];
+    }
+    portEXIT_CRITICAL(&boot_mux);
+
+    printf("Boot timeline:\n");
+    for (int i = 0; i < RC_TANK_BOOT_STAGE_MAX; i++) {
+        if (snapshot[i] != 0) {
+            printf("  %-16s %6ld ms\n", stage_names[i], (long)(snapshot[i] / 1000));
+        } else {
+            printf("  %-16s      -\n", stage_names[i]);
+        }
+    }
+}
+
+static int cmd_tank_boot(int argc, char** argv) {
+    rc_tank_boot_print_timeline();
+    return 0;
+}
+
+void rc_tank_boot_register_cmds(void) {
+    const esp_console_cmd_t boot_cmd = {
+        .command = "tank_boot",
+        .help = "Shows the boot timeline (time since reset for each stage)",
+        .hint = NULL,
+        .func = &cmd_tank_boot,
+    };
+
+    ESP_ERROR_CHECK(esp_console_cmd_register(&boot_cmd));
+}
@@ -0,0 +1,37 @@
+#ifndef RC_TANK_BOOT_H
+#define RC_TANK_BOOT_H
+
+#include <stdint.h>
+#include <stdbool.h>
+
+// 부팅 태스크 설정
+#define RC_TANK_BOOT_TASK_STACK    4096
+#define RC_TANK_BOOT_TASK_PRIORITY 5
+
+// 부팅 단계 (타임라인에 표시되는 순서)
+typedef enum {
+    RC_TANK_BOOT_APP_MAIN = 0,      // app_main 진입
+    RC_TANK_BOOT_NVS,               // NVS 초기화 완료
+    RC_TANK_BOOT_BTSTACK,           // btstack_init 완료
+    RC_TANK_BOOT_UNI_INIT,          // uni_init 완료
+    RC_TANK_BOOT_DFPLAYER,          // DFPlayer UART/드라이버 태스크 시작
+    RC_TANK_BOOT_ACTUATORS,         // GPIO/LEDC/MCPWM 초기화 완료
+    RC_TANK_BOOT_SETTINGS,          // 저장된 설정 적용
+    RC_TANK_BOOT_DRIVE_READY,       // 효과/제어 루프 시작, 구동 가능
+    RC_TANK_BOOT_DFPLAYER_ONLINE,   // DFPlayer 부팅 완료 (또는 대기 시간 초과)
+    RC_TANK_BOOT_CONTROLLER,        // 첫 게임패드 준비 완료
+    RC_TANK_BOOT_STAGE_MAX
+} rc_tank_boot_stage_t;
+
+// 함수 선언
+// app_main 에서 btstack_init 전에 호출. NVS 초기화 후 액추에이터/DFPlayer 초기화를
+// 부팅 태스크에서 블루투스 초기화와 동시에 진행한다.
+void rc_tank_boot_start(void);
+// 단계 도달 시각 기록 (단계별 첫 호출만 기록)
+void rc_tank_boot_mark(rc_tank_boot_stage_t stage);
+// 액추에이터/제어 루프 초기화가 끝났는지
+bool rc_tank_boot_is_ready(void);
+void rc_tank_boot_print_timeline(void);
+void rc_tank_boot_register_cmds(void);
+
+#endif // RC_TANK_BOOT_H
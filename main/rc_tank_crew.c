@@ -0,0 +1,113 @@
+#include "rc_tank_crew.h"
+#include "esp_console.h"
+#include <stdio.h>
+
+// 좌석별 입력 스냅샷 (BT 스레드에서 게시, 제어 루프/BT 스레드에서 읽음)
+static rc_tank_input_snapshot_t seat_input[RC_TANK_CREW_SEATS];
+
+// 역할별 좌석 우선순위. 앞 좌석의 입력이 활성이면 그 좌석이 역할을 맡는다.
+static const uint8_t role_priority[RC_TANK_ROLE_MAX][RC_TANK_CREW_SEATS] = {
+    [RC_TANK_ROLE_TRACKS] = {RC_TANK_SEAT_DRIVER, RC_TANK_SEAT_GUNNER},
+    [RC_TANK_ROLE_TURRET] = {RC_TANK_SEAT_GUNNER, RC_TANK_SEAT_DRIVER},
+    [RC_TANK_ROLE_WEAPONS] = {RC_TANK_SEAT_GUNNER, RC_TANK_SEAT_DRIVER},
+};
+
+static const char* const seat_names[RC_TANK_CREW_SEATS] = {"driver", "gunner"};
+static const char* const role_names[RC_TANK_ROLE_MAX] = {"tracks", "turret", "weapons"};
+
+void rc_tank_crew_init(void) {
+    for (int i = 0; i < RC_TANK_CREW_SEATS; i++) {
+        rc_tank_input_snapshot_init(&seat_input[i]);
+        seat_input[i].data[0].link = -1;
+        seat_input[i].data[1].link = -1;
+    }
+}
+
+void rc_tank_crew_publish(uint8_t seat, const rc_tank_input_t* input) {
+    if (seat >= RC_TANK_CREW_SEATS) {
+        return;
+    }
+    rc_tank_input_snapshot_publish(&seat_input[seat], input);
+}
+
+static int role_seat(rc_tank_role_t role, const rc_tank_input_t inputs[RC_TANK_CREW_SEATS]) {
+    for (int i = 0; i < RC_TANK_CREW_SEATS; i++) {
+        uint8_t seat = role_priority[role][i];
+        if (inputs[seat].active) {
+            return seat;
+        }
+    }
+    return -1;
+}
+
+int rc_tank_crew_role_seat(rc_tank_role_t role) {
+    rc_tank_input_t inputs[RC_TANK_CREW_SEATS];
+    if (role >= RC_TANK_ROLE_MAX) {
+        return -1;
+    }
+    for (int i = 0; i < RC_TANK_CREW_SEATS; i++) {
+        rc_tank_input_snapshot_read(&seat_input[i], &inputs[i]);
+    }
+    return role_seat(role, inputs);
+}
+
+int rc_tank_crew_merge(rc_tank_input_t* out, int8_t links[RC_TANK_CREW_LINKS]) {
+    rc_tank_input_t inputs[RC_TANK_CREW_SEATS];
+    for (int i = 0; i < RC_TANK_CREW_SEATS; i++) {
+        rc_tank_input_snapshot_read(&seat_input[i], &inputs[i]);
+    }
+
+    *out = (rc_tank_input_t){.link = -1};
+    int count = 0;
+
+    int tracks = role_seat(RC_TANK_ROLE_TRACKS, inputs);
+    if (tracks >= 0) {
+        out->axis_y = inputs[tracks].axis_y;
+        out->axis_ry = inputs[tracks].axis_ry;
+        out->axis_x = inputs[tracks].axis_x;
+        out->axis_rx = inputs[tracks].axis_rx;
+        out->throttle = inputs[tracks].throttle;
+        out->brake = inputs[tracks].brake;
+        out->link = inputs[tracks].link;
+        out->active = true;
+        if (inputs[tracks].link >= 0) links[count++] = inputs[tracks].link;
+    }
+
+    int turret = role_seat(RC_TANK_ROLE_TURRET, inputs);
+    if (turret >= 0) {
+        out->dpad_x = inputs[turret].dpad_x;
+        out->dpad_y = inputs[turret].dpad_y;
+        out->active = true;
+        if (inputs[turret].link >= 0) links[count++] = inputs[turret].link;
+    }
+    return count;
+}
+
+static int cmd_tank_crew(int argc, char** argv) {
+    rc_tank_input_t inputs[RC_TANK_CREW_SEATS];
+    for (int i = 0; i < RC_TANK_CREW_SEATS; i++) {
+        uint32_t seq = rc_tank_input_snapshot_read(&seat_input[i], &inputs[i]);
+        if (inputs[i].active) {
+            printf("Seat %c (%s): link %d, %lu updates\n", 'A' + i, seat_names[i], inputs[i].link,
+                   (unsigned long)seq);
+        } else {
+            printf("Seat %c (%s): empty\n", 'A' + i, seat_names[i]);
+        }
+    }
+    for (int r = 0; r < RC_TANK_ROLE_MAX; r++) {
+        int seat = role_seat((rc_tank_role_t)r, inputs);
+        printf("  %-8s -> %s\n", role_names[r], seat >= 0 ? seat_names[seat] : "-");
+    }
+    return 0;
+}
+
+void rc_tank_crew_register_cmds(void) {
+    const esp_console_cmd_t crew_cmd = {
+        .command = "tank_crew",
+        .help = "Shows which controller seat currently owns the tracks, turret and weapons",
+        .hint = NULL,
+        .func = &cmd_tank_crew,
+    };
+
+    ESP_ERROR_CHECK(esp_console_cmd_register(&crew_cmd));
+}
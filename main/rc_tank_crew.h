@@ -0,0 +1,38 @@
+#ifndef RC_TANK_CREW_H
+#define RC_TANK_CREW_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "rc_tank_snapshot.h"
+
+// 승무원 모드: 게임패드 두 개가 한 탱크를 나눠 조종한다.
+// 좌석마다 입력 스냅샷이 따로 있어 두 컨트롤러가 서로 잠금 없이 전체 주기로 게시하고,
+// 제어 루프가 역할별 우선순위 표에 따라 한 입력으로 합친다.
+// 역할의 담당 좌석 = 우선순위 표에서 입력이 활성인 첫 좌석 (혼자 타면 모든 역할을 맡는다)
+#define RC_TANK_CREW_SEATS  2
+#define RC_TANK_CREW_LINKS  2   // 링크를 내는 역할 수 (트랙, 터렛)
+
+typedef enum {
+    RC_TANK_SEAT_DRIVER = 0,   // 좌석 A: 트랙
+    RC_TANK_SEAT_GUNNER,       // 좌석 B: 터렛/마운트/무장
+} rc_tank_seat_t;
+
+typedef enum {
+    RC_TANK_ROLE_TRACKS = 0,   // 좌/우 트랙, 속도 배율
+    RC_TANK_ROLE_TURRET,       // 터렛 회전, 마운트 각도
+    RC_TANK_ROLE_WEAPONS,      // 포/기관총
+    RC_TANK_ROLE_MAX
+} rc_tank_role_t;
+
+// 함수 선언
+void rc_tank_crew_init(void);
+// BT 스레드: 좌석 입력 게시 (좌석마다 writer 는 하나)
+void rc_tank_crew_publish(uint8_t seat, const rc_tank_input_t* input);
+// 역할을 맡은 좌석. 입력이 활성인 좌석이 없으면 -1
+int rc_tank_crew_role_seat(rc_tank_role_t role);
+// 제어 루프: 역할별 담당 좌석의 입력을 합쳐 out 에 채우고, 입력에 관여한 링크 번호를 links 에 채워
+// 그 수를 반환 (역할마다 하나, 같은 링크가 두 번 들어갈 수 있다)
+int rc_tank_crew_merge(rc_tank_input_t* out, int8_t links[RC_TANK_CREW_LINKS]);
+void rc_tank_crew_register_cmds(void);
+
+#endif // RC_TANK_CREW_H
@@ -0,0 +1,240 @@
+#include "rc_tank_drive.h"
+#include "rc_tank_fixed.h"
+#include "rc_tank_settings.h"
+#include "esp_console.h"
+#include "esp_log.h"
+#include "freertos/FreeRTOS.h"
+#include <stdatomic.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+static const char* TAG = "RC_TANK_DRIVE";
+
+#define AXIS_MIN     (-512)
+#define TRIGGER_MAX  1023
+
+// 모드와 곡선 표는 함께 바뀌어야 하므로 한 묶음으로 둔다.
+// 설정 변경 (콘솔, BT 콜백, 설정 로드) 은 요청 설정만 drive_mux 안에서 바꾸고 config_seq 를 올린다.
+// 표는 제어 루프만 읽고 쓴다: 틱 시작에 config_seq 가 바뀌었으면 요청 설정을 복사해 표를 다시 계산한다.
+// 루프가 표를 읽는 동안 다른 태스크가 표를 덮어쓰는 일이 없다.
+typedef struct {
+    uint8_t mode;
+    int16_t throttle[RC_TANK_DRIVE_LUT_SIZE];  // 전후진 (탱크 모드는 좌/우 트랙 모두)
+    int16_t steer[RC_TANK_DRIVE_LUT_SIZE];     // 회전/곡률
+} drive_table_t;
+
+static drive_table_t table;            // 제어 루프 전용
+static unsigned table_seq = 0;         // 표를 계산한 요청 설정의 config_seq (제어 루프 전용)
+
+static portMUX_TYPE drive_mux = portMUX_INITIALIZER_UNLOCKED;
+static rc_tank_drive_config_t current_config = RC_TANK_DRIVE_DEFAULT_CONFIG;
+static uint16_t current_deadzone = RC_TANK_DEADZONE_Q15;
+static atomic_uint config_seq = 1;     // 0 이 아니므로 첫 틱에 기본 설정으로 표를 만든다
+static bool configured = false;
+
+static const char* const mode_names[RC_TANK_DRIVE_MODE_MAX] = {"tank", "arcade", "curvature", "triggers"};
+
+// 데드존 -> 엑스포: (1 - e) * x + e * x^3
+static int16_t curve_q15(int32_t q, int32_t deadzone, int32_t expo_q8) {
+    q = rc_tank_q15_deadzone(q, deadzone);
+    int32_t cube = (int32_t)((((int64_t)q * q >> 15) * q) >> 15);
+    return (int16_t)(((RC_TANK_GAIN_Q8_ONE - expo_q8) * q + expo_q8 * cube) >> 8);
+}
+
+static int32_t expo_to_q8(uint8_t expo_pct) {
+    return (expo_pct > 100 ? 100 : expo_pct) * RC_TANK_GAIN_Q8_ONE / 100;
+}
+
+static void build_curve(int16_t* lut, int32_t deadzone, uint8_t expo_pct) {
+    int32_t expo_q8 = expo_to_q8(expo_pct);
+    for (int i = 0; i < RC_TANK_DRIVE_LUT_SIZE; i++) {
+        lut[i] = curve_q15(rc_tank_axis_to_q15(i + AXIS_MIN), deadzone, expo_q8);
+    }
+}
+
+static uint8_t valid_mode(uint8_t mode) {
+    return mode < RC_TANK_DRIVE_MODE_MAX ? mode : RC_TANK_DRIVE_TANK;
+}
+
+static int32_t clamp_deadzone(uint16_t deadzone_q15) {
+    return (deadzone_q15 > RC_TANK_Q15_MAX) ? RC_TANK_Q15_MAX : deadzone_q15;
+}
+
+void rc_tank_drive_set_config(const rc_tank_drive_config_t* config, uint16_t deadzone_q15) {
+    rc_tank_drive_config_t c = *config;
+    c.mode = valid_mode(c.mode);
+
+    portENTER_CRITICAL(&drive_mux);
+    bool changed =
+        !configured || memcmp(&c, &current_config, sizeof(c)) != 0 || deadzone_q15 != current_deadzone;
+    if (changed) {
+        current_config = c;
+        current_deadzone = deadzone_q15;
+        configured = true;
+        atomic_fetch_add_explicit(&config_seq, 1, memory_order_release);
+    }
+    portEXIT_CRITICAL(&drive_mux);
+
+    if (changed) {
+        ESP_LOGI(TAG, "Drive mode: %s (expo %u%%/%u%%)", mode_names[c.mode], c.throttle_expo, c.steer_expo);
+    }
+}
+
+static void get_config(rc_tank_drive_config_t* config, uint16_t* deadzone_q15) {
+    portENTER_CRITICAL(&drive_mux);
+    *config = current_config;
+    *deadzone_q15 = current_deadzone;
+    portEXIT_CRITICAL(&drive_mux);
+}
+
+// 요청 설정이 바뀌었으면 표를 다시 계산 (제어 루프에서만)
+static void update_table(void) {
+    unsigned seq = atomic_load_explicit(&config_seq, memory_order_acquire);
+    if (seq == table_seq) {
+        return;
+    }
+    rc_tank_drive_config_t c;
+    uint16_t deadzone_q15;
+    get_config(&c, &deadzone_q15);
+
+    table.mode = c.mode;
+    build_curve(table.throttle, clamp_deadzone(deadzone_q15), c.throttle_expo);
+    build_curve(table.steer, clamp_deadzone(deadzone_q15), c.steer_expo);
+    // seq 를 읽은 뒤 또 바뀌었다면 새 설정을 이미 복사했더라도 다음 틱에 한 번 더 계산한다
+    table_seq = seq;
+}
+
+rc_tank_drive_mode_t rc_tank_drive_get_mode(void) {
+    rc_tank_drive_config_t c;
+    uint16_t deadzone_q15;
+    get_config(&c, &deadzone_q15);
+    return (rc_tank_drive_mode_t)c.mode;
+}
+
+const char* rc_tank_drive_mode_name(rc_tank_drive_mode_t mode) {
+    return mode < RC_TANK_DRIVE_MODE_MAX ? mode_names[mode] : "?";
+}
+
+static inline int axis_index(int32_t axis) {
+    int32_t i = axis - AXIS_MIN;
+    return i < 0 ? 0 : (i >= RC_TANK_DRIVE_LUT_SIZE ? RC_TANK_DRIVE_LUT_SIZE - 1 : i);
+}
+
+// 트리거 (0 ~ 1023) 는 같은 곡선의 양수 절반을 쓴다
+static inline int trigger_index(int32_t value) {
+    int32_t v = value < 0 ? 0 : (value > TRIGGER_MAX ? TRIGGER_MAX : value);
+    return -AXIS_MIN + (v >> 1);
+}
+
+void rc_tank_drive_mix(const rc_tank_input_t* input, int32_t* left_q15, int32_t* right_q15) {
+    update_table();
+    const drive_table_t* t = &table;
+    int32_t left, right;
+
+    // 회전 부호: 스틱을 오른쪽으로 밀면 좌 트랙이 전진 방향 (스틱 위 = 음수) 으로 더 빨라진다
+    switch (t->mode) {
+        case RC_TANK_DRIVE_ARCADE: {
+            int32_t throttle = t->throttle[axis_index(input->axis_y)];
+            int32_t turn = t->steer[axis_index(input->axis_x)];
+            left = throttle - turn;
+            right = throttle + turn;
+            break;
+        }
+        case RC_TANK_DRIVE_CURVATURE: {
+            int32_t throttle = t->throttle[axis_index(input->axis_y)];
+            int32_t curvature = t->steer[axis_index(input->axis_rx)];
+            int32_t magnitude = abs(throttle) > RC_TANK_DRIVE_PIVOT_Q15 ? abs(throttle) : RC_TANK_DRIVE_PIVOT_Q15;
+            int32_t turn = (curvature * magnitude) >> 15;
+            left = throttle - turn;
+            right = throttle + turn;
+            break;
+        }
+        case RC_TANK_DRIVE_TRIGGERS: {
+            // 오른쪽 트리거 = 스틱을 위로 민 것과 같은 방향
+            int32_t throttle = t->throttle[trigger_index(input->brake)] - t->throttle[trigger_index(input->throttle)];
+            int32_t turn = t->steer[axis_index(input->axis_x)];
+            left = throttle - turn;
+            right = throttle + turn;
+            break;
+        }
+        case RC_TANK_DRIVE_TANK:
+        default:
+            left = t->throttle[axis_index(input->axis_y)];
+            right = t->throttle[axis_index(input->axis_ry)];
+            break;
+    }
+
+    // 범위를 넘으면 좌우 비율 (회전 반경) 을 유지한 채 줄인다
+    int32_t peak = abs(left) > abs(right) ? abs(left) : abs(right);
+    if (peak > RC_TANK_Q15_MAX) {
+        left = left * RC_TANK_Q15_MAX / peak;
+        right = right * RC_TANK_Q15_MAX / peak;
+    }
+    *left_q15 = left;
+    *right_q15 = right;
+}
+
+static void update_settings(const rc_tank_drive_config_t* c) {
+    rc_tank_settings_t s;
+    rc_tank_settings_get(&s);
+    s.drive = *c;
+    rc_tank_settings_set(&s);
+}
+
+static int cmd_tank_drive(int argc, char** argv) {
+    rc_tank_drive_config_t c;
+    uint16_t deadzone_q15;
+    get_config(&c, &deadzone_q15);
+
+    if (argc >= 3 && strcmp(argv[1], "mode") == 0) {
+        for (int i = 0; i < RC_TANK_DRIVE_MODE_MAX; i++) {
+            if (strcmp(argv[2], mode_names[i]) == 0) {
+                c.mode = (uint8_t)i;
+                update_settings(&c);
+                return 0;
+            }
+        }
+        printf("Unknown mode: %s\n", argv[2]);
+        return 1;
+    }
+    if (argc >= 4 && strcmp(argv[1], "expo") == 0) {
+        int throttle = atoi(argv[2]);
+        int steer = atoi(argv[3]);
+        c.throttle_expo = (uint8_t)(throttle < 0 ? 0 : (throttle > 100 ? 100 : throttle));
+        c.steer_expo = (uint8_t)(steer < 0 ? 0 : (steer > 100 ? 100 : steer));
+        update_settings(&c);
+        return 0;
+    }
+    if (argc >= 2) {
+        printf("Unknown arguments\n");
+        return 1;
+    }
+
+    // 표는 제어 루프 전용이므로 같은 곡선을 여기서 계산해 보인다
+    int32_t deadzone = clamp_deadzone(deadzone_q15);
+    int32_t throttle_q8 = expo_to_q8(c.throttle_expo);
+    int32_t steer_q8 = expo_to_q8(c.steer_expo);
+    printf("Drive: mode=%s, expo throttle=%u%% steer=%u%%, deadzone=%u (Q15)\n", mode_names[c.mode],
+           c.throttle_expo, c.steer_expo, deadzone_q15);
+    printf("  %6s %8s %8s\n", "axis", "throttle", "steer");
+    for (int axis = 0; axis <= 512; axis += 64) {
+        int32_t q = rc_tank_axis_to_q15(axis_index(axis) + AXIS_MIN);
+        printf("  %6d %8d %8d\n", axis, curve_q15(q, deadzone, throttle_q8), curve_q15(q, deadzone, steer_q8));
+    }
+    return 0;
+}
+
+void rc_tank_drive_register_cmds(void) {
+    const esp_console_cmd_t drive_cmd = {
+        .command = "tank_drive",
+        .help =
+            "Shows or changes the drive mixing mode and stick curves.\n"
+            "  'tank_drive mode <tank|arcade|curvature|triggers>' switches the mixer,\n"
+            "  'tank_drive expo <throttle%> <steer%>' sets the expo curves (0 = linear)",
+        .hint = "[mode <name> | expo <throttle%> <steer%>]",
+        .func = &cmd_tank_drive,
+    };
+
+    ESP_ERROR_CHECK(esp_console_cmd_register(&drive_cmd));
+}
@@ -0,0 +1,43 @@
+#ifndef RC_TANK_DRIVE_H
+#define RC_TANK_DRIVE_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "rc_tank_snapshot.h"
+
+// 주행 혼합 (입력 -> 좌/우 트랙 명령)
+// 데드존/엑스포 곡선은 설정이 바뀔 때 축 전 범위 (-512 ~ 511) 에 대한 1024칸 표로 미리 계산해 두고,
+// 제어 틱에서는 표를 찾아 더하고 곱하기만 한다. 어느 모드든 틱당 비용이 같다.
+#define RC_TANK_DRIVE_LUT_SIZE     1024
+#define RC_TANK_DRIVE_PIVOT_Q15    16384   // 곡률 주행: 정지 상태에서도 이 비율 (0.5) 만큼 제자리 회전
+
+typedef enum {
+    RC_TANK_DRIVE_TANK = 0,    // 좌측 스틱 Y -> 좌 트랙, 우측 스틱 Y -> 우 트랙
+    RC_TANK_DRIVE_ARCADE,      // 좌측 스틱 하나: Y 전후진, X 회전
+    RC_TANK_DRIVE_CURVATURE,   // 좌측 스틱 Y 전후진, 우측 스틱 X 곡률 (회전량이 속도에 비례)
+    RC_TANK_DRIVE_TRIGGERS,    // 오른쪽 트리거 전진, 왼쪽 트리거 후진, 좌측 스틱 X 회전
+    RC_TANK_DRIVE_MODE_MAX
+} rc_tank_drive_mode_t;
+
+// 설정 (rc_tank_settings 에 저장). 데드존은 설정의 deadzone_q15 를 함께 쓴다
+typedef struct {
+    uint8_t mode;            // rc_tank_drive_mode_t
+    uint8_t throttle_expo;   // 전후진 곡선 (0 ~ 100%, 0 = 직선)
+    uint8_t steer_expo;      // 회전 곡선
+    uint8_t reserved;
+} rc_tank_drive_config_t;
+
+// 기본값: 기존 탱크 조종 (직선), 회전은 중앙 부근을 부드럽게
+#define RC_TANK_DRIVE_DEFAULT_CONFIG {RC_TANK_DRIVE_TANK, 0, 30, 0}
+
+// 함수 선언
+// 요청 설정만 바꾼다 (어느 태스크에서나). 제어 루프가 다음 틱에 곡선 표를 다시 계산해 적용한다
+void rc_tank_drive_set_config(const rc_tank_drive_config_t* config, uint16_t deadzone_q15);
+// 요청된 모드 (표에 아직 반영되지 않았을 수 있다)
+rc_tank_drive_mode_t rc_tank_drive_get_mode(void);
+const char* rc_tank_drive_mode_name(rc_tank_drive_mode_t mode);
+// 제어 루프: 입력을 좌/우 트랙 명령 (Q15) 으로 혼합. 곡선 표를 읽고 쓰는 유일한 곳이다
+void rc_tank_drive_mix(const rc_tank_input_t* input, int32_t* left_q15, int32_t* right_q15);
+void rc_tank_drive_register_cmds(void);
+
+#endif // RC_TANK_DRIVE_H
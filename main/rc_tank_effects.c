@@ -0,0 +1,222 @@
+#include "rc_tank_effects.h"
+#include "rc_tank.h"
+#include "dfplayer.h"
+#include "rc_tank_hal.h"
+#include "rc_tank_haptics.h"
+#include "esp_log.h"
+#include "esp_timer.h"
+#include "freertos/FreeRTOS.h"
+#include "freertos/queue.h"
+#include "freertos/task.h"
+
+static const char* TAG = "RC_TANK_FX";
+
+// 키프레임 동작
+typedef enum {
+    FX_ACTION_CANNON_LED = 0,   // arg: 0/1
+    FX_ACTION_CANNON_ANGLE,     // arg: 각도
+    FX_ACTION_SOUND,            // arg: 파일 번호
+    FX_ACTION_HEADLIGHT_TOGGLE, // arg: 사용 안 함
+    FX_ACTION_END,              // 시퀀스 종료
+} fx_action_t;
+
+// 키프레임: 이전 키프레임으로부터 delay_ms 후에 action 실행
+typedef struct {
+    uint16_t delay_ms;
+    uint8_t action;
+    uint8_t arg;
+} fx_keyframe_t;
+
+// 포신 발사: LED 5회 깜빡임 (50ms 간격) -> 효과음 -> 포신 당기기 500ms 유지
+static const fx_keyframe_t cannon_fire_frames[] = {
+    {0, FX_ACTION_CANNON_LED, 1},   {50, FX_ACTION_CANNON_LED, 0},
+    {50, FX_ACTION_CANNON_LED, 1},  {50, FX_ACTION_CANNON_LED, 0},
+    {50, FX_ACTION_CANNON_LED, 1},  {50, FX_ACTION_CANNON_LED, 0},
+    {50, FX_ACTION_CANNON_LED, 1},  {50, FX_ACTION_CANNON_LED, 0},
+    {50, FX_ACTION_CANNON_LED, 1},  {50, FX_ACTION_CANNON_LED, 0},
+    {50, FX_ACTION_SOUND, SOUND_CANNON_FIRE},
+    {0, FX_ACTION_CANNON_ANGLE, 45},
+    {500, FX_ACTION_CANNON_ANGLE, 0},
+    {0, FX_ACTION_END, 0},
+};
+
+// 기관총: 효과음 + 포신 LED 500ms 간격 점멸, 3초 후 종료
+static const fx_keyframe_t machine_gun_frames[] = {
+    {0, FX_ACTION_SOUND, SOUND_MACHINE_GUN},
+    {0, FX_ACTION_CANNON_LED, 1},   {500, FX_ACTION_CANNON_LED, 0},
+    {500, FX_ACTION_CANNON_LED, 1}, {500, FX_ACTION_CANNON_LED, 0},
+    {500, FX_ACTION_CANNON_LED, 1}, {500, FX_ACTION_CANNON_LED, 0},
+    {500, FX_ACTION_END, 0},
+};
+
+// 헤드라이트: 토글 후 디바운싱 시간 동안 슬롯을 점유
+static const fx_keyframe_t headlight_toggle_frames[] = {
+    {0, FX_ACTION_HEADLIGHT_TOGGLE, 0},
+    {RC_TANK_HEADLIGHT_DEBOUNCE_MS, FX_ACTION_END, 0},
+};
+
+static const fx_keyframe_t* const sequences[RC_TANK_EFFECT_MAX] = {
+    [RC_TANK_EFFECT_CANNON_FIRE] = cannon_fire_frames,
+    [RC_TANK_EFFECT_MACHINE_GUN] = machine_gun_frames,
+    [RC_TANK_EFFECT_HEADLIGHT_TOGGLE] = headlight_toggle_frames,
+};
+
+// 효과가 실제로 시작될 때 보내는 진동 (-1: 없음)
+static const int8_t start_haptics[RC_TANK_EFFECT_MAX] = {
+    [RC_TANK_EFFECT_CANNON_FIRE] = RC_TANK_HAPTIC_CANNON_RECOIL,
+    [RC_TANK_EFFECT_MACHINE_GUN] = RC_TANK_HAPTIC_MACHINE_GUN,
+    [RC_TANK_EFFECT_HEADLIGHT_TOGGLE] = -1,
+};
+
+// 재생 슬롯 (효과 태스크에서만 수정)
+typedef struct {
+    const fx_keyframe_t* frames;
+    uint8_t index;
+    int64_t due_us;
+    volatile bool active;
+} fx_slot_t;
+
+// 큐 명령
+#define FX_CMD_CANCEL_ALL 0xFF
+
+typedef struct {
+    uint8_t cmd;           // rc_tank_effect_t 또는 FX_CMD_CANCEL_ALL
+    uint8_t haptic_seats;  // 시작 진동을 받을 좌석 마스크
+} fx_cmd_t;
+
+static fx_slot_t slots[RC_TANK_EFFECT_MAX];
+static QueueHandle_t fx_queue = NULL;
+
+static void fx_run_action(const fx_keyframe_t* kf) {
+    switch (kf->action) {
+        case FX_ACTION_CANNON_LED:
+            rc_tank_hal_set_led(RC_TANK_HAL_LED_CANNON, kf->arg);
+            break;
+        case FX_ACTION_CANNON_ANGLE:
+            rc_tank_set_cannon_angle(kf->arg);
+            break;
+        case FX_ACTION_SOUND:
+            dfplayer_play_sound(kf->arg);
+            break;
+        case FX_ACTION_HEADLIGHT_TOGGLE:
+            rc_tank_toggle_headlight();
+            break;
+        default:
+            break;
+    }
+}
+
+static void fx_start(rc_tank_effect_t effect, uint32_t haptic_seats, int64_t now) {
+    fx_slot_t* slot = &slots[effect];
+    if (slot->active) {
+        ESP_LOGD(TAG, "Effect %d already active, ignored", effect);
+        return;
+    }
+    slot->frames = sequences[effect];
+    slot->index = 0;
+    slot->due_us = now + (int64_t)slot->frames[0].delay_ms * 1000;
+    slot->active = true;
+
+    // 슬롯을 실제로 시작한 요청만 진동을 보낸다 (연속 입력으로 두 번 울리지 않게)
+    if (haptic_seats != 0 && start_haptics[effect] >= 0) {
+        rc_tank_haptics_post((rc_tank_haptic_t)start_haptics[effect], haptic_seats);
+    }
+}
+
+static void fx_cancel_all(void) {
+    for (int i = 0; i < RC_TANK_EFFECT_MAX; i++) {
+        slots[i].active = false;
+    }
+    rc_tank_hal_set_led(RC_TANK_HAL_LED_CANNON, false);
+    rc_tank_set_cannon_angle(0);
+}
+
+// 기한이 지난 키프레임을 실행하고 다음 기한을 반환
+static int64_t fx_advance(fx_slot_t* slot, int64_t now) {
+    while (slot->active && slot->due_us <= now) {
+        const fx_keyframe_t* kf = &slot->frames[slot->index];
+        if (kf->action == FX_ACTION_END) {
+            slot->active = false;
+            break;
+        }
+        fx_run_action(kf);
+        slot->index++;
+        // 지연 누적은 기한 기준으로 계산하여 스케줄 드리프트를 막는다
+        slot->due_us += (int64_t)slot->frames[slot->index].delay_ms * 1000;
+    }
+    return slot->active ? slot->due_us : INT64_MAX;
+}
+
+static void fx_task(void* arg) {
+    fx_cmd_t cmd;
+
+    for (;;) {
+        int64_t now = esp_timer_get_time();
+        int64_t next_due = INT64_MAX;
+        for (int i = 0; i < RC_TANK_EFFECT_MAX; i++) {
+            int64_t due = fx_advance(&slots[i], now);
+            if (due < next_due) next_due = due;
+        }
+
+        TickType_t wait = portMAX_DELAY;
+        if (next_due != INT64_MAX) {
+            int64_t wait_ms = (next_due - esp_timer_get_time() + 999) / 1000;
+            wait = (wait_ms > 0) ? pdMS_TO_TICKS(wait_ms) : 0;
+        }
+
+        if (xQueueReceive(fx_queue, &cmd, wait) == pdTRUE) {
+            if (cmd.cmd == FX_CMD_CANCEL_ALL) {
+                fx_cancel_all();
+            } else if (cmd.cmd < RC_TANK_EFFECT_MAX) {
+                fx_start((rc_tank_effect_t)cmd.cmd, cmd.haptic_seats, esp_timer_get_time());
+            }
+        }
+    }
+}
+
+void rc_tank_effects_init(void) {
+    fx_queue = xQueueCreate(RC_TANK_EFFECTS_QUEUE_LEN, sizeof(fx_cmd_t));
+    if (fx_queue == NULL) {
+        ESP_LOGE(TAG, "Effects queue creation failed");
+        return;
+    }
+
+    if (xTaskCreate(fx_task, "tank_fx", RC_TANK_EFFECTS_TASK_STACK, NULL, RC_TANK_EFFECTS_TASK_PRIORITY, NULL) !=
+        pdPASS) {
+        ESP_LOGE(TAG, "Effects task creation failed");
+        return;
+    }
+
+    ESP_LOGI(TAG, "Effects scheduler started");
+}
+
+bool rc_tank_effects_trigger(rc_tank_effect_t effect, uint32_t haptic_seats) {
+    if (fx_queue == NULL || effect >= RC_TANK_EFFECT_MAX) {
+        return false;
+    }
+    // 재생 중인 효과는 큐에 넣지 않는다. 큐에 들어간 요청끼리의 중복은 fx_start 가 걸러낸다
+    if (slots[effect].active) {
+        return false;
+    }
+    fx_cmd_t cmd = {.cmd = (uint8_t)effect, .haptic_seats = (uint8_t)haptic_seats};
+    if (xQueueSend(fx_queue, &cmd, 0) != pdTRUE) {
+        ESP_LOGW(TAG, "Effects queue full, effect %d dropped", effect);
+        return false;
+    }
+    return true;
+}
+
+bool rc_tank_effects_cancel_all(void) {
+    if (fx_queue == NULL) {
+        return false;
+    }
+    fx_cmd_t cmd = {.cmd = FX_CMD_CANCEL_ALL};
+    return xQueueSend(fx_queue, &cmd, 0) == pdTRUE;
+}
+
+bool rc_tank_effects_is_active(rc_tank_effect_t effect) {
+    if (effect >= RC_TANK_EFFECT_MAX) {
+        return false;
+    }
+    return slots[effect].active;
+}
@@ -0,0 +1,33 @@
+#ifndef RC_TANK_EFFECTS_H
+#define RC_TANK_EFFECTS_H
+
+#include <stdint.h>
+#include <stdbool.h>
+
+// 효과 태스크 설정
+#define RC_TANK_EFFECTS_TASK_STACK    3072
+#define RC_TANK_EFFECTS_TASK_PRIORITY 5
+#define RC_TANK_EFFECTS_QUEUE_LEN     8
+
+// 헤드라이트 토글 후 재입력 무시 시간 (디바운싱)
+#define RC_TANK_HEADLIGHT_DEBOUNCE_MS 200
+
+// 효과 종류. 효과마다 독립된 슬롯에서 키프레임 시퀀스가 재생된다.
+typedef enum {
+    RC_TANK_EFFECT_CANNON_FIRE = 0,   // 포신 LED 깜빡임 + 효과음 + 포신 반동
+    RC_TANK_EFFECT_MACHINE_GUN,       // 기관총 효과음 + LED 점멸 (3초)
+    RC_TANK_EFFECT_HEADLIGHT_TOGGLE,  // 헤드라이트 토글 + 디바운싱
+    RC_TANK_EFFECT_MAX
+} rc_tank_effect_t;
+
+// 함수 선언
+void rc_tank_effects_init(void);
+// 효과 시작 요청. 큐에 넣고 바로 반환하므로 BT 콜백에서 호출해도 된다.
+// 같은 효과가 재생 중이면 요청은 무시된다. 효과 태스크가 슬롯을 시작할 때
+// haptic_seats 의 좌석에 효과의 진동을 보낸다 (0: 진동 없음).
+bool rc_tank_effects_trigger(rc_tank_effect_t effect, uint32_t haptic_seats);
+// 재생 중인 모든 효과를 중단하고 LED/서보를 기본 상태로 되돌린다.
+bool rc_tank_effects_cancel_all(void);
+bool rc_tank_effects_is_active(rc_tank_effect_t effect);
+
+#endif // RC_TANK_EFFECTS_H
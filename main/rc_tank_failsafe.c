@@ -0,0 +1,262 @@
+#include "rc_tank_failsafe.h"
+#include "rc_tank_crew.h"
+#include "esp_console.h"
+#include "esp_log.h"
+#include "esp_timer.h"
+#include "freertos/FreeRTOS.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+static const char* TAG = "RC_TANK_FAILSAFE";
+
+// 이 이상 벌어진 간격은 통계에 넣지 않는다 (끊김이지 보고 주기가 아님)
+#define STATS_MAX_INTERVAL_US (RC_TANK_FAILSAFE_BRAKE_MS * 1000)
+// RSSI 조회 후 결과가 도착할 때까지의 여유
+#define RSSI_SETTLE_US        (50 * 1000)
+
+static const char* const stage_names[RC_TANK_FAILSAFE_STAGE_MAX] = {"ok", "clamp", "coast", "brake"};
+
+// 링크별 상태 (BT 스레드에서 갱신, 제어 루프에서 읽음. link_mux 로 보호)
+typedef struct {
+    bool connected;
+    bool on_change;
+    bool ble;
+    bool rssi_valid;
+    int8_t rssi;
+    uint32_t reports;
+    int64_t last_report_us;
+    int64_t rssi_query_us;
+    uint32_t mean_interval_us;
+    uint32_t jitter_us;
+} failsafe_link_t;
+
+// 입력 스냅샷의 링크 번호 (int8_t) 로 모든 기기를 나타낼 수 있어야 한다
+_Static_assert(RC_TANK_FAILSAFE_MAX_LINKS <= INT8_MAX, "rc_tank_input_t.link cannot hold every device index");
+
+static failsafe_link_t links[RC_TANK_FAILSAFE_MAX_LINKS];
+// 제어 루프가 마지막으로 판정한 링크들 (콘솔 표시용)
+static int8_t crew_links[RC_TANK_CREW_LINKS];
+static int crew_link_count = 0;
+static portMUX_TYPE link_mux = portMUX_INITIALIZER_UNLOCKED;
+
+static rc_tank_failsafe_config_t config = RC_TANK_FAILSAFE_DEFAULT_CONFIG;
+
+// 제어 루프 전용
+static rc_tank_failsafe_stage_t current_stage = RC_TANK_FAILSAFE_OK;
+static uint32_t stage_entries[RC_TANK_FAILSAFE_STAGE_MAX];
+
+void rc_tank_failsafe_set_config(const rc_tank_failsafe_config_t* new_config) {
+    rc_tank_failsafe_config_t c = *new_config;
+    // 단계 순서 보장: clamp <= coast <= brake
+    if (c.coast_ms < c.clamp_ms) c.coast_ms = c.clamp_ms;
+    if (c.brake_ms < c.coast_ms) c.brake_ms = c.coast_ms;
+
+    portENTER_CRITICAL(&link_mux);
+    config = c;
+    portEXIT_CRITICAL(&link_mux);
+}
+
+static bool link_valid(int link) {
+    return link >= 0 && link < RC_TANK_FAILSAFE_MAX_LINKS;
+}
+
+static bool link_is_weak(const failsafe_link_t* l) {
+    if (!l->rssi_valid) return false;
+    return l->rssi < (l->ble ? RC_TANK_FAILSAFE_RSSI_WEAK_BLE : RC_TANK_FAILSAFE_RSSI_WEAK_BREDR);
+}
+
+void rc_tank_failsafe_on_connect(int link, bool on_change) {
+    if (!link_valid(link)) return;
+
+    portENTER_CRITICAL(&link_mux);
+    links[link].on_change = on_change;
+    portEXIT_CRITICAL(&link_mux);
+}
+
+void rc_tank_failsafe_on_report(int link, int64_t now_us) {
+    if (!link_valid(link)) return;
+
+    portENTER_CRITICAL(&link_mux);
+    failsafe_link_t* l = &links[link];
+    if (l->connected && l->reports > 0) {
+        int64_t dt = now_us - l->last_report_us;
+        if (dt > 0 && dt < STATS_MAX_INTERVAL_US) {
+            // 평균은 1/8, 편차는 1/4 가중 이동 평균 (TCP RTT 추정과 같은 방식)
+            int32_t err = (int32_t)dt - (int32_t)l->mean_interval_us;
+            if (l->mean_interval_us == 0) {
+                l->mean_interval_us = (uint32_t)dt;
+            } else {
+                l->mean_interval_us = (uint32_t)((int32_t)l->mean_interval_us + err / 8);
+                l->jitter_us = (uint32_t)((int32_t)l->jitter_us + (abs(err) - (int32_t)l->jitter_us) / 4);
+            }
+        }
+    }
+    l->connected = true;
+    l->last_report_us = now_us;
+    l->reports++;
+    portEXIT_CRITICAL(&link_mux);
+}
+
+bool rc_tank_failsafe_rssi_due(int link, int64_t now_us) {
+    if (!link_valid(link)) return false;
+    bool query_rssi = false;
+
+    portENTER_CRITICAL(&link_mux);
+    failsafe_link_t* l = &links[link];
+    if (l->connected &&
+        (now_us - l->rssi_query_us >= RC_TANK_FAILSAFE_RSSI_PERIOD_MS * 1000LL || l->rssi_query_us == 0)) {
+        l->rssi_query_us = now_us;
+        query_rssi = true;
+    }
+    portEXIT_CRITICAL(&link_mux);
+
+    return query_rssi;
+}
+
+void rc_tank_failsafe_on_rssi(int link, int8_t rssi, bool ble, int64_t now_us) {
+    if (!link_valid(link)) return;
+
+    portENTER_CRITICAL(&link_mux);
+    failsafe_link_t* l = &links[link];
+    l->ble = ble;
+    // 연결 전 검색 결과로 채워진 값은 기준이 다르므로 첫 조회 결과가 도착한 후부터 사용
+    if (l->rssi_query_us != 0 && now_us - l->rssi_query_us >= RSSI_SETTLE_US) {
+        l->rssi = rssi;
+        l->rssi_valid = true;
+    }
+    portEXIT_CRITICAL(&link_mux);
+}
+
+void rc_tank_failsafe_on_disconnect(int link) {
+    if (!link_valid(link)) return;
+
+    portENTER_CRITICAL(&link_mux);
+    memset(&links[link], 0, sizeof(links[link]));
+    portEXIT_CRITICAL(&link_mux);
+}
+
+// link_mux 안에서 호출
+static rc_tank_failsafe_stage_t link_stage(const failsafe_link_t* l, int64_t now_us) {
+    int64_t age = now_us - l->last_report_us;
+    int64_t clamp_us = config.clamp_ms * 1000LL;
+    int64_t coast_us = config.coast_ms * 1000LL;
+    int64_t brake_us = config.brake_ms * 1000LL;
+    bool weak = link_is_weak(l);
+
+    // 변화 시에만 보고하는 링크는 보고가 멈춰도 입력이 유지된 것이다. 끊김은 연결 해제로 처리된다
+    if (l->on_change) {
+        return weak ? RC_TANK_FAILSAFE_CLAMP : RC_TANK_FAILSAFE_OK;
+    }
+
+    // 약한 링크는 더 빨리 포기한다
+    if (weak) {
+        clamp_us /= 2;
+        coast_us /= 2;
+        brake_us /= 2;
+    }
+
+    // 원래 보고가 드문 컨트롤러는 평균 + K * 편차 만큼 늦춰서 판정
+    int64_t expected = l->mean_interval_us + (int64_t)RC_TANK_FAILSAFE_JITTER_K * l->jitter_us;
+    int64_t shift = expected > clamp_us ? expected - clamp_us : 0;
+
+    if (age >= brake_us + shift) {
+        return RC_TANK_FAILSAFE_BRAKE;
+    } else if (age >= coast_us + shift) {
+        return RC_TANK_FAILSAFE_COAST;
+    } else if (age >= clamp_us + shift || weak) {
+        return RC_TANK_FAILSAFE_CLAMP;
+    }
+    return RC_TANK_FAILSAFE_OK;
+}
+
+rc_tank_failsafe_stage_t rc_tank_failsafe_update(const int8_t* crew, int count, int64_t now_us) {
+    rc_tank_failsafe_stage_t stage = RC_TANK_FAILSAFE_OK;
+
+    if (count > RC_TANK_CREW_LINKS) count = RC_TANK_CREW_LINKS;
+    portENTER_CRITICAL(&link_mux);
+    memcpy(crew_links, crew, count * sizeof(crew[0]));
+    crew_link_count = count;
+    // 승무원 중 가장 나쁜 링크를 따른다 (포수 입력이 끊겨도 터렛이 계속 돌지 않도록).
+    // 추적할 수 없는 링크 번호면 판정할 수 없으므로 즉시 정지
+    for (int i = 0; i < count; i++) {
+        int link = crew[i];
+        rc_tank_failsafe_stage_t s = RC_TANK_FAILSAFE_BRAKE;
+        if (link_valid(link)) {
+            if (!links[link].connected) continue;
+            s = link_stage(&links[link], now_us);
+        }
+        if (s > stage) stage = s;
+    }
+    portEXIT_CRITICAL(&link_mux);
+
+    if (stage != current_stage) {
+        if (stage > current_stage) {
+            ESP_LOGW(TAG, "Input stale: %s -> %s", stage_names[current_stage], stage_names[stage]);
+        } else {
+            ESP_LOGI(TAG, "Input recovered: %s -> %s", stage_names[current_stage], stage_names[stage]);
+        }
+        stage_entries[stage]++;
+        current_stage = stage;
+    }
+    return stage;
+}
+
+uint8_t rc_tank_failsafe_clamp_speed(void) {
+    return config.clamp_speed;
+}
+
+void rc_tank_failsafe_get_link_stats(int link, rc_tank_failsafe_link_stats_t* out) {
+    memset(out, 0, sizeof(*out));
+    if (!link_valid(link)) return;
+
+    int64_t now = esp_timer_get_time();
+    portENTER_CRITICAL(&link_mux);
+    const failsafe_link_t* l = &links[link];
+    out->connected = l->connected;
+    out->on_change = l->on_change;
+    out->reports = l->reports;
+    out->mean_interval_us = l->mean_interval_us;
+    out->jitter_us = l->jitter_us;
+    out->age_us = l->connected ? (uint32_t)(now - l->last_report_us) : 0;
+    out->rssi = l->rssi;
+    out->rssi_valid = l->rssi_valid;
+    out->weak_link = link_is_weak(l);
+    portEXIT_CRITICAL(&link_mux);
+}
+
+static int cmd_tank_failsafe(int argc, char** argv) {
+    printf("Failsafe: clamp=%u ms (speed %u), coast=%u ms, brake=%u ms\n", config.clamp_ms, config.clamp_speed,
+           config.coast_ms, config.brake_ms);
+    printf("  stage: %s (entries: clamp=%lu, coast=%lu, brake=%lu)\n", stage_names[current_stage],
+           (unsigned long)stage_entries[RC_TANK_FAILSAFE_CLAMP], (unsigned long)stage_entries[RC_TANK_FAILSAFE_COAST],
+           (unsigned long)stage_entries[RC_TANK_FAILSAFE_BRAKE]);
+
+    for (int i = 0; i < RC_TANK_FAILSAFE_MAX_LINKS; i++) {
+        rc_tank_failsafe_link_stats_t s;
+        rc_tank_failsafe_get_link_stats(i, &s);
+        if (!s.connected) continue;
+        bool crew = false;
+        for (int c = 0; c < crew_link_count; c++) {
+            crew |= crew_links[c] == i;
+        }
+        printf("  link %d%s: %s, reports=%lu, interval=%lu us +/- %lu us, age=%lu us", i, crew ? "*" : "", s.on_change ? "on-change" : "streaming", (unsigned long)s.reports,
+               (unsigned long)s.mean_interval_us, (unsigned long)s.jitter_us, (unsigned long)s.age_us);
+        if (s.rssi_valid) {
+            printf(", rssi=%d%s", s.rssi, s.weak_link ? " (weak)" : "");
+        }
+        printf("\n");
+    }
+    return 0;
+}
+
+void rc_tank_failsafe_register_cmds(void) {
+    const esp_console_cmd_t failsafe_cmd = {
+        .command = "tank_failsafe",
+        .help = "Shows the input failsafe stage and per-controller report statistics",
+        .hint = NULL,
+        .func = &cmd_tank_failsafe,
+    };
+
+    ESP_ERROR_CHECK(esp_console_cmd_register(&failsafe_cmd));
+}
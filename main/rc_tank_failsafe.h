@@ -0,0 +1,86 @@
+#ifndef RC_TANK_FAILSAFE_H
+#define RC_TANK_FAILSAFE_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "sdkconfig.h"
+
+// 입력 신선도 감시 (페일세이프)
+// 보고가 끊기면 속도 제한 -> 관성 정지 (감속 램프) -> 즉시 정지 순으로 단계적으로 낮춘다.
+// 보고 간격 평균/편차를 추적해 원래 느리게 보고하는 컨트롤러는 그만큼 늦게 판정한다.
+//
+// 보고 간격으로 판정하는 것은 입력이 같아도 고정 주기로 보고하는 컨트롤러 (DualShock/DualSense,
+// Switch Pro/Joy-Con) 뿐이다. 입력이 바뀔 때만 보고하는 컨트롤러 (Xbox BLE, Wii, 일반 HID,
+// 일부 8BitDo 모드) 는 스틱을 고정하면 보고가 멈추므로 링크 수준 신호로만 판정한다:
+//   - 연결이 끊기면 (ACL 감시 시간 초과 포함) 링크와 좌석 입력이 바로 지워진다.
+//     BR/EDR 감시 시간은 RC_TANK_FAILSAFE_SUPERVISION_MS 로 줄이고 (ESP32 가 마스터인 연결만 적용됨),
+//     BLE 는 BTstack 기본 연결 변수의 720 ms 를 쓴다.
+//   - 주기적으로 조회한 RSSI 가 약하면 속도를 제한한다.
+#define RC_TANK_FAILSAFE_MAX_LINKS       CONFIG_BLUEPAD32_MAX_DEVICES  // 링크 번호 = Bluepad32 기기 번호
+#define RC_TANK_FAILSAFE_CLAMP_MS        150   // 마지막 보고 후 속도 제한까지
+#define RC_TANK_FAILSAFE_COAST_MS        400   // 관성 정지까지
+#define RC_TANK_FAILSAFE_BRAKE_MS        1000  // 즉시 정지까지
+#define RC_TANK_FAILSAFE_CLAMP_SPEED     96    // 속도 제한 단계의 최대 트랙 속도
+#define RC_TANK_FAILSAFE_JITTER_K        4     // 평균 간격 + K * 편차 보다 늦으면 지연으로 본다
+
+// BR/EDR 링크 감시 시간 (BTstack 기본값은 20초)
+#define RC_TANK_FAILSAFE_SUPERVISION_MS  1000
+
+// 링크 품질 (RSSI). 약하면 판정 시간을 절반으로 줄이고 속도 제한을 유지한다.
+#define RC_TANK_FAILSAFE_RSSI_PERIOD_MS  500
+#define RC_TANK_FAILSAFE_RSSI_WEAK_BREDR (-8)   // HCI Read RSSI: 적정 수신 범위와의 차 (dB)
+#define RC_TANK_FAILSAFE_RSSI_WEAK_BLE   (-85)  // dBm
+
+typedef enum {
+    RC_TANK_FAILSAFE_OK = 0,
+    RC_TANK_FAILSAFE_CLAMP,   // 트랙 속도 제한
+    RC_TANK_FAILSAFE_COAST,   // 목표 0, 감속 램프로 정지
+    RC_TANK_FAILSAFE_BRAKE,   // 램프 없이 즉시 정지
+    RC_TANK_FAILSAFE_STAGE_MAX
+} rc_tank_failsafe_stage_t;
+
+// 설정 (rc_tank_settings 에 저장)
+typedef struct {
+    uint16_t clamp_ms;
+    uint16_t coast_ms;
+    uint16_t brake_ms;
+    uint8_t clamp_speed;
+    uint8_t reserved;
+} rc_tank_failsafe_config_t;
+
+#define RC_TANK_FAILSAFE_DEFAULT_CONFIG                                                                   \
+    {                                                                                                     \
+        RC_TANK_FAILSAFE_CLAMP_MS, RC_TANK_FAILSAFE_COAST_MS, RC_TANK_FAILSAFE_BRAKE_MS,                  \
+            RC_TANK_FAILSAFE_CLAMP_SPEED, 0                                                               \
+    }
+
+typedef struct {
+    bool connected;
+    bool on_change;              // 변화 시에만 보고 (보고 간격으로 판정하지 않음)
+    uint32_t reports;
+    uint32_t mean_interval_us;   // 보고 간격 이동 평균
+    uint32_t jitter_us;          // 보고 간격 평균 편차
+    uint32_t age_us;             // 마지막 보고 후 경과 시간
+    int8_t rssi;
+    bool rssi_valid;
+    bool weak_link;
+} rc_tank_failsafe_link_stats_t;
+
+// 함수 선언
+void rc_tank_failsafe_set_config(const rc_tank_failsafe_config_t* config);
+// BT 스레드: 컨트롤러 준비 시 보고 방식 등록 (on_change: 변화 시에만 보고하는 컨트롤러)
+void rc_tank_failsafe_on_connect(int link, bool on_change);
+// BT 스레드: 보고 수신 시 호출 (내용이 같아도)
+void rc_tank_failsafe_on_report(int link, int64_t now_us);
+// BT 스레드 (주기 타이머): RSSI 조회가 필요하면 true 반환. 보고가 없어도 링크 품질을 계속 본다
+bool rc_tank_failsafe_rssi_due(int link, int64_t now_us);
+// BT 스레드: 마지막으로 측정된 RSSI 전달 (ble: 절대값 dBm, BR/EDR: 적정 범위와의 차)
+void rc_tank_failsafe_on_rssi(int link, int8_t rssi, bool ble, int64_t now_us);
+void rc_tank_failsafe_on_disconnect(int link);
+// 제어 루프: 현재 조종 중인 링크들 중 가장 나쁜 단계를 판정. 범위 밖 링크 번호는 즉시 정지로 본다
+rc_tank_failsafe_stage_t rc_tank_failsafe_update(const int8_t* crew, int count, int64_t now_us);
+uint8_t rc_tank_failsafe_clamp_speed(void);
+void rc_tank_failsafe_get_link_stats(int link, rc_tank_failsafe_link_stats_t* out);
+void rc_tank_failsafe_register_cmds(void);
+
+#endif // RC_TANK_FAILSAFE_H
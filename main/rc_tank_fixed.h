@@ -0,0 +1,47 @@
+#ifndef RC_TANK_FIXED_H
+#define RC_TANK_FIXED_H
+
+#include <stdint.h>
+#include "rc_tank.h"
+
+// 정수/고정소수점 구동 파이프라인
+// FPU가 없는 ESP32-C3/C6 에서도 입력 -> MCPWM 틱까지 정수 연산만 사용한다.
+//
+//   축 (-512 ~ 511) --<<6--> Q15 --데드존--> Q15 --*255>>15--> 속도 (-255 ~ 255)
+//   속도 --*배율(Q8)>>8--> 속도 --*TICKS_PER_SPEED(Q16)>>16--> MCPWM 비교값
+
+#define RC_TANK_Q15_MAX            32767
+#define RC_TANK_AXIS_TO_Q15_SHIFT  6       // 512 << 6 = 32768
+#define RC_TANK_DEADZONE_Q15       3277    // 0.1
+#define RC_TANK_SPEED_MAX          255
+#define RC_TANK_GAIN_Q8_ONE        256     // 배율 1.0
+
+// MCPWM period_ticks (10MHz / 5kHz = 2000) 및 속도 1당 틱 (Q16)
+#define RC_TANK_MCPWM_PERIOD_TICKS  (MCPWM_TIMER_RESOLUTION / MCPWM_FREQ)
+#define RC_TANK_TICKS_PER_SPEED_Q16 ((((uint32_t)RC_TANK_MCPWM_PERIOD_TICKS << 16) + 127) / RC_TANK_SPEED_MAX)
+
+static inline int32_t rc_tank_axis_to_q15(int32_t axis) {
+    int32_t q = axis * (1 << RC_TANK_AXIS_TO_Q15_SHIFT);
+    if (q > RC_TANK_Q15_MAX) return RC_TANK_Q15_MAX;
+    if (q < -RC_TANK_Q15_MAX) return -RC_TANK_Q15_MAX;
+    return q;
+}
+
+static inline int32_t rc_tank_q15_deadzone(int32_t q, int32_t deadzone) {
+    return (q > -deadzone && q < deadzone) ? 0 : q;
+}
+
+static inline int32_t rc_tank_q15_to_speed(int32_t q) {
+    return (q * RC_TANK_SPEED_MAX) >> 15;
+}
+
+static inline int32_t rc_tank_apply_gain_q8(int32_t speed, int32_t gain_q8) {
+    return (speed * gain_q8) >> 8;
+}
+
+// |속도| (0 ~ 255) -> MCPWM 비교값 (0 ~ period_ticks)
+static inline uint32_t rc_tank_speed_to_ticks(int32_t abs_speed) {
+    return ((uint32_t)abs_speed * RC_TANK_TICKS_PER_SPEED_Q16) >> 16;
+}
+
+#endif // RC_TANK_FIXED_H
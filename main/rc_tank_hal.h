@@ -0,0 +1,87 @@
+#ifndef RC_TANK_HAL_H
+#define RC_TANK_HAL_H
+
+#include <stdint.h>
+#include <stdbool.h>
+
+// 액추에이터 하드웨어 추상화
+// rc_tank.c 와 효과 모듈은 이 인터페이스만 사용한다.
+// - rc_tank_hal_esp32.c: MCPWM/LEDC/GPIO 구동 (펌웨어)
+// - rc_tank_hal_posix.c: 출력 명령을 시간과 함께 기록 (호스트 시뮬레이터)
+
+#define RC_TANK_HAL_LOG_SECTOR 4096
+
+typedef enum {
+    RC_TANK_HAL_MOTOR_LEFT = 0,
+    RC_TANK_HAL_MOTOR_RIGHT,
+    RC_TANK_HAL_MOTOR_TURRET,
+    RC_TANK_HAL_MOTOR_MAX
+} rc_tank_hal_motor_t;
+
+typedef enum {
+    RC_TANK_HAL_SERVO_MOUNT = 0,
+    RC_TANK_HAL_SERVO_CANNON,
+    RC_TANK_HAL_SERVO_MAX
+} rc_tank_hal_servo_t;
+
+typedef enum {
+    RC_TANK_HAL_LED_CANNON = 0,
+    RC_TANK_HAL_LED_HEADLIGHT,
+    RC_TANK_HAL_LED_MAX
+} rc_tank_hal_led_t;
+
+// 함수 선언
+void rc_tank_hal_init(void);
+// speed: -255 ~ 255 (부호가 방향)
+void rc_tank_hal_set_motor(rc_tank_hal_motor_t motor, int speed);
+// duty: LEDC duty (RC_TANK_SERVO_DUTY_BITS 해상도), 다음 PWM 주기부터 반영.
+// 서보 궤적 타이머 (rc_tank_servo_update) 에서만 호출
+void rc_tank_hal_set_servo_duty(rc_tank_hal_servo_t servo, uint32_t duty);
+void rc_tank_hal_set_led(rc_tank_hal_led_t led, bool on);
+// 아날로그 입력 (ADC 연속 변환, DMA) 채널별 평균 갱신. 제어 틱마다 한 번, 읽기 전에 호출
+void rc_tank_hal_sample_analog(void);
+// 배터리 전압 (mV, 분압 환산 후) 과 모터 전류 (mA). 센서가 없거나 값이 오래되면 false
+bool rc_tank_hal_read_power(int32_t* battery_mv, int32_t* current_ma);
+// 터렛 위치 (0.1도, 보정 전). 가변저항은 중간 위치, 엔코더는 전원 인가 위치가 0.
+// 센서가 없거나 새 값이 없으면 false
+bool rc_tank_hal_read_turret_angle(int32_t* ddeg);
+// 단조 증가 시각 (us)
+int64_t rc_tank_hal_time_us(void);
+// 주행 기록 저장소 (플래시 파티션 "tanklog"). 없으면 크기 0.
+// 지우기는 RC_TANK_HAL_LOG_SECTOR 단위이고, 지운 영역은 0xFF 로 읽힌다.
+uint32_t rc_tank_hal_log_size(void);
+bool rc_tank_hal_log_erase(uint32_t offset, uint32_t size);
+bool rc_tank_hal_log_write(uint32_t offset, const void* data, uint32_t len);
+bool rc_tank_hal_log_read(uint32_t offset, void* data, uint32_t len);
+
+#ifndef ESP_PLATFORM
+// 시뮬레이터 전용: 액추에이터 명령 기록
+#define RC_TANK_HAL_TRACE_LEN 4096
+
+typedef enum {
+    RC_TANK_HAL_TRACE_MOTOR = 0,
+    RC_TANK_HAL_TRACE_SERVO,
+    RC_TANK_HAL_TRACE_LED,
+} rc_tank_hal_trace_kind_t;
+
+typedef struct {
+    int64_t time_us;
+    uint8_t kind;     // rc_tank_hal_trace_kind_t
+    uint8_t channel;  // 모터/서보/LED 번호
+    int32_t value;    // 속도, duty 또는 0/1
+} rc_tank_hal_trace_t;
+
+// 기록된 명령 수 (가득 차면 이후 명령은 버려지고 dropped 가 증가)
+uint32_t rc_tank_hal_trace_count(void);
+uint32_t rc_tank_hal_trace_dropped(void);
+const rc_tank_hal_trace_t* rc_tank_hal_trace_get(uint32_t index);
+void rc_tank_hal_trace_clear(void);
+// 시뮬레이션 시계. 설정하면 rc_tank_hal_time_us() 가 실제 시계 대신 이 값을 반환한다.
+void rc_tank_hal_set_sim_time_us(int64_t time_us);
+// 시뮬레이션 전원 상태 (기본 8000mV, 0mA)
+void rc_tank_hal_set_sim_power(int32_t battery_mv, int32_t current_ma);
+// 시뮬레이션 기록 저장소 크기 (RAM)
+#define RC_TANK_HAL_SIM_LOG_SIZE (256 * 1024)
+#endif  // ESP_PLATFORM
+
+#endif // RC_TANK_HAL_H
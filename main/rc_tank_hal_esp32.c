@@ -0,0 +1,468 @@
+#include "rc_tank_hal.h"
+#include "rc_tank.h"
+#include "rc_tank_fixed.h"
+#include "driver/gpio.h"
+#include "driver/ledc.h"
+#include "driver/mcpwm_prelude.h"
+#if RC_TANK_TURRET_SENSOR == RC_TANK_TURRET_SENSOR_ENCODER
+#include "driver/pulse_cnt.h"
+#endif
+#include "esp_adc/adc_cali.h"
+#include "esp_adc/adc_cali_scheme.h"
+#include "esp_adc/adc_continuous.h"
+#include "esp_log.h"
+#include "esp_partition.h"
+#include "esp_timer.h"
+#include "uni_latency.h"
+
+static const char* TAG = "RC_TANK_HAL";
+
+// 모터마다 타이머/오퍼레이터 하나, 비교기/생성기 두 개 (IN1/IN2)
+typedef struct {
+    int in1_pin;
+    int in2_pin;
+    mcpwm_timer_handle_t timer;
+    mcpwm_oper_handle_t oper;
+    mcpwm_cmpr_handle_t cmpr_a;
+    mcpwm_cmpr_handle_t cmpr_b;
+    mcpwm_gen_handle_t gen_a;
+    mcpwm_gen_handle_t gen_b;
+} motor_channel_t;
+
+static motor_channel_t motors[RC_TANK_HAL_MOTOR_MAX] = {
+    [RC_TANK_HAL_MOTOR_LEFT] = {.in1_pin = LEFT_TRACK_IN1_PIN, .in2_pin = LEFT_TRACK_IN2_PIN},
+    [RC_TANK_HAL_MOTOR_RIGHT] = {.in1_pin = RIGHT_TRACK_IN1_PIN, .in2_pin = RIGHT_TRACK_IN2_PIN},
+    [RC_TANK_HAL_MOTOR_TURRET] = {.in1_pin = TURRET_IN1_PIN, .in2_pin = TURRET_IN2_PIN},
+};
+
+static const ledc_channel_t servo_channels[RC_TANK_HAL_SERVO_MAX] = {
+    [RC_TANK_HAL_SERVO_MOUNT] = LEDC_CHANNEL_MOUNT,
+    [RC_TANK_HAL_SERVO_CANNON] = LEDC_CHANNEL_CANNON,
+};
+
+static const gpio_num_t led_pins[RC_TANK_HAL_LED_MAX] = {
+    [RC_TANK_HAL_LED_CANNON] = CANNON_LED_PIN,
+    [RC_TANK_HAL_LED_HEADLIGHT] = HEADLIGHT_LED_PIN,
+};
+
+// GPIO 설정
+static void setup_gpio(void) {
+    // LED 핀 설정
+    gpio_config_t led_config = {
+        .pin_bit_mask = (1ULL << CANNON_LED_PIN) | (1ULL << HEADLIGHT_LED_PIN),
+        .mode = GPIO_MODE_OUTPUT,
+        .pull_up_en = GPIO_PULLUP_DISABLE,
+        .pull_down_en = GPIO_PULLDOWN_DISABLE,
+        .intr_type = GPIO_INTR_DISABLE
+    };
+    gpio_config(&led_config);
+    
+    // LED 초기 상태 설정
+    gpio_set_level(CANNON_LED_PIN, 0);
+    gpio_set_level(HEADLIGHT_LED_PIN, 0);
+}
+
+// LEDC 초기화 (서보 모터용)
+static void setup_ledc(void) {
+    // LEDC 타이머 설정
+    ledc_timer_config_t ledc_timer = {
+        .duty_resolution = LEDC_DUTY_RES,
+        .freq_hz = LEDC_FREQUENCY,
+        .speed_mode = LEDC_MODE,
+        .timer_num = LEDC_TIMER,
+        .clk_cfg = LEDC_AUTO_CLK,
+    };
+    ledc_timer_config(&ledc_timer);
+    
+    // 포 마운트 서보 모터 채널 설정
+    ledc_channel_config_t mount_channel = {
+        .channel = LEDC_CHANNEL_MOUNT,
+        .duty = 0,
+        .gpio_num = MOUNT_SERVO_PIN,
+        .speed_mode = LEDC_MODE,
+        .hpoint = 0,
+        .timer_sel = LEDC_TIMER
+    };
+    ledc_channel_config(&mount_channel);
+    
+    // 포신 서보 모터 채널 설정
+    ledc_channel_config_t cannon_channel = {
+        .channel = LEDC_CHANNEL_CANNON,
+        .duty = 0,
+        .gpio_num = CANNON_SERVO_PIN,
+        .speed_mode = LEDC_MODE,
+        .hpoint = 0,
+        .timer_sel = LEDC_TIMER
+    };
+    ledc_channel_config(&cannon_channel);
+}
+
+// MCPWM 초기화 (모터 제어용)
+static void setup_motor(motor_channel_t* m) {
+    mcpwm_timer_config_t timer_config = {
+        .group_id = 0,
+        .clk_src = MCPWM_TIMER_CLK_SRC_DEFAULT,
+        .resolution_hz = MCPWM_TIMER_RESOLUTION,
+        .period_ticks = MCPWM_TIMER_RESOLUTION / MCPWM_FREQ,
+        .count_mode = MCPWM_TIMER_COUNT_MODE_UP,
+    };
+    ESP_ERROR_CHECK(mcpwm_new_timer(&timer_config, &m->timer));
+    ESP_ERROR_CHECK(mcpwm_new_operator(&(mcpwm_operator_config_t){}, &m->oper));
+    ESP_ERROR_CHECK(mcpwm_operator_connect_timer(m->oper, m->timer));
+    
+    mcpwm_comparator_config_t cmpr_config = {
+        .flags.update_cmp_on_tez = true,
+    };
+    ESP_ERROR_CHECK(mcpwm_new_comparator(m->oper, &cmpr_config, &m->cmpr_a));
+    ESP_ERROR_CHECK(mcpwm_new_comparator(m->oper, &cmpr_config, &m->cmpr_b));
+    
+    mcpwm_generator_config_t gen_config = {
+        .gen_gpio_num = m->in1_pin,
+    };
+    ESP_ERROR_CHECK(mcpwm_new_generator(m->oper, &gen_config, &m->gen_a));
+    gen_config.gen_gpio_num = m->in2_pin;
+    ESP_ERROR_CHECK(mcpwm_new_generator(m->oper, &gen_config, &m->gen_b));
+}
+
+#if RC_TANK_TURRET_SENSOR == RC_TANK_TURRET_SENSOR_ENCODER
+// 쿼드러처 엔코더: PCNT 가 4체배로 계수하고 CPU 는 누적 카운트만 읽는다
+#define TURRET_ENC_LIMIT 30000
+
+static pcnt_unit_handle_t turret_pcnt = NULL;
+
+static void setup_turret_sensor(void) {
+    pcnt_unit_config_t unit_config = {
+        .high_limit = TURRET_ENC_LIMIT,
+        .low_limit = -TURRET_ENC_LIMIT,
+        .flags.accum_count = true,  // 한계 도달 시 누적 (오버플로 보정)
+    };
+    if (pcnt_new_unit(&unit_config, &turret_pcnt) != ESP_OK) {
+        ESP_LOGE(TAG, "Turret encoder unit creation failed");
+        turret_pcnt = NULL;
+        return;
+    }
+    pcnt_glitch_filter_config_t filter_config = {.max_glitch_ns = 1000};
+    ESP_ERROR_CHECK(pcnt_unit_set_glitch_filter(turret_pcnt, &filter_config));
+
+    pcnt_chan_config_t chan_a_config = {.edge_gpio_num = TURRET_ENC_A_PIN, .level_gpio_num = TURRET_ENC_B_PIN};
+    pcnt_chan_config_t chan_b_config = {.edge_gpio_num = TURRET_ENC_B_PIN, .level_gpio_num = TURRET_ENC_A_PIN};
+    pcnt_channel_handle_t chan_a, chan_b;
+    ESP_ERROR_CHECK(pcnt_new_channel(turret_pcnt, &chan_a_config, &chan_a));
+    ESP_ERROR_CHECK(pcnt_new_channel(turret_pcnt, &chan_b_config, &chan_b));
+    ESP_ERROR_CHECK(pcnt_channel_set_edge_action(chan_a, PCNT_CHANNEL_EDGE_ACTION_DECREASE,
+                                                 PCNT_CHANNEL_EDGE_ACTION_INCREASE));
+    ESP_ERROR_CHECK(pcnt_channel_set_level_action(chan_a, PCNT_CHANNEL_LEVEL_ACTION_KEEP,
+                                                  PCNT_CHANNEL_LEVEL_ACTION_INVERSE));
+    ESP_ERROR_CHECK(pcnt_channel_set_edge_action(chan_b, PCNT_CHANNEL_EDGE_ACTION_INCREASE,
+                                                 PCNT_CHANNEL_EDGE_ACTION_DECREASE));
+    ESP_ERROR_CHECK(pcnt_channel_set_level_action(chan_b, PCNT_CHANNEL_LEVEL_ACTION_KEEP,
+                                                  PCNT_CHANNEL_LEVEL_ACTION_INVERSE));
+    ESP_ERROR_CHECK(pcnt_unit_add_watch_point(turret_pcnt, TURRET_ENC_LIMIT));
+    ESP_ERROR_CHECK(pcnt_unit_add_watch_point(turret_pcnt, -TURRET_ENC_LIMIT));
+
+    ESP_ERROR_CHECK(pcnt_unit_enable(turret_pcnt));
+    ESP_ERROR_CHECK(pcnt_unit_clear_count(turret_pcnt));
+    ESP_ERROR_CHECK(pcnt_unit_start(turret_pcnt));
+}
+
+bool rc_tank_hal_read_turret_angle(int32_t* ddeg) {
+    int count;
+    if (turret_pcnt == NULL || pcnt_unit_get_count(turret_pcnt, &count) != ESP_OK) {
+        return false;
+    }
+    *ddeg = (int32_t)((int64_t)count * 3600 / TURRET_ENC_COUNTS_PER_REV);
+    return true;
+}
+#endif
+
+// 아날로그 입력: ADC1 연속 변환 하나로 여러 채널을 번갈아 샘플링하고 DMA 가 프레임 단위로 채운다.
+// CPU 는 제어 틱마다 가장 최근 프레임 하나만 채널별로 평균한다 (샘플당 인터럽트 없음).
+// 연속 변환 드라이버는 하나만 만들 수 있으므로 터렛 가변저항과 전원 감시가 함께 쓴다.
+#define ANALOG_SAMPLE_HZ   20000
+#define ANALOG_FRAME_BYTES 128      // 제어 틱 (5ms) 안에 한 프레임 이상 채워지도록
+#define ANALOG_STALE_US    50000    // 이보다 오래된 평균은 쓰지 않는다
+
+#if CONFIG_IDF_TARGET_ESP32 || CONFIG_IDF_TARGET_ESP32S2
+#define ANALOG_FORMAT      ADC_DIGI_OUTPUT_FORMAT_TYPE1
+#define ANALOG_DATA(p)     ((p)->type1.data)
+#define ANALOG_CHANNEL(p)  ((p)->type1.channel)
+#else
+#define ANALOG_FORMAT      ADC_DIGI_OUTPUT_FORMAT_TYPE2
+#define ANALOG_DATA(p)     ((p)->type2.data)
+#define ANALOG_CHANNEL(p)  ((p)->type2.channel)
+#endif
+
+typedef enum {
+    ANALOG_TURRET_POT = 0,
+    ANALOG_BATTERY,
+    ANALOG_CURRENT,
+    ANALOG_MAX
+} analog_input_t;
+
+typedef struct {
+    int pin;              // -1: 사용 안 함
+    adc_channel_t channel;
+    bool enabled;
+    uint32_t raw;         // 마지막 프레임 평균
+    int64_t updated_us;
+} analog_input_state_t;
+
+static analog_input_state_t analog_inputs[ANALOG_MAX] = {
+#if RC_TANK_TURRET_SENSOR == RC_TANK_TURRET_SENSOR_POT
+    [ANALOG_TURRET_POT] = {.pin = TURRET_POT_PIN},
+#else
+    [ANALOG_TURRET_POT] = {.pin = -1},
+#endif
+    [ANALOG_BATTERY] = {.pin = BATTERY_SENSE_PIN},
+    [ANALOG_CURRENT] = {.pin = CURRENT_SENSE_PIN},
+};
+
+static adc_continuous_handle_t analog_adc = NULL;
+static adc_cali_handle_t analog_cali = NULL;
+static uint8_t analog_frame[ANALOG_FRAME_BYTES];
+
+static void setup_analog_calibration(void) {
+#if ADC_CALI_SCHEME_CURVE_FITTING_SUPPORTED
+    adc_cali_curve_fitting_config_t cali_config = {
+        .unit_id = ADC_UNIT_1,
+        .atten = ADC_ATTEN_DB_12,
+        .bitwidth = SOC_ADC_DIGI_MAX_BITWIDTH,
+    };
+    if (adc_cali_create_scheme_curve_fitting(&cali_config, &analog_cali) != ESP_OK) {
+        analog_cali = NULL;
+    }
+#elif ADC_CALI_SCHEME_LINE_FITTING_SUPPORTED
+    adc_cali_line_fitting_config_t cali_config = {
+        .unit_id = ADC_UNIT_1,
+        .atten = ADC_ATTEN_DB_12,
+        .bitwidth = SOC_ADC_DIGI_MAX_BITWIDTH,
+    };
+    if (adc_cali_create_scheme_line_fitting(&cali_config, &analog_cali) != ESP_OK) {
+        analog_cali = NULL;
+    }
+#endif
+    if (analog_cali == NULL) {
+        ESP_LOGW(TAG, "ADC calibration unavailable, using nominal scale");
+    }
+}
+
+static void setup_analog(void) {
+    adc_digi_pattern_config_t patterns[ANALOG_MAX];
+    uint32_t pattern_num = 0;
+
+    for (int i = 0; i < ANALOG_MAX; i++) {
+        analog_input_state_t* in = &analog_inputs[i];
+        adc_unit_t unit;
+        if (in->pin < 0) {
+            continue;
+        }
+        if (adc_continuous_io_to_channel(in->pin, &unit, &in->channel) != ESP_OK || unit != ADC_UNIT_1) {
+            ESP_LOGE(TAG, "GPIO %d is not an ADC1 pin, analog input %d disabled", in->pin, i);
+            continue;
+        }
+        patterns[pattern_num++] = (adc_digi_pattern_config_t){
+            .atten = ADC_ATTEN_DB_12,
+            .channel = in->channel,
+            .unit = ADC_UNIT_1,
+            .bit_width = SOC_ADC_DIGI_MAX_BITWIDTH,
+        };
+        in->enabled = true;
+    }
+    if (pattern_num == 0) {
+        return;
+    }
+
+    adc_continuous_handle_cfg_t handle_config = {
+        .max_store_buf_size = ANALOG_FRAME_BYTES * 8,
+        .conv_frame_size = ANALOG_FRAME_BYTES,
+    };
+    if (adc_continuous_new_handle(&handle_config, &analog_adc) != ESP_OK) {
+        ESP_LOGE(TAG, "ADC continuous mode creation failed");
+        analog_adc = NULL;
+        return;
+    }
+
+    adc_continuous_config_t config = {
+        .pattern_num = pattern_num,
+        .adc_pattern = patterns,
+        .sample_freq_hz = ANALOG_SAMPLE_HZ,
+        .conv_mode = ADC_CONV_SINGLE_UNIT_1,
+        .format = ANALOG_FORMAT,
+    };
+    ESP_ERROR_CHECK(adc_continuous_config(analog_adc, &config));
+    ESP_ERROR_CHECK(adc_continuous_start(analog_adc));
+    setup_analog_calibration();
+}
+
+void rc_tank_hal_sample_analog(void) {
+    if (analog_adc == NULL) {
+        return;
+    }
+
+    // 쌓인 프레임을 비우고 마지막 프레임만 남긴다
+    uint32_t len = 0, last_len = 0;
+    while (adc_continuous_read(analog_adc, analog_frame, sizeof(analog_frame), &len, 0) == ESP_OK) {
+        last_len = len;
+    }
+    if (last_len == 0) {
+        return;
+    }
+
+    uint32_t sum[ANALOG_MAX] = {0};
+    uint32_t count[ANALOG_MAX] = {0};
+    for (uint32_t i = 0; i + SOC_ADC_DIGI_RESULT_BYTES <= last_len; i += SOC_ADC_DIGI_RESULT_BYTES) {
+        const adc_digi_output_data_t* p = (const adc_digi_output_data_t*)&analog_frame[i];
+        for (int k = 0; k < ANALOG_MAX; k++) {
+            if (analog_inputs[k].enabled && analog_inputs[k].channel == ANALOG_CHANNEL(p)) {
+                sum[k] += ANALOG_DATA(p);
+                count[k]++;
+                break;
+            }
+        }
+    }
+
+    int64_t now = esp_timer_get_time();
+    for (int k = 0; k < ANALOG_MAX; k++) {
+        if (count[k] > 0) {
+            analog_inputs[k].raw = sum[k] / count[k];
+            analog_inputs[k].updated_us = now;
+        }
+    }
+}
+
+static bool analog_get_raw(analog_input_t input, int32_t* raw) {
+    const analog_input_state_t* in = &analog_inputs[input];
+    if (!in->enabled || in->updated_us == 0 || esp_timer_get_time() - in->updated_us > ANALOG_STALE_US) {
+        return false;
+    }
+    *raw = (int32_t)in->raw;
+    return true;
+}
+
+static int32_t analog_raw_to_mv(int32_t raw) {
+    int mv;
+    if (analog_cali != NULL && adc_cali_raw_to_voltage(analog_cali, raw, &mv) == ESP_OK) {
+        return mv;
+    }
+    // 보정 없음: 12dB 감쇠 공칭 범위 (약 3.1V)
+    return raw * 3100 / ((1 << SOC_ADC_DIGI_MAX_BITWIDTH) - 1);
+}
+
+#if RC_TANK_TURRET_SENSOR == RC_TANK_TURRET_SENSOR_POT
+static void setup_turret_sensor(void) {
+    // 가변저항은 아날로그 입력 (setup_analog) 에 포함된다
+}
+
+bool rc_tank_hal_read_turret_angle(int32_t* ddeg) {
+    int32_t raw;
+    if (!analog_get_raw(ANALOG_TURRET_POT, &raw)) {
+        return false;
+    }
+    // 원시값 (0 ~ 최대) -> 중간 위치 기준 0.1도
+    const int32_t full_scale = (1 << SOC_ADC_DIGI_MAX_BITWIDTH) - 1;
+    *ddeg = (raw - full_scale / 2) * (TURRET_POT_RANGE_DEG * 10) / full_scale;
+    return true;
+}
+#endif
+
+bool rc_tank_hal_read_power(int32_t* battery_mv, int32_t* current_ma) {
+    int32_t battery_raw, current_raw;
+    if (!analog_get_raw(ANALOG_BATTERY, &battery_raw) || !analog_get_raw(ANALOG_CURRENT, &current_raw)) {
+        return false;
+    }
+    *battery_mv = analog_raw_to_mv(battery_raw) * BATTERY_DIVIDER_NUM / BATTERY_DIVIDER_DEN;
+    *current_ma = (analog_raw_to_mv(current_raw) - CURRENT_SENSE_OFFSET_MV) * 1000 / CURRENT_SENSE_MV_PER_A;
+    return true;
+}
+
+void rc_tank_hal_init(void) {
+    setup_gpio();
+    setup_ledc();
+    setup_analog();
+    setup_turret_sensor();
+    
+    for (int i = 0; i < RC_TANK_HAL_MOTOR_MAX; i++) {
+        setup_motor(&motors[i]);
+    }
+    
+    // 타이머 시작
+    for (int i = 0; i < RC_TANK_HAL_MOTOR_MAX; i++) {
+        ESP_ERROR_CHECK(mcpwm_timer_enable(motors[i].timer));
+    }
+    for (int i = 0; i < RC_TANK_HAL_MOTOR_MAX; i++) {
+        ESP_ERROR_CHECK(mcpwm_timer_start_stop(motors[i].timer, MCPWM_TIMER_START_NO_STOP));
+    }
+    
+    ESP_LOGI(TAG, "Actuator HAL initialized");
+}
+
+void rc_tank_hal_set_motor(rc_tank_hal_motor_t motor, int speed) {
+    const motor_channel_t* m = &motors[motor];
+    
+    if (speed > 0) {
+        // 전진 (시계방향) - duty cycle을 period_ticks 범위 내로 조정
+        mcpwm_comparator_set_compare_value(m->cmpr_a, rc_tank_speed_to_ticks(speed));
+        mcpwm_comparator_set_compare_value(m->cmpr_b, 0);
+    } else if (speed < 0) {
+        // 후진 (반시계방향)
+        mcpwm_comparator_set_compare_value(m->cmpr_a, 0);
+        mcpwm_comparator_set_compare_value(m->cmpr_b, rc_tank_speed_to_ticks(-speed));
+    } else {
+        // 정지
+        mcpwm_comparator_set_compare_value(m->cmpr_a, 0);
+        mcpwm_comparator_set_compare_value(m->cmpr_b, 0);
+    }
+    
+    // 입력 보고 -> 비교기 기록 지연 측정 (새 입력 후 첫 기록만 집계됨)
+    uni_latency_mark(UNI_LATENCY_STAGE_APP_OUTPUT);
+}
+
+void rc_tank_hal_set_servo_duty(rc_tank_hal_servo_t servo, uint32_t duty) {
+    ledc_set_duty(LEDC_MODE, servo_channels[servo], duty);
+    ledc_update_duty(LEDC_MODE, servo_channels[servo]);
+}
+
+void rc_tank_hal_set_led(rc_tank_hal_led_t led, bool on) {
+    gpio_set_level(led_pins[led], on ? 1 : 0);
+}
+
+int64_t rc_tank_hal_time_us(void) {
+    return esp_timer_get_time();
+}
+
+// 주행 기록 파티션 (partitions.csv 의 "tanklog"). 처음 사용할 때 찾는다
+#define LOG_PARTITION_SUBTYPE 0x40
+#define LOG_PARTITION_LABEL   "tanklog"
+
+static const esp_partition_t* log_partition(void) {
+    static const esp_partition_t* part = NULL;
+    static bool searched = false;
+    if (!searched) {
+        part = esp_partition_find_first(ESP_PARTITION_TYPE_DATA, LOG_PARTITION_SUBTYPE, LOG_PARTITION_LABEL);
+        if (part == NULL) {
+            ESP_LOGW(TAG, "No '%s' partition, session recording disabled", LOG_PARTITION_LABEL);
+        }
+        searched = true;
+    }
+    return part;
+}
+
+uint32_t rc_tank_hal_log_size(void) {
+    const esp_partition_t* part = log_partition();
+    return part != NULL ? part->size : 0;
+}
+
+bool rc_tank_hal_log_erase(uint32_t offset, uint32_t size) {
+    const esp_partition_t* part = log_partition();
+    return part != NULL && esp_partition_erase_range(part, offset, size) == ESP_OK;
+}
+
+bool rc_tank_hal_log_write(uint32_t offset, const void* data, uint32_t len) {
+    const esp_partition_t* part = log_partition();
+    return part != NULL && esp_partition_write(part, offset, data, len) == ESP_OK;
+}
+
+bool rc_tank_hal_log_read(uint32_t offset, void* data, uint32_t len) {
+    const esp_partition_t* part = log_partition();
+    return part != NULL && esp_partition_read(part, offset, data, len) == ESP_OK;
+}
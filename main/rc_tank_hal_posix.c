@@ -0,0 +1,167 @@
+// clock_gettime(CLOCK_MONOTONIC) 은 POSIX 확장 (-std=c11 에서도 보이도록)
+#define _POSIX_C_SOURCE 200809L
+
+#include "rc_tank_hal.h"
+#include <pthread.h>
+#include <string.h>
+#include <time.h>
+
+// 호스트 시뮬레이터용 액추에이터 HAL
+// 하드웨어 대신 출력 명령을 시각과 함께 기록해 입력 -> 액추에이터 지연을 측정한다.
+
+static rc_tank_hal_trace_t trace[RC_TANK_HAL_TRACE_LEN];
+static uint32_t trace_count = 0;
+static uint32_t trace_dropped = 0;
+static int64_t sim_time_us = -1;  // -1: 실제 시계 사용
+static pthread_mutex_t trace_lock = PTHREAD_MUTEX_INITIALIZER;
+
+// 터렛 모델: 속도 255 에서 초당 90도로 회전한다고 보고 명령 속도를 적분
+#define SIM_TURRET_DDEG_PER_S 900
+static int sim_turret_speed = 0;
+static int64_t sim_turret_ddeg_x255 = 0;  // 0.1도 * 255 (소수 누적)
+static int64_t sim_turret_time_us = -1;
+
+static int32_t sim_battery_mv = 8000;
+static int32_t sim_current_ma = 0;
+
+// 기록 저장소: 플래시처럼 지우면 0xFF, 쓰기는 비트를 0 으로만 바꾼다
+static uint8_t sim_log[RC_TANK_HAL_SIM_LOG_SIZE];
+static bool sim_log_ready = false;
+
+static void record(rc_tank_hal_trace_kind_t kind, int channel, int32_t value) {
+    int64_t time_us = rc_tank_hal_time_us();
+    pthread_mutex_lock(&trace_lock);
+    if (trace_count < RC_TANK_HAL_TRACE_LEN) {
+        trace[trace_count++] = (rc_tank_hal_trace_t){
+            .time_us = time_us,
+            .kind = (uint8_t)kind,
+            .channel = (uint8_t)channel,
+            .value = value,
+        };
+    } else {
+        trace_dropped++;
+    }
+    pthread_mutex_unlock(&trace_lock);
+}
+
+static void sim_turret_advance(void) {
+    int64_t now = rc_tank_hal_time_us();
+    if (sim_turret_time_us >= 0) {
+        sim_turret_ddeg_x255 += (int64_t)sim_turret_speed * SIM_TURRET_DDEG_PER_S * (now - sim_turret_time_us) / 1000000;
+    }
+    sim_turret_time_us = now;
+}
+
+void rc_tank_hal_init(void) {
+    rc_tank_hal_trace_clear();
+    sim_turret_speed = 0;
+    sim_turret_ddeg_x255 = 0;
+    sim_turret_time_us = -1;
+}
+
+void rc_tank_hal_set_motor(rc_tank_hal_motor_t motor, int speed) {
+    if (motor == RC_TANK_HAL_MOTOR_TURRET) {
+        sim_turret_advance();
+        sim_turret_speed = speed;
+    }
+    record(RC_TANK_HAL_TRACE_MOTOR, motor, speed);
+}
+
+void rc_tank_hal_sample_analog(void) {
+}
+
+bool rc_tank_hal_read_power(int32_t* battery_mv, int32_t* current_ma) {
+    *battery_mv = sim_battery_mv;
+    *current_ma = sim_current_ma;
+    return true;
+}
+
+void rc_tank_hal_set_sim_power(int32_t battery_mv, int32_t current_ma) {
+    sim_battery_mv = battery_mv;
+    sim_current_ma = current_ma;
+}
+
+bool rc_tank_hal_read_turret_angle(int32_t* ddeg) {
+    sim_turret_advance();
+    *ddeg = (int32_t)(sim_turret_ddeg_x255 / 255);
+    return true;
+}
+
+void rc_tank_hal_set_servo_duty(rc_tank_hal_servo_t servo, uint32_t duty) {
+    record(RC_TANK_HAL_TRACE_SERVO, servo, (int32_t)duty);
+}
+
+void rc_tank_hal_set_led(rc_tank_hal_led_t led, bool on) {
+    record(RC_TANK_HAL_TRACE_LED, led, on ? 1 : 0);
+}
+
+int64_t rc_tank_hal_time_us(void) {
+    if (sim_time_us >= 0) {
+        return sim_time_us;
+    }
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (int64_t)ts.tv_sec * 1000000 + ts.tv_nsec / 1000;
+}
+
+void rc_tank_hal_set_sim_time_us(int64_t time_us) {
+    sim_time_us = time_us;
+}
+
+uint32_t rc_tank_hal_trace_count(void) {
+    return trace_count;
+}
+
+uint32_t rc_tank_hal_trace_dropped(void) {
+    return trace_dropped;
+}
+
+const rc_tank_hal_trace_t* rc_tank_hal_trace_get(uint32_t index) {
+    return (index < trace_count) ? &trace[index] : NULL;
+}
+
+void rc_tank_hal_trace_clear(void) {
+    pthread_mutex_lock(&trace_lock);
+    trace_count = 0;
+    trace_dropped = 0;
+    pthread_mutex_unlock(&trace_lock);
+}
+
+static bool sim_log_range(uint32_t offset, uint32_t len) {
+    if (!sim_log_ready) {
+        memset(sim_log, 0xFF, sizeof(sim_log));
+        sim_log_ready = true;
+    }
+    return offset <= sizeof(sim_log) && len <= sizeof(sim_log) - offset;
+}
+
+uint32_t rc_tank_hal_log_size(void) {
+    return sizeof(sim_log);
+}
+
+bool rc_tank_hal_log_erase(uint32_t offset, uint32_t size) {
+    if (!sim_log_range(offset, size) || offset % RC_TANK_HAL_LOG_SECTOR || size % RC_TANK_HAL_LOG_SECTOR) {
+        return false;
+    }
+    memset(&sim_log[offset], 0xFF, size);
+    return true;
+}
+
+bool rc_tank_hal_log_write(uint32_t offset, const void* data, uint32_t len) {
+    if (!sim_log_range(offset, len)) {
+        return false;
+    }
+    const uint8_t* src = data;
+    for (uint32_t i = 0; i < len; i++) {
+        sim_log[offset + i] &= src[i];
+    }
+    return true;
+}
+
+bool rc_tank_hal_log_read(uint32_t offset, void* data, uint32_t len) {
+    if (!sim_log_range(offset, len)) {
+        return false;
+    }
+    memcpy(data, &sim_log[offset], len);
+    return true;
+}
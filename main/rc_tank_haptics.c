@@ -0,0 +1,188 @@
+#include "rc_tank_haptics.h"
+#include "esp_console.h"
+#include "esp_log.h"
+#include <stdatomic.h>
+#include <stdio.h>
+#include <string.h>
+
+static const char* TAG = "RC_TANK_HAPTICS";
+
+// 포락선: 구간 목록을 repeat 번 반복
+typedef struct {
+    const rc_tank_rumble_t* segments;
+    uint8_t count;
+    uint8_t repeat;
+} envelope_t;
+
+// 좌석 배정: 기존 연결 진동 그대로
+static const rc_tank_rumble_t connect_segments[] = {{150, 128, 40}};
+// 포 발사: 강한 모터로 짧게 친 뒤 약하게 잦아든다
+static const rc_tank_rumble_t recoil_segments[] = {{120, 0, 255}, {200, 90, 60}};
+// 기관총: 약한 모터 150ms 주기 점사 (20회 = 3초)
+static const rc_tank_rumble_t machine_gun_segments[] = {{60, 200, 0}, {90, 0, 0}};
+// 모터 과전류: 낮게 한 번 길게
+static const rc_tank_rumble_t motor_limit_segments[] = {{250, 60, 160}};
+// 배터리 부족: 강한 모터 3회
+static const rc_tank_rumble_t low_battery_segments[] = {{200, 0, 200}, {200, 0, 0}};
+
+#define ENVELOPE(segs, n) {(segs), sizeof(segs) / sizeof((segs)[0]), (n)}
+
+static const envelope_t envelopes[RC_TANK_HAPTIC_MAX] = {
+    [RC_TANK_HAPTIC_CONNECT] = ENVELOPE(connect_segments, 1),
+    [RC_TANK_HAPTIC_CANNON_RECOIL] = ENVELOPE(recoil_segments, 1),
+    [RC_TANK_HAPTIC_MACHINE_GUN] = ENVELOPE(machine_gun_segments, 20),
+    [RC_TANK_HAPTIC_MOTOR_LIMIT] = ENVELOPE(motor_limit_segments, 1),
+    [RC_TANK_HAPTIC_LOW_BATTERY] = ENVELOPE(low_battery_segments, 3),
+};
+
+static const char* const event_names[RC_TANK_HAPTIC_MAX] = {"connect", "recoil", "machine_gun", "motor_limit",
+                                                            "low_battery"};
+
+// 좌석별 재생 상태 (BT 스레드 전용)
+typedef struct {
+    bool playing[RC_TANK_HAPTIC_MAX];
+    int64_t start_us[RC_TANK_HAPTIC_MAX];
+    uint8_t weak;           // 마지막으로 보낸 세기
+    uint8_t strong;
+    int64_t last_send_us;
+    int64_t until_us;       // 컨트롤러가 진동을 멈출 시각 (마지막 요청 기준)
+} seat_state_t;
+
+// 좌석별 새 이벤트 비트 (임의 스레드 -> BT 스레드)
+static atomic_uint pending[RC_TANK_CREW_SEATS];
+static seat_state_t seats[RC_TANK_CREW_SEATS];
+
+// 통계
+static atomic_uint posted[RC_TANK_HAPTIC_MAX];
+static uint32_t reports_sent = 0;
+static uint32_t reports_deferred = 0;  // 최소 간격 때문에 미룬 횟수 (중간 변화는 합쳐진다)
+
+void rc_tank_haptics_post(rc_tank_haptic_t event, uint32_t seat_mask) {
+    if (event >= RC_TANK_HAPTIC_MAX) {
+        return;
+    }
+    atomic_fetch_add(&posted[event], 1);
+    for (int i = 0; i < RC_TANK_CREW_SEATS; i++) {
+        if (seat_mask & (1u << i)) {
+            atomic_fetch_or(&pending[i], 1u << event);
+        }
+    }
+}
+
+// elapsed_ms 시점의 구간. 포락선이 끝났으면 false
+static bool envelope_at(const envelope_t* env, int64_t elapsed_ms, rc_tank_rumble_t* seg, int64_t* remaining_ms) {
+    for (int r = 0; r < env->repeat; r++) {
+        for (int i = 0; i < env->count; i++) {
+            if (elapsed_ms < env->segments[i].duration_ms) {
+                *seg = env->segments[i];
+                *remaining_ms = env->segments[i].duration_ms - elapsed_ms;
+                return true;
+            }
+            elapsed_ms -= env->segments[i].duration_ms;
+        }
+    }
+    return false;
+}
+
+bool rc_tank_haptics_poll(uint8_t seat, int64_t now_us, rc_tank_rumble_t* out) {
+    if (seat >= RC_TANK_CREW_SEATS) {
+        return false;
+    }
+    seat_state_t* st = &seats[seat];
+
+    uint32_t bits = atomic_exchange(&pending[seat], 0);
+    for (int e = 0; e < RC_TANK_HAPTIC_MAX; e++) {
+        if (bits & (1u << e)) {
+            st->playing[e] = true;
+            st->start_us[e] = now_us;
+        }
+    }
+
+    // 재생 중인 포락선을 합친다: 세기는 최대값, 다음 변화 시각은 가장 이른 구간 끝
+    uint8_t weak = 0, strong = 0;
+    int64_t next_ms = RC_TANK_HAPTICS_MAX_DURATION_MS;
+    for (int e = 0; e < RC_TANK_HAPTIC_MAX; e++) {
+        if (!st->playing[e]) {
+            continue;
+        }
+        rc_tank_rumble_t seg;
+        int64_t remaining_ms;
+        if (!envelope_at(&envelopes[e], (now_us - st->start_us[e]) / 1000, &seg, &remaining_ms)) {
+            st->playing[e] = false;
+            continue;
+        }
+        if (seg.weak > weak) weak = seg.weak;
+        if (seg.strong > strong) strong = seg.strong;
+        if (remaining_ms < next_ms) next_ms = remaining_ms;
+    }
+
+    bool on = (weak | strong) != 0;
+    bool running = now_us < st->until_us;
+    if (weak == st->weak && strong == st->strong && (running || !on)) {
+        // 컨트롤러가 이미 같은 세기로 진동 중이거나 멈춰 있다
+        return false;
+    }
+    if (!on && !running) {
+        // 마지막 요청의 진동 시간이 끝나 컨트롤러가 스스로 멈췄다
+        st->weak = 0;
+        st->strong = 0;
+        return false;
+    }
+    if (now_us - st->last_send_us < RC_TANK_HAPTICS_MIN_INTERVAL_MS * 1000LL) {
+        reports_deferred++;
+        return false;
+    }
+
+    // 다음 변화까지만 요청하므로 포락선이 끝나면 컨트롤러 (파서 타이머) 가 알아서 멈춘다
+    out->duration_ms = on ? (uint16_t)(next_ms > 0 ? next_ms : 1) : 0;
+    out->weak = weak;
+    out->strong = strong;
+    st->weak = weak;
+    st->strong = strong;
+    st->last_send_us = now_us;
+    st->until_us = now_us + out->duration_ms * 1000LL;
+    reports_sent++;
+    return true;
+}
+
+void rc_tank_haptics_reset_seat(uint8_t seat) {
+    if (seat >= RC_TANK_CREW_SEATS) {
+        return;
+    }
+    atomic_store(&pending[seat], 0);
+    memset(&seats[seat], 0, sizeof(seats[seat]));
+}
+
+static int cmd_tank_haptics(int argc, char** argv) {
+    if (argc > 1) {
+        for (int e = 0; e < RC_TANK_HAPTIC_MAX; e++) {
+            if (strcmp(argv[1], event_names[e]) == 0) {
+                rc_tank_haptics_post((rc_tank_haptic_t)e, RC_TANK_HAPTICS_ALL_SEATS);
+                ESP_LOGI(TAG, "Haptic event: %s", event_names[e]);
+                return 0;
+            }
+        }
+        printf("Unknown event: %s\n", argv[1]);
+        return 1;
+    }
+
+    for (int e = 0; e < RC_TANK_HAPTIC_MAX; e++) {
+        printf("  %-12s %lu\n", event_names[e], (unsigned long)atomic_load(&posted[e]));
+    }
+    printf("Reports: %lu sent, %lu deferred (min interval %d ms)\n", (unsigned long)reports_sent,
+           (unsigned long)reports_deferred, RC_TANK_HAPTICS_MIN_INTERVAL_MS);
+    return 0;
+}
+
+void rc_tank_haptics_register_cmds(void) {
+    const esp_console_cmd_t haptics_cmd = {
+        .command = "tank_haptics",
+        .help =
+            "Shows haptic event and rumble report counters.\n"
+            "  'tank_haptics <connect|recoil|machine_gun|motor_limit|low_battery>' plays an event on all seats",
+        .hint = "[event]",
+        .func = &cmd_tank_haptics,
+    };
+
+    ESP_ERROR_CHECK(esp_console_cmd_register(&haptics_cmd));
+}
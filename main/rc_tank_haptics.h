@@ -0,0 +1,41 @@
+#ifndef RC_TANK_HAPTICS_H
+#define RC_TANK_HAPTICS_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "rc_tank_crew.h"
+
+// 컨트롤러 진동
+// 탱크 이벤트마다 진동 포락선 (구간 목록) 을 좌석별로 재생한다. 여러 이벤트가 겹치면 구간별 최대값을 쓴다.
+// 출력 보고는 합친 세기가 바뀔 때만 보내고, 좌석마다 최소 간격을 지켜 컨트롤러 링크의
+// 출력 보고 버퍼 (32개) 가 쌓이거나 같은 링크의 입력 보고가 늦어지지 않게 한다.
+#define RC_TANK_HAPTICS_MIN_INTERVAL_MS  50    // 좌석당 출력 보고 최소 간격 (최대 20개/초)
+#define RC_TANK_HAPTICS_MAX_DURATION_MS  1000  // 한 번에 요청하는 진동 시간 상한 (길면 이어서 다시 보낸다)
+#define RC_TANK_HAPTICS_ALL_SEATS        ((1u << RC_TANK_CREW_SEATS) - 1)
+
+typedef enum {
+    RC_TANK_HAPTIC_CONNECT = 0,    // 좌석 배정
+    RC_TANK_HAPTIC_CANNON_RECOIL,  // 포 발사 반동
+    RC_TANK_HAPTIC_MACHINE_GUN,    // 기관총 연사 (효과와 같은 3초)
+    RC_TANK_HAPTIC_MOTOR_LIMIT,    // 모터 과전류 (정지/걸림) 로 출력 제한 시작
+    RC_TANK_HAPTIC_LOW_BATTERY,    // 배터리 잔량 최저 단계 진입
+    RC_TANK_HAPTIC_MAX
+} rc_tank_haptic_t;
+
+// 진동 구간 / 컨트롤러에 보낼 진동 요청
+typedef struct {
+    uint16_t duration_ms;
+    uint8_t weak;     // 약한 모터 (고주파) 0 ~ 255
+    uint8_t strong;   // 강한 모터 (저주파) 0 ~ 255
+} rc_tank_rumble_t;
+
+// 함수 선언
+// 임의 스레드: 이벤트 발생. seat_mask 의 좌석마다 포락선을 처음부터 재생한다
+void rc_tank_haptics_post(rc_tank_haptic_t event, uint32_t seat_mask);
+// BT 스레드: 좌석 컨트롤러에 지금 보낼 진동 요청이 있으면 out 을 채우고 true
+bool rc_tank_haptics_poll(uint8_t seat, int64_t now_us, rc_tank_rumble_t* out);
+// BT 스레드: 좌석을 비우거나 바꿀 때 재생 중인 포락선을 지운다
+void rc_tank_haptics_reset_seat(uint8_t seat);
+void rc_tank_haptics_register_cmds(void);
+
+#endif // RC_TANK_HAPTICS_H
@@ -0,0 +1,157 @@
+#include "rc_tank_loop.h"
+#include "rc_tank.h"
+#include "rc_tank_failsafe.h"
+#include "rc_tank_turret.h"
+#include "rc_tank_crew.h"
+#include "rc_tank_record.h"
+#include "esp_console.h"
+#include "esp_log.h"
+#include "esp_timer.h"
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+#include <stdio.h>
+#include <string.h>
+
+static const char* TAG = "RC_TANK_LOOP";
+
+#define CONTROL_PERIOD_US (1000000 / RC_TANK_CONTROL_RATE_HZ)
+
+static esp_timer_handle_t control_timer = NULL;
+static TaskHandle_t control_task_handle = NULL;
+static volatile int64_t tick_fire_us = 0;
+static rc_tank_loop_stats_t loop_stats = {0};
+
+// esp_timer 콜백: 제어 태스크를 깨우기만 한다
+static void control_timer_cb(void* arg) {
+    tick_fire_us = esp_timer_get_time();
+    xTaskNotifyGive(control_task_handle);
+}
+
+static void control_tick(void) {
+    static rc_tank_failsafe_stage_t prev_stage = RC_TANK_FAILSAFE_OK;
+    rc_tank_input_t input;
+    // 좌석별 입력을 역할 (트랙/터렛) 담당 좌석 기준으로 합친다
+    int8_t links[RC_TANK_CREW_LINKS];
+    int link_count = rc_tank_crew_merge(&input, links);
+    int64_t now = esp_timer_get_time();
+
+    // 재생 중이면 기록된 입력으로 대신한다 (컨트롤러 링크는 판정하지 않음)
+    if (rc_tank_record_replay_input(&input)) {
+        link_count = 0;
+    } else {
+        rc_tank_record_input(&input, now);
+    }
+
+    // 센서 (터렛 위치/배터리/전류) 갱신, 전압 강하 예측 시 출력 배율 조정
+    rc_tank_update_state();
+
+    // 입력이 끊긴 시간에 따라 단계적으로 출력 제한
+    rc_tank_failsafe_stage_t stage = rc_tank_failsafe_update(links, link_count, now);
+    rc_tank_set_track_limit(stage == RC_TANK_FAILSAFE_CLAMP ? rc_tank_failsafe_clamp_speed() : 255);
+    if (stage == RC_TANK_FAILSAFE_BRAKE && prev_stage != RC_TANK_FAILSAFE_BRAKE) {
+        rc_tank_stop();
+    }
+    if (stage >= RC_TANK_FAILSAFE_COAST && prev_stage < RC_TANK_FAILSAFE_COAST) {
+        // 입력이 끊기면 진행 중인 터렛 위치 명령도 멈춘다
+        rc_tank_turret_cancel();
+    }
+    prev_stage = stage;
+
+    if (!input.active || stage >= RC_TANK_FAILSAFE_COAST) {
+        rc_tank_control_from_gamepad(&(rc_tank_input_t){.link = -1});
+    } else {
+        // 트랙 제어 (조종수 스틱/트리거, 주행 모드), 터렛/마운트 (포수 D-PAD)
+        rc_tank_control_from_gamepad(&input);
+    }
+
+    // 터렛: 센서를 읽어 수동 속도 또는 위치 PID 출력을 목표로 설정
+    rc_tank_turret_update();
+
+    // 목표 속도까지 가감속 후 출력
+    rc_tank_update_outputs();
+    rc_tank_record_outputs(now);
+}
+
+static void control_task(void* arg) {
+    for (;;) {
+        uint32_t pending = ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
+        int64_t start = esp_timer_get_time();
+
+        // 알림이 누적되었다면 이전 틱을 처리하지 못한 것
+        if (pending > 1) {
+            loop_stats.overruns += pending - 1;
+        }
+
+        control_tick();
+
+        int64_t end = esp_timer_get_time();
+        uint32_t latency = (uint32_t)(start - tick_fire_us);
+        uint32_t exec = (uint32_t)(end - start);
+
+        loop_stats.ticks++;
+        loop_stats.last_latency_us = latency;
+        loop_stats.last_exec_us = exec;
+        if (latency > loop_stats.max_latency_us) loop_stats.max_latency_us = latency;
+        if (exec > loop_stats.max_exec_us) loop_stats.max_exec_us = exec;
+    }
+}
+
+void rc_tank_loop_init(void) {
+    if (xTaskCreate(control_task, "tank_ctrl", RC_TANK_CONTROL_TASK_STACK, NULL, RC_TANK_CONTROL_TASK_PRIORITY,
+                    &control_task_handle) != pdPASS) {
+        ESP_LOGE(TAG, "Control task creation failed");
+        return;
+    }
+
+    const esp_timer_create_args_t timer_args = {
+        .callback = control_timer_cb,
+        .arg = NULL,
+        .dispatch_method = ESP_TIMER_TASK,
+        .name = "tank_ctrl",
+        .skip_unhandled_events = true,
+    };
+    ESP_ERROR_CHECK(esp_timer_create(&timer_args, &control_timer));
+    ESP_ERROR_CHECK(esp_timer_start_periodic(control_timer, CONTROL_PERIOD_US));
+
+    ESP_LOGI(TAG, "Control loop started: %d Hz", RC_TANK_CONTROL_RATE_HZ);
+}
+
+void rc_tank_loop_get_stats(rc_tank_loop_stats_t* stats) {
+    *stats = loop_stats;
+}
+
+void rc_tank_loop_reset_stats(void) {
+    memset(&loop_stats, 0, sizeof(loop_stats));
+}
+
+static int cmd_tank_loop_stats(int argc, char** argv) {
+    rc_tank_loop_stats_t stats;
+    rc_tank_loop_get_stats(&stats);
+
+    printf("Control loop: %d Hz\n", RC_TANK_CONTROL_RATE_HZ);
+    printf("  ticks:    %lu\n", (unsigned long)stats.ticks);
+    printf("  overruns: %lu\n", (unsigned long)stats.overruns);
+    printf("  latency:  last=%lu us, max=%lu us\n", (unsigned long)stats.last_latency_us,
+           (unsigned long)stats.max_latency_us);
+    printf("  exec:     last=%lu us, max=%lu us\n", (unsigned long)stats.last_exec_us,
+           (unsigned long)stats.max_exec_us);
+
+    if (argc > 1 && strcmp(argv[1], "reset") == 0) {
+        rc_tank_loop_reset_stats();
+        printf("Stats reset\n");
+    }
+    return 0;
+}
+
+void rc_tank_loop_register_cmds(void) {
+    const esp_console_cmd_t loop_stats_cmd = {
+        .command = "tank_loop_stats",
+        .help =
+            "Shows the motor control loop statistics.\n"
+            "  'tank_loop_stats reset' clears them after printing",
+        .hint = "[reset]",
+        .func = &cmd_tank_loop_stats,
+    };
+
+    ESP_ERROR_CHECK(esp_console_cmd_register(&loop_stats_cmd));
+}
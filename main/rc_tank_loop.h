@@ -0,0 +1,28 @@
+#ifndef RC_TANK_LOOP_H
+#define RC_TANK_LOOP_H
+
+#include <stdint.h>
+#include <stdbool.h>
+
+// 제어 루프 설정
+#define RC_TANK_CONTROL_RATE_HZ       200
+#define RC_TANK_CONTROL_TASK_STACK    3072
+#define RC_TANK_CONTROL_TASK_PRIORITY 6
+
+// 제어 루프 통계
+typedef struct {
+    uint32_t ticks;            // 실행된 틱 수
+    uint32_t overruns;         // 처리하지 못하고 건너뛴 틱 수
+    uint32_t last_latency_us;  // 타이머 발생 ~ 틱 시작
+    uint32_t max_latency_us;
+    uint32_t last_exec_us;     // 틱 실행 시간
+    uint32_t max_exec_us;
+} rc_tank_loop_stats_t;
+
+// 함수 선언
+void rc_tank_loop_init(void);
+void rc_tank_loop_get_stats(rc_tank_loop_stats_t* stats);
+void rc_tank_loop_reset_stats(void);
+void rc_tank_loop_register_cmds(void);
+
+#endif // RC_TANK_LOOP_H
@@ -0,0 +1,192 @@
+#include "rc_tank_power.h"
+#include "rc_tank.h"
+#include "rc_tank_hal.h"
+#include "rc_tank_haptics.h"
+#include "rc_tank_loop.h"
+#include "esp_console.h"
+#include "esp_log.h"
+#include <stdio.h>
+#include <string.h>
+
+static const char* TAG = "RC_TANK_POWER";
+
+#define IIR_FRAC_BITS 4  // 필터 상태는 mV/mA * 16
+
+// 리튬이온 셀 무부하 전압 (0%, 10%, ..., 100%)
+static const uint16_t cell_ocv_mv[11] = {3300, 3600, 3690, 3750, 3790, 3830, 3870, 3920, 3980, 4060, 4200};
+
+// 제어 루프에서만 갱신. 잔량 단계는 BT 스레드에서 읽는다.
+static bool have_sample = false;
+static int32_t fast_mv_q4 = 0;
+static int32_t rest_mv_q4 = 0;       // 무부하 전압 추정
+static int32_t current_ma_q4 = 0;
+static int32_t slope_mv_s = 0;       // 빠른 필터 전압의 변화율 (필터 적용)
+static uint16_t scale_q8 = 256;
+static rc_tank_power_status_t status = {.level = -1, .scale_q8 = 256};
+static volatile int8_t soc_level = -1;
+static bool over_current = false;
+
+static inline void iir(int32_t* y_q4, int32_t x, int shift) {
+    *y_q4 += ((x << IIR_FRAC_BITS) - *y_q4) >> shift;
+}
+
+static uint8_t cell_mv_to_soc(int32_t cell_mv) {
+    if (cell_mv <= cell_ocv_mv[0]) return 0;
+    if (cell_mv >= cell_ocv_mv[10]) return 100;
+    int i = 0;
+    while (cell_mv > cell_ocv_mv[i + 1]) i++;
+    return (uint8_t)(i * 10 + (cell_mv - cell_ocv_mv[i]) * 10 / (cell_ocv_mv[i + 1] - cell_ocv_mv[i]));
+}
+
+// 잔량 단계: 현재 단계 경계를 히스테리시스 이상 벗어날 때만 바꾼다
+static int8_t soc_to_level(uint8_t soc, int8_t level) {
+    const int step = 100 / RC_TANK_POWER_LEVELS;
+    int raw = soc / step;
+    if (raw >= RC_TANK_POWER_LEVELS) raw = RC_TANK_POWER_LEVELS - 1;
+    if (level < 0) return (int8_t)raw;
+    if (raw > level && soc >= (level + 1) * step + RC_TANK_POWER_LEVEL_HYST_PCT) return (int8_t)raw;
+    if (raw < level && soc + RC_TANK_POWER_LEVEL_HYST_PCT <= level * step) return (int8_t)raw;
+    return level;
+}
+
+void rc_tank_power_update(void) {
+    int32_t battery_mv, current_ma;
+    if (!rc_tank_hal_read_power(&battery_mv, &current_ma)) {
+        // 센서 없음: 제한하지 않는다
+        if (status.valid) {
+            ESP_LOGW(TAG, "Power sensing lost, output limit released");
+        }
+        status.valid = false;
+        have_sample = false;
+        scale_q8 = 256;
+        rc_tank_set_output_scale(scale_q8);
+        return;
+    }
+    if (current_ma < 0) current_ma = 0;
+
+    if (!have_sample) {
+        fast_mv_q4 = battery_mv << IIR_FRAC_BITS;
+        rest_mv_q4 = (battery_mv + current_ma * RC_TANK_POWER_INTERNAL_MOHM / 1000) << IIR_FRAC_BITS;
+        current_ma_q4 = current_ma << IIR_FRAC_BITS;
+        slope_mv_s = 0;
+        status.min_mv = battery_mv;
+        have_sample = true;
+    }
+
+    int32_t prev_fast = fast_mv_q4;
+    iir(&fast_mv_q4, battery_mv, RC_TANK_POWER_FAST_SHIFT);
+    iir(&current_ma_q4, current_ma, RC_TANK_POWER_FAST_SHIFT);
+
+    // 변화율 (mV/s) 도 같은 필터로 거른다
+    int32_t slope = ((fast_mv_q4 - prev_fast) * RC_TANK_CONTROL_RATE_HZ) >> IIR_FRAC_BITS;
+    slope_mv_s += (slope - slope_mv_s) >> RC_TANK_POWER_FAST_SHIFT;
+
+    int32_t fast_mv = fast_mv_q4 >> IIR_FRAC_BITS;
+    int32_t filtered_ma = current_ma_q4 >> IIR_FRAC_BITS;
+
+    // 떨어지는 중일 때만 추세를 반영 (회복 중에는 현재 전압 기준)
+    int32_t predicted = fast_mv;
+    if (slope_mv_s < 0) {
+        predicted += slope_mv_s * RC_TANK_POWER_PREDICT_MS / 1000;
+    }
+
+    // 예측 전압: 경고 ~ 위험 사이를 256 ~ 0 으로
+    int32_t target = 256;
+    if (predicted <= RC_TANK_POWER_CRITICAL_MV) {
+        target = 0;
+    } else if (predicted < RC_TANK_POWER_WARN_MV) {
+        target = (predicted - RC_TANK_POWER_CRITICAL_MV) * 256 / (RC_TANK_POWER_WARN_MV - RC_TANK_POWER_CRITICAL_MV);
+    }
+    // 전류 한계: 측정 전류가 출력 변화를 늦게 따라오므로 비율 대신 일정량씩 줄인다
+    if (filtered_ma > RC_TANK_POWER_CURRENT_LIMIT_MA) {
+        int32_t limit = (scale_q8 > RC_TANK_POWER_CURRENT_STEP) ? scale_q8 - RC_TANK_POWER_CURRENT_STEP : 0;
+        if (limit < target) target = limit;
+        if (!over_current) {
+            // 트랙 걸림/정지 등으로 과전류: 조종을 맡은 좌석에 진동으로 알린다
+            int seat = rc_tank_crew_role_seat(RC_TANK_ROLE_TRACKS);
+            rc_tank_haptics_post(RC_TANK_HAPTIC_MOTOR_LIMIT, seat >= 0 ? 1u << seat : RC_TANK_HAPTICS_ALL_SEATS);
+        }
+    }
+    over_current = filtered_ma > RC_TANK_POWER_CURRENT_LIMIT_MA;
+
+    // 줄일 때는 즉시, 풀 때는 천천히
+    if (target < scale_q8) {
+        if (scale_q8 == 256) {
+            status.throttle_events++;
+            ESP_LOGW(TAG, "Output limited: predicted=%ld mV, current=%ld mA", (long)predicted, (long)filtered_ma);
+        }
+        scale_q8 = (uint16_t)target;
+    } else if (scale_q8 < 256) {
+        scale_q8 = (scale_q8 + RC_TANK_POWER_RELEASE_PER_TICK > target) ? (uint16_t)target
+                                                                           : scale_q8 + RC_TANK_POWER_RELEASE_PER_TICK;
+    }
+    rc_tank_set_output_scale(scale_q8);
+
+    // 잔량: 측정 전압에 내부 저항 강하를 더해 무부하 전압으로 환산한 뒤 느린 필터로 거른다
+    iir(&rest_mv_q4, fast_mv + filtered_ma * RC_TANK_POWER_INTERNAL_MOHM / 1000, RC_TANK_POWER_SLOW_SHIFT);
+    int32_t rest_mv = rest_mv_q4 >> IIR_FRAC_BITS;
+    uint8_t soc = cell_mv_to_soc(rest_mv / RC_TANK_POWER_CELLS);
+    int8_t level = soc_to_level(soc, status.level);
+    if (level == 0 && status.level != 0) {
+        rc_tank_haptics_post(RC_TANK_HAPTIC_LOW_BATTERY, RC_TANK_HAPTICS_ALL_SEATS);
+    }
+
+    status.valid = true;
+    status.battery_mv = fast_mv;
+    status.rest_mv = rest_mv;
+    status.predicted_mv = predicted;
+    status.current_ma = filtered_ma;
+    if (fast_mv < status.min_mv) status.min_mv = fast_mv;
+    if (filtered_ma > status.max_current_ma) status.max_current_ma = filtered_ma;
+    status.soc_pct = soc;
+    status.level = level;
+    status.scale_q8 = scale_q8;
+    soc_level = level;
+}
+
+void rc_tank_power_get_status(rc_tank_power_status_t* out) {
+    *out = status;
+    if (!out->valid) {
+        out->level = -1;
+    }
+}
+
+int rc_tank_power_get_level(void) {
+    return status.valid ? soc_level : -1;
+}
+
+static int cmd_tank_power(int argc, char** argv) {
+    rc_tank_power_status_t st;
+    rc_tank_power_get_status(&st);
+
+    if (!st.valid) {
+        printf("Power sensing unavailable\n");
+        return 0;
+    }
+    printf("Battery: %ld mV (at rest %ld mV, predicted %ld mV, min %ld mV), SoC %u%% (level %d/%d)\n",
+           (long)st.battery_mv, (long)st.rest_mv, (long)st.predicted_mv, (long)st.min_mv, st.soc_pct,
+           st.level + 1, RC_TANK_POWER_LEVELS);
+    printf("Motor current: %ld mA (max %ld mA)\n", (long)st.current_ma, (long)st.max_current_ma);
+    printf("Output scale: %u%% (limited %lu times)\n", st.scale_q8 * 100 / 256, (unsigned long)st.throttle_events);
+
+    if (argc > 1 && strcmp(argv[1], "reset") == 0) {
+        status.min_mv = status.battery_mv;
+        status.max_current_ma = 0;
+        status.throttle_events = 0;
+        printf("Stats reset\n");
+    }
+    return 0;
+}
+
+void rc_tank_power_register_cmds(void) {
+    const esp_console_cmd_t power_cmd = {
+        .command = "tank_power",
+        .help =
+            "Shows the battery voltage, motor current, state of charge and output limit.\n"
+            "  'tank_power reset' clears the min/max statistics after printing",
+        .hint = "[reset]",
+        .func = &cmd_tank_power,
+    };
+
+    ESP_ERROR_CHECK(esp_console_cmd_register(&power_cmd));
+}
@@ -0,0 +1,53 @@
+#ifndef RC_TANK_POWER_H
+#define RC_TANK_POWER_H
+
+#include <stdint.h>
+#include <stdbool.h>
+
+// 전원 감시
+// 배터리 전압/모터 전류를 제어 틱마다 IIR 필터로 거르고, 전압 추세로 잠시 뒤의 전압을 예측한다.
+// 예측 전압이 경고 전압 아래로 내려가면 트랙/터렛 출력을 줄여 전압 강하로 인한 리셋을 막는다.
+
+// 배터리 (2S 리튬이온)
+#define RC_TANK_POWER_CELLS             2
+#define RC_TANK_POWER_INTERNAL_MOHM     150    // 팩 내부 저항 (무부하 전압 추정용)
+
+// 출력 제한
+#define RC_TANK_POWER_WARN_MV           6400   // 예측 전압이 이보다 낮으면 출력 제한 시작
+#define RC_TANK_POWER_CRITICAL_MV       5800   // 이 전압에서 출력 0 (레귤레이터 드롭아웃 여유)
+#define RC_TANK_POWER_CURRENT_LIMIT_MA  3000
+#define RC_TANK_POWER_PREDICT_MS        30     // 전압 추세로 이 시간 뒤 전압을 예측
+#define RC_TANK_POWER_RELEASE_PER_TICK  2      // 제한 해제 속도 (Q8 / 제어 틱, 256 이면 약 0.6초)
+#define RC_TANK_POWER_CURRENT_STEP      8      // 전류 한계 초과 시 틱마다 줄이는 양 (Q8)
+
+// IIR: y += (x - y) >> shift (제어 틱 200Hz 기준)
+#define RC_TANK_POWER_FAST_SHIFT        2      // 시정수 약 20ms (강하 감지)
+#define RC_TANK_POWER_SLOW_SHIFT        10     // 시정수 약 5초 (무부하 전압 추정 -> 잔량)
+
+// 잔량 단계 (컨트롤러 LED 표시). 경계에서 깜빡이지 않도록 히스테리시스 적용
+#define RC_TANK_POWER_LEVELS            4
+#define RC_TANK_POWER_LEVEL_HYST_PCT    3
+
+typedef struct {
+    bool valid;                // 센서 값 있음
+    int32_t battery_mv;        // 빠른 필터
+    int32_t rest_mv;           // 무부하 전압 추정 (느린 필터)
+    int32_t predicted_mv;
+    int32_t current_ma;
+    int32_t min_mv;            // 관측된 최저 전압 (빠른 필터)
+    int32_t max_current_ma;
+    uint8_t soc_pct;
+    int8_t level;              // -1: 알 수 없음, 0 ~ RC_TANK_POWER_LEVELS-1
+    uint16_t scale_q8;         // 출력 배율 (256 = 제한 없음)
+    uint32_t throttle_events;  // 제한 시작 횟수
+} rc_tank_power_status_t;
+
+// 함수 선언
+// 제어 루프: 아날로그 입력을 읽고 출력 배율 갱신 (rc_tank_update_state() 에서 호출)
+void rc_tank_power_update(void);
+void rc_tank_power_get_status(rc_tank_power_status_t* out);
+// 임의 스레드: 잔량 단계 (-1: 알 수 없음)
+int rc_tank_power_get_level(void);
+void rc_tank_power_register_cmds(void);
+
+#endif // RC_TANK_POWER_H
@@ -0,0 +1,111 @@
+#include "rc_tank_ramp.h"
+#include "esp_log.h"
+#include <stdlib.h>
+
+static const char* TAG = "RC_TANK_RAMP";
+
+// 채널 상태. 속도는 Q8 고정소수점 (255 << 8 = 최대 속도)
+typedef struct {
+    rc_tank_ramp_profile_t profile;
+    int32_t accel_step;    // 틱당 변화량 (Q8)
+    int32_t decel_step;
+    int32_t reverse_step;
+    uint16_t hold_ticks;
+    uint16_t hold_left;
+    int32_t target;
+    int32_t current;
+} ramp_state_t;
+
+static ramp_state_t ramps[RC_TANK_RAMP_MAX];
+static uint32_t ramp_rate_hz = 1;
+
+// 초당 변화량 -> 틱당 변화량 (Q8), 최소 1
+static int32_t per_tick_step(uint16_t per_s) {
+    int32_t step = ((int32_t)per_s << 8) / (int32_t)ramp_rate_hz;
+    return step > 0 ? step : 1;
+}
+
+static void compute_steps(ramp_state_t* r) {
+    r->accel_step = per_tick_step(r->profile.accel_per_s);
+    r->decel_step = per_tick_step(r->profile.decel_per_s);
+    r->reverse_step = per_tick_step(r->profile.reverse_per_s);
+    r->hold_ticks = (uint16_t)((r->profile.reverse_hold_ms * ramp_rate_hz) / 1000);
+}
+
+static int32_t step_toward(int32_t cur, int32_t target, int32_t step) {
+    if (cur < target) {
+        return (target - cur > step) ? cur + step : target;
+    }
+    return (cur - target > step) ? cur - step : target;
+}
+
+void rc_tank_ramp_init(uint32_t control_rate_hz) {
+    const rc_tank_ramp_profile_t track = RC_TANK_RAMP_TRACK_PROFILE;
+    const rc_tank_ramp_profile_t turret = RC_TANK_RAMP_TURRET_PROFILE;
+
+    ramp_rate_hz = control_rate_hz > 0 ? control_rate_hz : 1;
+
+    for (int i = 0; i < RC_TANK_RAMP_MAX; i++) {
+        ramps[i] = (ramp_state_t){0};
+        ramps[i].profile = (i == RC_TANK_RAMP_TURRET) ? turret : track;
+        compute_steps(&ramps[i]);
+    }
+
+    ESP_LOGI(TAG, "Ramp initialized: %lu Hz, track accel=%d/s decel=%d/s", (unsigned long)ramp_rate_hz,
+             track.accel_per_s, track.decel_per_s);
+}
+
+void rc_tank_ramp_set_profile(rc_tank_ramp_channel_t ch, const rc_tank_ramp_profile_t* profile) {
+    if (ch >= RC_TANK_RAMP_MAX) return;
+    ramps[ch].profile = *profile;
+    compute_steps(&ramps[ch]);
+}
+
+void rc_tank_ramp_get_profile(rc_tank_ramp_channel_t ch, rc_tank_ramp_profile_t* profile) {
+    if (ch >= RC_TANK_RAMP_MAX) return;
+    *profile = ramps[ch].profile;
+}
+
+void rc_tank_ramp_set_target(rc_tank_ramp_channel_t ch, int target) {
+    if (ch >= RC_TANK_RAMP_MAX) return;
+    ramps[ch].target = (int32_t)target * 256;
+}
+
+int rc_tank_ramp_update(rc_tank_ramp_channel_t ch) {
+    ramp_state_t* r = &ramps[ch];
+    int32_t cur = r->current;
+    int32_t target = r->target;
+
+    if (cur == target) {
+        r->hold_left = 0;
+        return cur / 256;
+    }
+
+    // 방향 전환 중 0에서 대기
+    if (r->hold_left > 0) {
+        r->hold_left--;
+        return 0;
+    }
+
+    if ((cur > 0 && target < 0) || (cur < 0 && target > 0)) {
+        // 반대 방향 명령: 먼저 0까지 감속
+        cur = step_toward(cur, 0, r->reverse_step);
+        if (cur == 0) {
+            r->hold_left = r->hold_ticks;
+        }
+    } else if (abs(target) > abs(cur)) {
+        cur = step_toward(cur, target, r->accel_step);
+    } else {
+        cur = step_toward(cur, target, r->decel_step);
+    }
+
+    r->current = cur;
+    return cur / 256;
+}
+
+void rc_tank_ramp_reset(rc_tank_ramp_channel_t ch) {
+    if (ch >= RC_TANK_RAMP_MAX) return;
+    ramps[ch].target = 0;
+    ramps[ch].current = 0;
+    ramps[ch].hold_left = 0;
+}
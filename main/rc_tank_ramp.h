@@ -0,0 +1,40 @@
+#ifndef RC_TANK_RAMP_H
+#define RC_TANK_RAMP_H
+
+#include <stdint.h>
+#include <stdbool.h>
+
+// 가감속 채널
+typedef enum {
+    RC_TANK_RAMP_LEFT = 0,
+    RC_TANK_RAMP_RIGHT,
+    RC_TANK_RAMP_TURRET,
+    RC_TANK_RAMP_MAX
+} rc_tank_ramp_channel_t;
+
+// 가감속 프로파일 (속도 단위/초, 최대 속도 255 기준)
+typedef struct {
+    uint16_t accel_per_s;     // |속도| 증가
+    uint16_t decel_per_s;     // |속도| 감소 (같은 방향)
+    uint16_t reverse_per_s;   // 반대 방향 명령으로 0을 향해 감속할 때
+    uint16_t reverse_hold_ms; // 방향 전환 시 0에서 대기하는 시간
+} rc_tank_ramp_profile_t;
+
+// 기본 프로파일
+// 트랙: 0 -> 255 400ms, 255 -> 0 200ms, 역회전 시 0에서 50ms 정지
+#define RC_TANK_RAMP_TRACK_PROFILE  {.accel_per_s = 640, .decel_per_s = 1280, .reverse_per_s = 1020, .reverse_hold_ms = 50}
+// 터렛: 0 -> 128 100ms, 정지 50ms
+#define RC_TANK_RAMP_TURRET_PROFILE {.accel_per_s = 1280, .decel_per_s = 2560, .reverse_per_s = 2560, .reverse_hold_ms = 30}
+
+// 함수 선언
+// control_rate_hz: rc_tank_ramp_update() 호출 주기
+void rc_tank_ramp_init(uint32_t control_rate_hz);
+void rc_tank_ramp_set_profile(rc_tank_ramp_channel_t ch, const rc_tank_ramp_profile_t* profile);
+void rc_tank_ramp_get_profile(rc_tank_ramp_channel_t ch, rc_tank_ramp_profile_t* profile);
+void rc_tank_ramp_set_target(rc_tank_ramp_channel_t ch, int target);
+// 한 틱 진행 후 현재 출력 속도 반환 (-255 ~ 255)
+int rc_tank_ramp_update(rc_tank_ramp_channel_t ch);
+// 가감속 없이 즉시 정지
+void rc_tank_ramp_reset(rc_tank_ramp_channel_t ch);
+
+#endif // RC_TANK_RAMP_H
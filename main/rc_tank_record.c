@@ -0,0 +1,742 @@
+#include "rc_tank_record.h"
+#include "rc_tank.h"
+#include "rc_tank_bindings.h"
+#include "rc_tank_crew.h"
+#include "rc_tank_hal.h"
+#include "rc_tank_loop.h"
+#include "esp_console.h"
+#include "esp_log.h"
+#include "esp_timer.h"
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+#include <stddef.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+static const char* TAG = "RC_TANK_RECORD";
+
+// 저장 형식
+// 헤더 다음에 레코드가 이어진다. 지운 플래시 (0xFF) 나 끝 표시를 만나면 끝이고, 정상 종료된 기록은 헤더의 길이까지만 읽는다.
+// 레코드 첫 바이트: 종류 (상위 2비트) | 플래그 (3비트) | 경과 시간 (하위 3비트)
+//   경과 시간 = 이전 레코드로부터 지난 제어 틱 수 (0~6). 7 이면 varint 가 뒤따른다.
+// - INPUT : 플래그 비트마다 axis_y 델타, axis_ry 델타 (양자화 값, zigzag varint), 확장 바이트.
+//           확장 바이트 비트마다 D-PAD/활성 바이트, axis_x, axis_rx, throttle, brake 델타가 뒤따른다
+// - BUTTONS: 플래그 = 좌석, 본문 = 이전 상태와의 XOR (varint)
+// - OUTPUT: 플래그 비트마다 좌/우 트랙, 터렛 모터 속도 델타 (zigzag varint)
+// - MARK  : 플래그 0 = 끝. 0xFF (플래그 7, 시간 7) 는 지운 플래시
+#define RECORD_MAGIC    0x474C5454  // "TTLG"
+#define RECORD_VERSION  2
+#define RECORD_TICK_US  (1000000 / RC_TANK_CONTROL_RATE_HZ)
+
+#define TYPE_INPUT      0
+#define TYPE_BUTTONS    1
+#define TYPE_OUTPUT     2
+#define TYPE_MARK       3
+#define MARK_END        0
+#define TIME_VARINT     7
+#define VARINT_MAX      5
+#define RECORD_MAX      (1 + INPUT_AXES * VARINT_MAX + 2)
+
+#define INPUT_AXIS_Y    0x1
+#define INPUT_AXIS_RY   0x2
+#define INPUT_EXT       0x4
+// 확장 바이트 (주행 모드에 따라 쓰는 축만 바뀌므로 자주 바뀌는 Y축 두 개만 플래그에 둔다)
+#define EXT_DPAD        0x01
+#define EXT_AXIS_X      0x02   // 이후 비트는 axes[2] 부터 차례로
+#define INPUT_AXES      6      // axis_y, axis_ry, axis_x, axis_rx, throttle, brake
+
+#define OUTPUT_COUNT    3
+
+typedef struct {
+    uint32_t magic;
+    uint16_t version;
+    uint16_t tick_us;   // 경과 시간 단위
+    uint32_t length;    // 정상 종료 시 기록 길이. 0xFFFFFFFF 면 중간에 끊긴 기록
+    uint32_t reserved;
+} record_header_t;
+
+#define HEADER_LENGTH_OFFSET offsetof(record_header_t, length)
+
+// 기록 태스크에 보내는 명령 (알림 비트)
+#define CMD_START  (1u << 0)
+#define CMD_PLAY   (1u << 1)
+#define CMD_STOP   (1u << 2)
+
+static TaskHandle_t record_task_handle = NULL;
+static volatile rc_tank_record_mode_t mode = RC_TANK_RECORD_IDLE;
+// 기록을 시작할 때마다 증가. 생산자는 이 값이 바뀌면 자신의 마지막 기록 값을 지운다
+static volatile uint32_t session = 0;
+
+// 생산자 -> 기록 태스크 링 (ring_mux 로 보호)
+static uint8_t ring[RC_TANK_RECORD_RING_SIZE];
+static uint32_t ring_head = 0;
+static uint32_t ring_tail = 0;
+static int64_t ring_last_tick = 0;
+static uint32_t ring_dropped = 0;
+static portMUX_TYPE ring_mux = portMUX_INITIALIZER_UNLOCKED;
+
+// 기록 태스크 전용: 쓰는 중인 페이지
+static uint8_t page[RC_TANK_RECORD_PAGE_SIZE];
+static uint32_t page_fill = 0;
+static uint32_t page_offset = 0;
+static uint32_t log_size = 0;
+
+// 재생 (기록 태스크에서 게시, 제어 루프에서 읽음)
+static rc_tank_input_snapshot_t replay_input;
+
+//
+// 부호화
+//
+static uint32_t put_varint(uint8_t* p, uint32_t v) {
+    uint32_t n = 0;
+    while (v >= 0x80) {
+        p[n++] = (uint8_t)(v | 0x80);
+        v >>= 7;
+    }
+    p[n++] = (uint8_t)v;
+    return n;
+}
+
+static uint32_t zigzag(int32_t v) {
+    return ((uint32_t)v << 1) ^ (uint32_t)(v >> 31);
+}
+
+static int32_t unzigzag(uint32_t v) {
+    return (int32_t)(v >> 1) ^ -(int32_t)(v & 1);
+}
+
+// 레코드 추가 (생산자 스레드). 경과 시간은 링에 들어가는 순서대로 매겨야 하므로 임계 구역 안에서 계산
+static bool append(uint8_t type, uint8_t flags, int64_t now_us, const uint8_t* body, uint32_t body_len) {
+    uint8_t head[1 + VARINT_MAX];
+    bool ok = false;
+
+    portENTER_CRITICAL(&ring_mux);
+    if (mode == RC_TANK_RECORD_RECORDING) {
+        int64_t tick = now_us / RECORD_TICK_US;
+        // 다른 스레드의 시각이 조금 늦게 올 수 있다. 시간은 거꾸로 가지 않게 0 으로 기록
+        uint32_t dt = tick > ring_last_tick ? (uint32_t)(tick - ring_last_tick) : 0;
+        uint32_t n = 1;
+        if (dt < TIME_VARINT) {
+            head[0] = (uint8_t)((type << 6) | (flags << 3) | dt);
+        } else {
+            head[0] = (uint8_t)((type << 6) | (flags << 3) | TIME_VARINT);
+            n += put_varint(&head[1], dt);
+        }
+
+        if (RC_TANK_RECORD_RING_SIZE - (ring_head - ring_tail) >= n + body_len) {
+            for (uint32_t i = 0; i < n; i++) {
+                ring[ring_head++ % RC_TANK_RECORD_RING_SIZE] = head[i];
+            }
+            for (uint32_t i = 0; i < body_len; i++) {
+                ring[ring_head++ % RC_TANK_RECORD_RING_SIZE] = body[i];
+            }
+            if (tick > ring_last_tick) ring_last_tick = tick;
+            ok = true;
+        } else {
+            ring_dropped++;
+        }
+    }
+    portEXIT_CRITICAL(&ring_mux);
+    return ok;
+}
+
+static uint8_t pack_dpad(const rc_tank_input_t* in) {
+    return (uint8_t)((in->dpad_x + 1) | ((in->dpad_y + 1) << 2) | (in->active ? 0x10 : 0));
+}
+
+static void quantize_axes(const rc_tank_input_t* in, int16_t out[INPUT_AXES]) {
+    out[0] = (int16_t)(in->axis_y >> RC_TANK_RECORD_AXIS_SHIFT);
+    out[1] = (int16_t)(in->axis_ry >> RC_TANK_RECORD_AXIS_SHIFT);
+    out[2] = (int16_t)(in->axis_x >> RC_TANK_RECORD_AXIS_SHIFT);
+    out[3] = (int16_t)(in->axis_rx >> RC_TANK_RECORD_AXIS_SHIFT);
+    out[4] = (int16_t)(in->throttle >> RC_TANK_RECORD_AXIS_SHIFT);
+    out[5] = (int16_t)(in->brake >> RC_TANK_RECORD_AXIS_SHIFT);
+}
+
+void rc_tank_record_input(const rc_tank_input_t* input, int64_t now_us) {
+    // 제어 루프 전용
+    static uint32_t seen_session = 0;
+    static int16_t last[INPUT_AXES];
+    static uint8_t last_dpad = 0;
+
+    if (mode != RC_TANK_RECORD_RECORDING) {
+        return;
+    }
+    if (seen_session != session) {
+        seen_session = session;
+        memset(last, 0, sizeof(last));
+        last_dpad = pack_dpad(&(rc_tank_input_t){0});
+    }
+
+    int16_t axes[INPUT_AXES];
+    quantize_axes(input, axes);
+    uint8_t dpad = pack_dpad(input);
+    uint8_t body[RECORD_MAX];
+    uint32_t n = 0;
+    uint8_t flags = 0;
+
+    if (axes[0] != last[0]) {
+        flags |= INPUT_AXIS_Y;
+        n += put_varint(&body[n], zigzag(axes[0] - last[0]));
+    }
+    if (axes[1] != last[1]) {
+        flags |= INPUT_AXIS_RY;
+        n += put_varint(&body[n], zigzag(axes[1] - last[1]));
+    }
+    uint8_t ext = 0;
+    uint32_t ext_pos = n++;
+    if (dpad != last_dpad) {
+        ext |= EXT_DPAD;
+        body[n++] = dpad;
+    }
+    for (int i = 2; i < INPUT_AXES; i++) {
+        if (axes[i] != last[i]) {
+            ext |= EXT_AXIS_X << (i - 2);
+            n += put_varint(&body[n], zigzag(axes[i] - last[i]));
+        }
+    }
+    if (ext != 0) {
+        flags |= INPUT_EXT;
+        body[ext_pos] = ext;
+    } else {
+        n--;
+    }
+    // 기록에 실패하면 마지막 값을 그대로 두어 다음 레코드가 빠진 변화까지 담게 한다
+    if (flags != 0 && append(TYPE_INPUT, flags, now_us, body, n)) {
+        memcpy(last, axes, sizeof(last));
+        last_dpad = dpad;
+    }
+}
+
+void rc_tank_record_outputs(int64_t now_us) {
+    // 제어 루프 전용
+    static uint32_t seen_session = 0;
+    static int16_t last[OUTPUT_COUNT];
+    static uint32_t div = 0;
+
+    if (mode != RC_TANK_RECORD_RECORDING || ++div < RC_TANK_RECORD_OUTPUT_DIV) {
+        return;
+    }
+    div = 0;
+    if (seen_session != session) {
+        seen_session = session;
+        memset(last, 0, sizeof(last));
+    }
+
+    const int16_t now[OUTPUT_COUNT] = {
+        (int16_t)rc_tank.left_track_speed,
+        (int16_t)rc_tank.right_track_speed,
+        (int16_t)rc_tank.turret_speed,
+    };
+    uint8_t body[RECORD_MAX];
+    uint32_t n = 0;
+    uint8_t flags = 0;
+    for (int i = 0; i < OUTPUT_COUNT; i++) {
+        if (now[i] != last[i]) {
+            flags |= 1u << i;
+            n += put_varint(&body[n], zigzag(now[i] - last[i]));
+        }
+    }
+    if (flags != 0 && append(TYPE_OUTPUT, flags, now_us, body, n)) {
+        memcpy(last, now, sizeof(last));
+    }
+}
+
+void rc_tank_record_buttons(uint8_t seat, uint32_t state, int64_t now_us) {
+    // BT 스레드 전용
+    static uint32_t seen_session = 0;
+    static uint32_t last[RC_TANK_CREW_SEATS];
+
+    if (mode != RC_TANK_RECORD_RECORDING || seat >= RC_TANK_CREW_SEATS) {
+        return;
+    }
+    if (seen_session != session) {
+        seen_session = session;
+        memset(last, 0, sizeof(last));
+    }
+    if (state == last[seat]) {
+        return;
+    }
+
+    uint8_t body[VARINT_MAX];
+    uint32_t n = put_varint(body, state ^ last[seat]);
+    if (append(TYPE_BUTTONS, seat, now_us, body, n)) {
+        last[seat] = state;
+    }
+}
+
+//
+// 기록 태스크: 링 -> 플래시 페이지
+//
+static bool page_flush(void) {
+    if (page_offset + RC_TANK_RECORD_PAGE_SIZE > log_size) {
+        return false;
+    }
+    // 섹터의 첫 페이지를 쓸 때 다음 섹터를 미리 지운다 (페이지 16개에 한 번).
+    // 섹터 끝에서 전원이 끊겨도 그 뒤는 항상 지운 플래시라 이전 기록이 이어 읽히지 않는다
+    if (page_offset % RC_TANK_HAL_LOG_SECTOR == 0) {
+        uint32_t next = page_offset + RC_TANK_HAL_LOG_SECTOR;
+        if (page_offset == 0 && !rc_tank_hal_log_erase(0, RC_TANK_HAL_LOG_SECTOR)) {
+            return false;
+        }
+        if (next + RC_TANK_HAL_LOG_SECTOR <= log_size && !rc_tank_hal_log_erase(next, RC_TANK_HAL_LOG_SECTOR)) {
+            return false;
+        }
+    }
+    if (!rc_tank_hal_log_write(page_offset, page, RC_TANK_RECORD_PAGE_SIZE)) {
+        return false;
+    }
+    page_offset += RC_TANK_RECORD_PAGE_SIZE;
+    page_fill = 0;
+    memset(page, 0xFF, sizeof(page));
+    return true;
+}
+
+static void writer_finish(void) {
+    portENTER_CRITICAL(&ring_mux);
+    mode = RC_TANK_RECORD_IDLE;
+    uint32_t dropped = ring_dropped;
+    portEXIT_CRITICAL(&ring_mux);
+
+    // 남은 링을 비우고 끝 표시를 붙인 뒤 마지막 페이지를 0xFF 로 채워 쓴다
+    bool ok = true;
+    while (ok && ring_tail != ring_head) {
+        page[page_fill++] = ring[ring_tail++ % RC_TANK_RECORD_RING_SIZE];
+        if (page_fill == RC_TANK_RECORD_PAGE_SIZE) ok = page_flush();
+    }
+    if (ok) {
+        page[page_fill++] = (uint8_t)((TYPE_MARK << 6) | (MARK_END << 3));
+        uint32_t length = page_offset + page_fill;
+        ok = page_flush() && rc_tank_hal_log_write(HEADER_LENGTH_OFFSET, &length, sizeof(length));
+        ESP_LOGI(TAG, "Recording stopped: %lu bytes, %lu records dropped", (unsigned long)length,
+                 (unsigned long)dropped);
+    }
+    if (!ok) {
+        ESP_LOGW(TAG, "Recording ended early (log full or flash error)");
+    }
+}
+
+static void writer_begin(void) {
+    log_size = rc_tank_hal_log_size();
+    if (log_size < RC_TANK_HAL_LOG_SECTOR) {
+        ESP_LOGE(TAG, "No recording storage");
+        return;
+    }
+
+    memset(page, 0xFF, sizeof(page));
+    const record_header_t header = {
+        .magic = RECORD_MAGIC,
+        .version = RECORD_VERSION,
+        .tick_us = RECORD_TICK_US,
+        .length = 0xFFFFFFFF,
+        .reserved = 0xFFFFFFFF,
+    };
+    memcpy(page, &header, sizeof(header));
+    page_fill = sizeof(header);
+    page_offset = 0;
+
+    portENTER_CRITICAL(&ring_mux);
+    ring_head = ring_tail = 0;
+    ring_dropped = 0;
+    ring_last_tick = esp_timer_get_time() / RECORD_TICK_US;
+    session++;
+    mode = RC_TANK_RECORD_RECORDING;
+    portEXIT_CRITICAL(&ring_mux);
+
+    ESP_LOGI(TAG, "Recording started (%lu KB available)", (unsigned long)(log_size / 1024));
+}
+
+// 링에 쌓인 바이트를 페이지로 옮기고, 페이지가 차면 쓴다.
+// 생산자는 링 머리만, 기록 태스크는 꼬리만 움직이므로 꼬리 갱신만 임계 구역에서 한다
+static void writer_drain(void) {
+    for (;;) {
+        portENTER_CRITICAL(&ring_mux);
+        uint32_t head = ring_head;
+        portEXIT_CRITICAL(&ring_mux);
+        if (ring_tail == head) {
+            return;
+        }
+
+        uint32_t tail = ring_tail;
+        while (tail != head && page_fill < RC_TANK_RECORD_PAGE_SIZE) {
+            page[page_fill++] = ring[tail++ % RC_TANK_RECORD_RING_SIZE];
+        }
+        portENTER_CRITICAL(&ring_mux);
+        ring_tail = tail;
+        portEXIT_CRITICAL(&ring_mux);
+
+        if (page_fill == RC_TANK_RECORD_PAGE_SIZE && !page_flush()) {
+            ESP_LOGW(TAG, "Recording storage full, stopping");
+            portENTER_CRITICAL(&ring_mux);
+            mode = RC_TANK_RECORD_IDLE;
+            portEXIT_CRITICAL(&ring_mux);
+            uint32_t length = page_offset;
+            rc_tank_hal_log_write(HEADER_LENGTH_OFFSET, &length, sizeof(length));
+            return;
+        }
+    }
+}
+
+//
+// 읽기 (재생/요약)
+//
+typedef struct {
+    uint32_t pos;
+    uint32_t end;    // 정상 종료된 기록이면 헤더의 길이, 아니면 저장 공간 끝
+    uint32_t base;   // buf 에 들어 있는 페이지의 위치
+    bool loaded;
+    uint8_t buf[RC_TANK_RECORD_PAGE_SIZE];
+} reader_t;
+
+typedef struct {
+    uint8_t type;
+    uint8_t flags;
+    uint32_t dt;
+    uint32_t value[INPUT_AXES];
+    uint8_t ext;
+    uint8_t dpad;
+} record_t;
+
+static bool reader_byte(reader_t* r, uint8_t* out) {
+    if (r->pos >= r->end) {
+        return false;
+    }
+    uint32_t base = r->pos - r->pos % RC_TANK_RECORD_PAGE_SIZE;
+    if (!r->loaded || base != r->base) {
+        if (base + RC_TANK_RECORD_PAGE_SIZE > rc_tank_hal_log_size() ||
+            !rc_tank_hal_log_read(base, r->buf, RC_TANK_RECORD_PAGE_SIZE)) {
+            return false;
+        }
+        r->base = base;
+        r->loaded = true;
+    }
+    *out = r->buf[r->pos++ - base];
+    return true;
+}
+
+static bool reader_varint(reader_t* r, uint32_t* out) {
+    uint32_t v = 0;
+    for (int i = 0; i < VARINT_MAX; i++) {
+        uint8_t b;
+        if (!reader_byte(r, &b)) return false;
+        v |= (uint32_t)(b & 0x7F) << (7 * i);
+        if ((b & 0x80) == 0) {
+            *out = v;
+            return true;
+        }
+    }
+    return false;
+}
+
+static bool reader_open(reader_t* r) {
+    record_header_t header;
+    memset(r, 0, sizeof(*r));
+    if (rc_tank_hal_log_size() < RC_TANK_HAL_LOG_SECTOR || !rc_tank_hal_log_read(0, &header, sizeof(header))) {
+        return false;
+    }
+    if (header.magic != RECORD_MAGIC || header.version != RECORD_VERSION || header.tick_us != RECORD_TICK_US) {
+        return false;
+    }
+    r->pos = sizeof(header);
+    r->end = header.length;
+    if (header.length == 0xFFFFFFFF || header.length > rc_tank_hal_log_size()) {
+        r->end = rc_tank_hal_log_size();
+    }
+    return true;
+}
+
+// 다음 레코드. 끝이거나 읽을 수 없으면 false
+static bool reader_next(reader_t* r, record_t* rec) {
+    uint8_t tag;
+    if (!reader_byte(r, &tag)) return false;
+
+    rec->type = tag >> 6;
+    rec->flags = (tag >> 3) & 0x7;
+    rec->dt = tag & 0x7;
+    if (rec->type == TYPE_MARK) {
+        return false;
+    }
+    if (rec->dt == TIME_VARINT && !reader_varint(r, &rec->dt)) return false;
+
+    switch (rec->type) {
+        case TYPE_INPUT:
+            if ((rec->flags & INPUT_AXIS_Y) && !reader_varint(r, &rec->value[0])) return false;
+            if ((rec->flags & INPUT_AXIS_RY) && !reader_varint(r, &rec->value[1])) return false;
+            rec->ext = 0;
+            if ((rec->flags & INPUT_EXT) && !reader_byte(r, &rec->ext)) return false;
+            if ((rec->ext & EXT_DPAD) && !reader_byte(r, &rec->dpad)) return false;
+            for (int i = 2; i < INPUT_AXES; i++) {
+                if ((rec->ext & (EXT_AXIS_X << (i - 2))) && !reader_varint(r, &rec->value[i])) return false;
+            }
+            return true;
+        case TYPE_BUTTONS:
+            return rec->flags < RC_TANK_CREW_SEATS && reader_varint(r, &rec->value[0]);
+        case TYPE_OUTPUT:
+            for (int i = 0; i < OUTPUT_COUNT; i++) {
+                if ((rec->flags & (1u << i)) && !reader_varint(r, &rec->value[i])) return false;
+            }
+            return true;
+        default:
+            return false;
+    }
+}
+
+bool rc_tank_record_scan(rc_tank_record_info_t* out) {
+    reader_t r;
+    record_t rec;
+    memset(out, 0, sizeof(*out));
+    if (!reader_open(&r)) {
+        return false;
+    }
+
+    uint64_t ticks = 0;
+    while (reader_next(&r, &rec)) {
+        ticks += rec.dt;
+        out->records++;
+    }
+    uint32_t length;
+    out->complete = rc_tank_hal_log_read(HEADER_LENGTH_OFFSET, &length, sizeof(length)) && length != 0xFFFFFFFF;
+    out->bytes = r.pos;
+    out->duration_ms = (uint32_t)(ticks * RECORD_TICK_US / 1000);
+    return true;
+}
+
+//
+// 재생 (기록 태스크)
+//
+static struct {
+    reader_t reader;
+    record_t next;
+    bool has_next;
+    int64_t start_us;
+    uint64_t next_tick;
+    rc_tank_input_t input;
+    int16_t axes[INPUT_AXES];  // 양자화 값
+    uint32_t buttons[RC_TANK_CREW_SEATS];
+    int16_t outputs[OUTPUT_COUNT];
+    int32_t max_output_error;  // 기록된 출력과 실제 출력의 최대 차이 (회귀 확인용)
+} replay;
+
+static void replay_read_next(void) {
+    replay.has_next = reader_next(&replay.reader, &replay.next);
+    if (replay.has_next) {
+        replay.next_tick += replay.next.dt;
+    }
+}
+
+static void replay_finish(void) {
+    mode = RC_TANK_RECORD_IDLE;
+    for (int i = 0; i < RC_TANK_CREW_SEATS; i++) {
+        rc_tank_bindings_reset_seat(i);
+    }
+    rc_tank_input_snapshot_publish(&replay_input, &(rc_tank_input_t){.link = -1});
+    ESP_LOGI(TAG, "Replay finished, max output error %ld", (long)replay.max_output_error);
+}
+
+static void replay_begin(void) {
+    memset(&replay, 0, sizeof(replay));
+    if (!reader_open(&replay.reader)) {
+        ESP_LOGE(TAG, "No valid recording to replay");
+        return;
+    }
+    replay.input = (rc_tank_input_t){.link = -1, .active = true};
+    replay.start_us = esp_timer_get_time();
+    for (int i = 0; i < RC_TANK_CREW_SEATS; i++) {
+        rc_tank_bindings_reset_seat(i);
+    }
+    rc_tank_input_snapshot_publish(&replay_input, &replay.input);
+    replay_read_next();
+    mode = RC_TANK_RECORD_REPLAYING;
+    ESP_LOGI(TAG, "Replay started");
+}
+
+static void replay_apply(const record_t* rec, int64_t now_us) {
+    switch (rec->type) {
+        case TYPE_INPUT:
+            if (rec->flags & INPUT_AXIS_Y) replay.axes[0] += (int16_t)unzigzag(rec->value[0]);
+            if (rec->flags & INPUT_AXIS_RY) replay.axes[1] += (int16_t)unzigzag(rec->value[1]);
+            for (int i = 2; i < INPUT_AXES; i++) {
+                if (rec->ext & (EXT_AXIS_X << (i - 2))) replay.axes[i] += (int16_t)unzigzag(rec->value[i]);
+            }
+            if (rec->ext & EXT_DPAD) {
+                replay.input.dpad_x = (int8_t)((rec->dpad & 0x3) - 1);
+                replay.input.dpad_y = (int8_t)(((rec->dpad >> 2) & 0x3) - 1);
+                replay.input.active = (rec->dpad & 0x10) != 0;
+            }
+            replay.input.axis_y = (int16_t)(replay.axes[0] * (1 << RC_TANK_RECORD_AXIS_SHIFT));
+            replay.input.axis_ry = (int16_t)(replay.axes[1] * (1 << RC_TANK_RECORD_AXIS_SHIFT));
+            replay.input.axis_x = (int16_t)(replay.axes[2] * (1 << RC_TANK_RECORD_AXIS_SHIFT));
+            replay.input.axis_rx = (int16_t)(replay.axes[3] * (1 << RC_TANK_RECORD_AXIS_SHIFT));
+            replay.input.throttle = (int16_t)(replay.axes[4] * (1 << RC_TANK_RECORD_AXIS_SHIFT));
+            replay.input.brake = (int16_t)(replay.axes[5] * (1 << RC_TANK_RECORD_AXIS_SHIFT));
+            rc_tank_input_snapshot_publish(&replay_input, &replay.input);
+            break;
+        case TYPE_BUTTONS:
+            replay.buttons[rec->flags] ^= rec->value[0];
+            rc_tank_bindings_process(rec->flags, replay.buttons[rec->flags], now_us);
+            break;
+        case TYPE_OUTPUT: {
+            const int actual[OUTPUT_COUNT] = {rc_tank.left_track_speed, rc_tank.right_track_speed,
+                                              rc_tank.turret_speed};
+            for (int i = 0; i < OUTPUT_COUNT; i++) {
+                if (rec->flags & (1u << i)) replay.outputs[i] += (int16_t)unzigzag(rec->value[i]);
+                int32_t err = abs(actual[i] - replay.outputs[i]);
+                if (err > replay.max_output_error) replay.max_output_error = err;
+            }
+            break;
+        }
+        default:
+            break;
+    }
+}
+
+// 기한이 된 레코드를 적용하고 다음 레코드까지 기다릴 시간을 반환
+static TickType_t replay_step(void) {
+    int64_t now = esp_timer_get_time();
+    while (replay.has_next && replay.start_us + (int64_t)replay.next_tick * RECORD_TICK_US <= now) {
+        replay_apply(&replay.next, now);
+        replay_read_next();
+    }
+    if (!replay.has_next) {
+        replay_finish();
+        return portMAX_DELAY;
+    }
+    int64_t wait_ms = (replay.start_us + (int64_t)replay.next_tick * RECORD_TICK_US - now + 999) / 1000;
+    return pdMS_TO_TICKS(wait_ms);
+}
+
+static void record_task(void* arg) {
+    TickType_t wait = portMAX_DELAY;
+
+    for (;;) {
+        uint32_t cmd = 0;
+        xTaskNotifyWait(0, UINT32_MAX, &cmd, wait);
+
+        if (cmd & CMD_STOP) {
+            if (mode == RC_TANK_RECORD_RECORDING) {
+                writer_finish();
+            } else if (mode == RC_TANK_RECORD_REPLAYING) {
+                replay_finish();
+            }
+        }
+        if ((cmd & CMD_START) && mode == RC_TANK_RECORD_IDLE) {
+            writer_begin();
+        }
+        if ((cmd & CMD_PLAY) && mode == RC_TANK_RECORD_IDLE) {
+            replay_begin();
+        }
+
+        if (mode == RC_TANK_RECORD_RECORDING) {
+            writer_drain();
+            wait = pdMS_TO_TICKS(RC_TANK_RECORD_FLUSH_MS);
+        } else if (mode == RC_TANK_RECORD_REPLAYING) {
+            wait = replay_step();
+        } else {
+            wait = portMAX_DELAY;
+        }
+    }
+}
+
+void rc_tank_record_init(void) {
+    rc_tank_input_snapshot_init(&replay_input);
+    if (xTaskCreate(record_task, "tank_record", RC_TANK_RECORD_TASK_STACK, NULL, RC_TANK_RECORD_TASK_PRIORITY,
+                    &record_task_handle) != pdPASS) {
+        ESP_LOGE(TAG, "Record task creation failed");
+    }
+}
+
+bool rc_tank_record_start(void) {
+    if (record_task_handle == NULL || mode != RC_TANK_RECORD_IDLE || rc_tank_hal_log_size() == 0) {
+        return false;
+    }
+    xTaskNotify(record_task_handle, CMD_START, eSetBits);
+    return true;
+}
+
+bool rc_tank_record_play(void) {
+    if (record_task_handle == NULL || mode != RC_TANK_RECORD_IDLE) {
+        return false;
+    }
+    xTaskNotify(record_task_handle, CMD_PLAY, eSetBits);
+    return true;
+}
+
+void rc_tank_record_stop(void) {
+    if (record_task_handle != NULL) {
+        xTaskNotify(record_task_handle, CMD_STOP, eSetBits);
+    }
+}
+
+rc_tank_record_mode_t rc_tank_record_mode(void) {
+    return mode;
+}
+
+bool rc_tank_record_replay_input(rc_tank_input_t* input) {
+    if (mode != RC_TANK_RECORD_REPLAYING) {
+        return false;
+    }
+    if (input->active &&
+        (abs(input->axis_y) > RC_TANK_RECORD_TAKEOVER || abs(input->axis_ry) > RC_TANK_RECORD_TAKEOVER ||
+         abs(input->axis_x) > RC_TANK_RECORD_TAKEOVER || abs(input->axis_rx) > RC_TANK_RECORD_TAKEOVER ||
+         input->throttle > RC_TANK_RECORD_TAKEOVER || input->brake > RC_TANK_RECORD_TAKEOVER)) {
+        // 재생 태스크가 멈출 때까지 몇 틱 동안은 조종수 입력을 그대로 쓴다
+        rc_tank_record_stop();
+        return false;
+    }
+    rc_tank_input_snapshot_read(&replay_input, input);
+    return true;
+}
+
+static int cmd_tank_record(int argc, char** argv) {
+    static const char* const mode_names[] = {"idle", "recording", "replaying"};
+
+    if (argc > 1 && strcmp(argv[1], "start") == 0) {
+        if (!rc_tank_record_start()) {
+            printf("Cannot start recording (busy or no storage)\n");
+            return 1;
+        }
+        return 0;
+    }
+    if (argc > 1 && strcmp(argv[1], "play") == 0) {
+        if (!rc_tank_record_play()) {
+            printf("Cannot replay while %s\n", mode_names[mode]);
+            return 1;
+        }
+        return 0;
+    }
+    if (argc > 1 && strcmp(argv[1], "stop") == 0) {
+        rc_tank_record_stop();
+        return 0;
+    }
+
+    printf("Session recorder: %s\n", mode_names[mode]);
+    if (mode == RC_TANK_RECORD_RECORDING) {
+        printf("  written: %lu bytes, dropped: %lu records\n", (unsigned long)(page_offset + page_fill),
+               (unsigned long)ring_dropped);
+        return 0;
+    }
+    rc_tank_record_info_t info;
+    if (!rc_tank_record_scan(&info)) {
+        printf("  no recording (storage %lu KB)\n", (unsigned long)(rc_tank_hal_log_size() / 1024));
+        return 0;
+    }
+    printf("  recording: %lu bytes, %lu records, %lu.%03lu s%s\n", (unsigned long)info.bytes,
+           (unsigned long)info.records, (unsigned long)(info.duration_ms / 1000),
+           (unsigned long)(info.duration_ms % 1000), info.complete ? "" : " (incomplete)");
+    return 0;
+}
+
+void rc_tank_record_register_cmds(void) {
+    const esp_console_cmd_t record_cmd = {
+        .command = "tank_record",
+        .help =
+            "Records a driving session to flash or replays it.\n"
+            "  'tank_record start' / 'stop' records, 'tank_record play' replays,\n"
+            "  without arguments shows the stored recording",
+        .hint = "[start | stop | play]",
+        .func = &cmd_tank_record,
+    };
+
+    ESP_ERROR_CHECK(esp_console_cmd_register(&record_cmd));
+}
@@ -0,0 +1,58 @@
+#ifndef RC_TANK_RECORD_H
+#define RC_TANK_RECORD_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "rc_tank_snapshot.h"
+
+// 주행 기록/재생
+// 입력 (합친 스틱/D-PAD, 좌석별 버튼) 과 모터 출력의 변화분만 델타/varint 로 부호화해
+// 플래시 파티션에 이어 쓴다. 생산자 (제어 루프/BT 스레드) 는 RAM 링에 몇 바이트를 복사할 뿐이고,
+// 플래시 지우기/쓰기는 기록 태스크가 페이지 단위로 모아서 한다.
+// 재생은 기록된 입력을 같은 시간 간격으로 제어 루프와 바인딩 표에 다시 넣는다.
+// 버튼 동작 중 효과와 터렛만 재생하고, 속도 배율/주행 모드/블루투스 검색은 현재 상태를 그대로 둔다
+// (재생이 설정을 저장하거나 BT 상태를 바꾸지 않도록).
+#define RC_TANK_RECORD_PAGE_SIZE     256    // 플래시 프로그램 단위
+#define RC_TANK_RECORD_RING_SIZE     2048   // 생산자 -> 기록 태스크 버퍼
+#define RC_TANK_RECORD_FLUSH_MS      50     // 기록 중 링을 비우는 주기
+#define RC_TANK_RECORD_AXIS_SHIFT    2      // 스틱 값 양자화 (트랙 속도 분해능 수준)
+#define RC_TANK_RECORD_OUTPUT_DIV    10     // 모터 출력은 제어 틱 10번에 한 번 (20Hz) 확인
+#define RC_TANK_RECORD_TAKEOVER      128    // 재생 중 이보다 큰 스틱/트리거 입력이 오면 재생을 멈춘다
+#define RC_TANK_RECORD_TASK_STACK    3072
+#define RC_TANK_RECORD_TASK_PRIORITY 2
+
+typedef enum {
+    RC_TANK_RECORD_IDLE = 0,
+    RC_TANK_RECORD_RECORDING,
+    RC_TANK_RECORD_REPLAYING,
+} rc_tank_record_mode_t;
+
+// 저장된 기록 요약
+typedef struct {
+    uint32_t bytes;        // 헤더 포함 길이
+    uint32_t records;
+    uint32_t duration_ms;
+    bool complete;         // 정상 종료됨 (아니면 전원이 끊기는 등으로 중간까지만 남음)
+} rc_tank_record_info_t;
+
+// 함수 선언
+void rc_tank_record_init(void);
+// 기록/재생 시작과 정지. 실제 작업은 기록 태스크에서 한다
+bool rc_tank_record_start(void);
+bool rc_tank_record_play(void);
+void rc_tank_record_stop(void);
+rc_tank_record_mode_t rc_tank_record_mode(void);
+// 제어 루프: 합친 입력 (양자화 후 바뀐 필드만 기록)
+void rc_tank_record_input(const rc_tank_input_t* input, int64_t now_us);
+// 제어 루프: 모터 출력 (매 틱 호출, 내부에서 솎아낸다)
+void rc_tank_record_outputs(int64_t now_us);
+// BT 스레드: 좌석 버튼 상태 (rc_tank_bindings 입력 상태 워드)
+void rc_tank_record_buttons(uint8_t seat, uint32_t state, int64_t now_us);
+// 제어 루프: 재생 중이면 input 을 기록된 입력으로 바꾸고 true.
+// 조종수가 스틱을 크게 움직이면 재생을 멈추고 false
+bool rc_tank_record_replay_input(rc_tank_input_t* input);
+// 저장된 기록을 처음부터 읽어 요약한다. 기록이 없거나 형식이 다르면 false
+bool rc_tank_record_scan(rc_tank_record_info_t* out);
+void rc_tank_record_register_cmds(void);
+
+#endif // RC_TANK_RECORD_H
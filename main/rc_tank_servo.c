@@ -0,0 +1,301 @@
+#include "rc_tank_servo.h"
+#include "rc_tank_settings.h"
+#include "esp_console.h"
+#include "esp_log.h"
+#include "esp_timer.h"
+#include "freertos/FreeRTOS.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+static const char* TAG = "RC_TANK_SERVO";
+
+typedef struct {
+    const char* name;
+    int max_angle;
+    uint16_t* lut;             // 정수 각도 -> duty (max_angle + 1 개)
+    // 설정 (servo_mux 로 보호)
+    int32_t max_speed_mdps;    // 0.001도/초
+    int32_t accel_mdps2;       // 0.001도/초^2
+    rc_tank_servo_config_t config;
+    int32_t target_mdeg;
+    bool jump;                 // 다음 프레임에 궤적 없이 이동
+    // 궤적 상태 (타이머 전용)
+    bool started;
+    int32_t pos_mdeg;
+    int32_t vel_mdps;
+    uint32_t duty;
+} servo_state_t;
+
+static uint16_t mount_lut[MOUNT_MAX_ANGLE + 1];
+static uint16_t cannon_lut[CANNON_MAX_ANGLE + 1];
+
+static servo_state_t servos[RC_TANK_HAL_SERVO_MAX] = {
+    [RC_TANK_HAL_SERVO_MOUNT] = {.name = "mount", .max_angle = MOUNT_MAX_ANGLE, .lut = mount_lut},
+    [RC_TANK_HAL_SERVO_CANNON] = {.name = "cannon", .max_angle = CANNON_MAX_ANGLE, .lut = cannon_lut},
+};
+
+static portMUX_TYPE servo_mux = portMUX_INITIALIZER_UNLOCKED;
+static esp_timer_handle_t frame_timer = NULL;
+
+// 보정 테이블: 각도 -> 펄스 폭 (min ~ max) -> duty (50Hz, RC_TANK_SERVO_DUTY_BITS)
+static void build_lut(uint16_t* lut, int max_angle, const rc_tank_servo_config_t* c, int trim) {
+    const uint32_t max_duty = (1 << RC_TANK_SERVO_DUTY_BITS) - 1;
+    const uint32_t period_us = 1000000 / LEDC_FREQUENCY;
+    const int32_t span = (int32_t)c->max_pulse_us - c->min_pulse_us;
+    for (int angle = 0; angle <= max_angle; angle++) {
+        int32_t pulse_us = c->min_pulse_us + (angle + trim) * span / max_angle;
+        if (pulse_us < c->min_pulse_us) pulse_us = c->min_pulse_us;
+        if (pulse_us > c->max_pulse_us) pulse_us = c->max_pulse_us;
+        lut[angle] = (uint16_t)((max_duty * (uint32_t)pulse_us + period_us / 2) / period_us);
+    }
+}
+
+static uint32_t isqrt64(uint64_t v) {
+    uint64_t r = 0;
+    uint64_t bit = 1ULL << 62;
+    while (bit > v) bit >>= 2;
+    while (bit != 0) {
+        if (v >= r + bit) {
+            v -= r + bit;
+            r = (r >> 1) + bit;
+        } else {
+            r >>= 1;
+        }
+        bit >>= 2;
+    }
+    return (uint32_t)r;
+}
+
+uint32_t rc_tank_servo_angle_to_duty(rc_tank_hal_servo_t servo, int32_t angle_mdeg) {
+    const servo_state_t* s = &servos[servo];
+    if (angle_mdeg <= 0) return s->lut[0];
+    if (angle_mdeg >= s->max_angle * 1000) return s->lut[s->max_angle];
+
+    // 1도 간격 테이블을 선형 보간
+    int i = angle_mdeg / 1000;
+    int32_t frac = angle_mdeg % 1000;
+    return s->lut[i] + ((int32_t)(s->lut[i + 1] - s->lut[i]) * frac) / 1000;
+}
+
+// 한 프레임 궤적 진행: 남은 거리에서 멈출 수 있는 속도 sqrt(2 * a * d) 와 최대 속도 중 작은 쪽을 향해
+// 가속도 한계 안에서 속도를 바꾼다 (사다리꼴/삼각 속도 프로파일)
+static void servo_step(servo_state_t* s, int32_t target, int32_t vmax, int32_t accel) {
+    int32_t err = target - s->pos_mdeg;
+    int32_t dv = accel / (1000 / RC_TANK_SERVO_FRAME_MS);
+
+    if (err == 0 && s->vel_mdps == 0) {
+        return;
+    }
+
+    int32_t v_stop = (int32_t)isqrt64(2ULL * (uint64_t)accel * (uint64_t)abs(err));
+    int32_t v_des = (v_stop < vmax) ? v_stop : vmax;
+    if (err < 0) v_des = -v_des;
+
+    if (s->vel_mdps < v_des) {
+        s->vel_mdps = (s->vel_mdps + dv < v_des) ? s->vel_mdps + dv : v_des;
+    } else if (s->vel_mdps > v_des) {
+        s->vel_mdps = (s->vel_mdps - dv > v_des) ? s->vel_mdps - dv : v_des;
+    }
+
+    s->pos_mdeg += s->vel_mdps * RC_TANK_SERVO_FRAME_MS / 1000;
+
+    // 목표를 지나쳤거나 한 프레임 안에 멈출 수 있으면 목표에 고정
+    int32_t remaining = target - s->pos_mdeg;
+    if ((err > 0 && remaining <= 0) || (err < 0 && remaining >= 0) ||
+        (abs(remaining) * (1000 / RC_TANK_SERVO_FRAME_MS) <= dv && abs(s->vel_mdps) <= dv)) {
+        s->pos_mdeg = target;
+        s->vel_mdps = 0;
+    }
+}
+
+void rc_tank_servo_update(void) {
+    for (int i = 0; i < RC_TANK_HAL_SERVO_MAX; i++) {
+        servo_state_t* s = &servos[i];
+
+        portENTER_CRITICAL(&servo_mux);
+        int32_t target = s->target_mdeg;
+        int32_t vmax = s->max_speed_mdps;
+        int32_t accel = s->accel_mdps2;
+        bool jump = s->jump;
+        s->jump = false;
+        portEXIT_CRITICAL(&servo_mux);
+
+        if (jump) {
+            s->pos_mdeg = target;
+            s->vel_mdps = 0;
+            portENTER_CRITICAL(&servo_mux);
+            s->duty = rc_tank_servo_angle_to_duty((rc_tank_hal_servo_t)i, target);
+            portEXIT_CRITICAL(&servo_mux);
+            rc_tank_hal_set_servo_duty((rc_tank_hal_servo_t)i, s->duty);
+            s->started = true;
+            continue;
+        }
+        if (!s->started) {
+            continue;
+        }
+
+        servo_step(s, target, vmax, accel);
+
+        // 같은 duty 면 LEDC 를 건드리지 않는다 (정지 중에는 CPU 부하 없음)
+        portENTER_CRITICAL(&servo_mux);
+        uint32_t duty = rc_tank_servo_angle_to_duty((rc_tank_hal_servo_t)i, s->pos_mdeg);
+        portEXIT_CRITICAL(&servo_mux);
+        if (duty != s->duty) {
+            s->duty = duty;
+            rc_tank_hal_set_servo_duty((rc_tank_hal_servo_t)i, duty);
+        }
+    }
+}
+
+static void frame_timer_cb(void* arg) {
+    rc_tank_servo_update();
+}
+
+void rc_tank_servo_init(void) {
+    const rc_tank_servo_config_t mount = RC_TANK_SERVO_MOUNT_DEFAULT_CONFIG;
+    const rc_tank_servo_config_t cannon = RC_TANK_SERVO_CANNON_DEFAULT_CONFIG;
+    rc_tank_servo_set_config(RC_TANK_HAL_SERVO_MOUNT, &mount, 0);
+    rc_tank_servo_set_config(RC_TANK_HAL_SERVO_CANNON, &cannon, 0);
+
+    const esp_timer_create_args_t timer_args = {
+        .callback = frame_timer_cb,
+        .arg = NULL,
+        .dispatch_method = ESP_TIMER_TASK,
+        .name = "tank_servo",
+        .skip_unhandled_events = true,
+    };
+    ESP_ERROR_CHECK(esp_timer_create(&timer_args, &frame_timer));
+    ESP_ERROR_CHECK(esp_timer_start_periodic(frame_timer, RC_TANK_SERVO_FRAME_MS * 1000));
+
+    ESP_LOGI(TAG, "Servo trajectory timer started: %d ms frames", RC_TANK_SERVO_FRAME_MS);
+}
+
+void rc_tank_servo_set_config(rc_tank_hal_servo_t servo, const rc_tank_servo_config_t* config, int trim) {
+    servo_state_t* s = &servos[servo];
+    rc_tank_servo_config_t c = *config;
+    uint16_t lut[MOUNT_MAX_ANGLE + 1];
+
+    // 펄스 폭은 일반적인 서보 범위 안에서만 허용
+    if (c.min_pulse_us < 400) c.min_pulse_us = 400;
+    if (c.max_pulse_us > 2600) c.max_pulse_us = 2600;
+    if (c.max_pulse_us <= c.min_pulse_us) c.max_pulse_us = c.min_pulse_us + 1;
+    if (c.max_speed_dps == 0) c.max_speed_dps = 1;
+    if (c.max_accel_dps2 == 0) c.max_accel_dps2 = 1;
+
+    build_lut(lut, s->max_angle, &c, trim);
+
+    portENTER_CRITICAL(&servo_mux);
+    memcpy(s->lut, lut, (s->max_angle + 1) * sizeof(uint16_t));
+    s->config = c;
+    s->max_speed_mdps = c.max_speed_dps * 1000;
+    s->accel_mdps2 = c.max_accel_dps2 * 1000;
+    portEXIT_CRITICAL(&servo_mux);
+}
+
+void rc_tank_servo_get_config(rc_tank_hal_servo_t servo, rc_tank_servo_config_t* config) {
+    portENTER_CRITICAL(&servo_mux);
+    *config = servos[servo].config;
+    portEXIT_CRITICAL(&servo_mux);
+}
+
+void rc_tank_servo_set_target(rc_tank_hal_servo_t servo, int angle) {
+    servo_state_t* s = &servos[servo];
+    if (angle < 0) angle = 0;
+    if (angle > s->max_angle) angle = s->max_angle;
+
+    portENTER_CRITICAL(&servo_mux);
+    s->target_mdeg = angle * 1000;
+    portEXIT_CRITICAL(&servo_mux);
+}
+
+void rc_tank_servo_jump(rc_tank_hal_servo_t servo, int angle) {
+    rc_tank_servo_set_target(servo, angle);
+    portENTER_CRITICAL(&servo_mux);
+    servos[servo].jump = true;
+    portEXIT_CRITICAL(&servo_mux);
+}
+
+bool rc_tank_servo_is_moving(rc_tank_hal_servo_t servo) {
+    const servo_state_t* s = &servos[servo];
+    return s->vel_mdps != 0 || s->pos_mdeg != s->target_mdeg;
+}
+
+int32_t rc_tank_servo_get_position(rc_tank_hal_servo_t servo) {
+    return servos[servo].pos_mdeg;
+}
+
+static int find_servo(const char* name) {
+    for (int i = 0; i < RC_TANK_HAL_SERVO_MAX; i++) {
+        if (strcmp(servos[i].name, name) == 0) return i;
+    }
+    return -1;
+}
+
+// 콘솔에서 바꾼 보정/제한은 설정에 반영 (지연 저장, 적용은 설정 모듈이 한다)
+static void update_settings(int servo, const rc_tank_servo_config_t* c) {
+    rc_tank_settings_t s;
+    rc_tank_settings_get(&s);
+    s.servo[servo] = *c;
+    rc_tank_settings_set(&s);
+}
+
+static int cmd_tank_servo(int argc, char** argv) {
+    if (argc >= 5 && (strcmp(argv[1], "pulse") == 0 || strcmp(argv[1], "profile") == 0)) {
+        int servo = find_servo(argv[2]);
+        if (servo < 0) {
+            printf("Unknown servo: %s\n", argv[2]);
+            return 1;
+        }
+        rc_tank_servo_config_t c;
+        rc_tank_servo_get_config(servo, &c);
+        if (strcmp(argv[1], "pulse") == 0) {
+            c.min_pulse_us = (uint16_t)atoi(argv[3]);
+            c.max_pulse_us = (uint16_t)atoi(argv[4]);
+        } else {
+            c.max_speed_dps = (uint16_t)atoi(argv[3]);
+            c.max_accel_dps2 = (uint16_t)atoi(argv[4]);
+        }
+        update_settings(servo, &c);
+        return 0;
+    }
+    if (argc >= 4 && strcmp(argv[1], "move") == 0) {
+        int servo = find_servo(argv[2]);
+        if (servo < 0) {
+            printf("Unknown servo: %s\n", argv[2]);
+            return 1;
+        }
+        rc_tank_servo_set_target(servo, atoi(argv[3]));
+        return 0;
+    }
+    if (argc >= 2) {
+        printf("Unknown arguments\n");
+        return 1;
+    }
+
+    for (int i = 0; i < RC_TANK_HAL_SERVO_MAX; i++) {
+        rc_tank_servo_config_t c;
+        rc_tank_servo_get_config(i, &c);
+        const servo_state_t* s = &servos[i];
+        printf("%-6s pos=%ld target=%ld (0.001 deg), vel=%ld, duty=%lu\n", s->name, (long)s->pos_mdeg,
+               (long)s->target_mdeg, (long)s->vel_mdps, (unsigned long)s->duty);
+        printf("       pulse=%u..%u us, speed=%u deg/s, accel=%u deg/s^2\n", c.min_pulse_us, c.max_pulse_us,
+               c.max_speed_dps, c.max_accel_dps2);
+    }
+    return 0;
+}
+
+void rc_tank_servo_register_cmds(void) {
+    const esp_console_cmd_t servo_cmd = {
+        .command = "tank_servo",
+        .help =
+            "Shows the servo trajectories and calibration.\n"
+            "  pulse <mount|cannon> <min us> <max us>: pulse width for 0 deg and the max angle\n"
+            "  profile <mount|cannon> <deg/s> <deg/s^2>: speed and acceleration limits\n"
+            "  move <mount|cannon> <deg>: move along the trajectory",
+        .hint = "[pulse | profile | move ...]",
+        .func = &cmd_tank_servo,
+    };
+
+    ESP_ERROR_CHECK(esp_console_cmd_register(&servo_cmd));
+}
@@ -0,0 +1,49 @@
+#ifndef RC_TANK_SERVO_H
+#define RC_TANK_SERVO_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "rc_tank.h"
+#include "rc_tank_hal.h"
+
+// 서보 궤적 생성
+// 각도 명령을 바로 쓰지 않고 목표로만 기록한다. 50Hz 타이머가 속도/가속도 제한 궤적을 따라
+// 프레임마다 다음 위치를 계산해 duty 를 한 번 쓴다. 프레임이 서보 PWM 주기와 같아 펄스마다 새 위치가
+// 나가므로 프레임 사이 보간은 필요 없다 (LEDC 는 다음 주기 시작에 새 duty 를 반영).
+// 급격한 서보 기동으로 생기는 전류 스파이크 (트랙 가속과 겹치면 브라운아웃) 를 막는다.
+#define RC_TANK_SERVO_FRAME_MS   (1000 / LEDC_FREQUENCY)   // 서보 PWM 주기와 같게
+
+// 서보별 보정 및 궤적 제한 (rc_tank_settings 에 저장)
+typedef struct {
+    uint16_t min_pulse_us;    // 0도 펄스 폭
+    uint16_t max_pulse_us;    // 최대 각도 펄스 폭
+    uint16_t max_speed_dps;   // 최대 속도 (도/초)
+    uint16_t max_accel_dps2;  // 최대 가감속 (도/초^2)
+} rc_tank_servo_config_t;
+
+// 포 마운트: 천천히 부드럽게, 포신: 반동 연출을 위해 빠르게
+#define RC_TANK_SERVO_MOUNT_DEFAULT_CONFIG                                                                \
+    {.min_pulse_us = 500, .max_pulse_us = 2500, .max_speed_dps = 120, .max_accel_dps2 = 600}
+#define RC_TANK_SERVO_CANNON_DEFAULT_CONFIG                                                               \
+    {.min_pulse_us = 500, .max_pulse_us = 2500, .max_speed_dps = 600, .max_accel_dps2 = 8000}
+
+// 함수 선언
+// 궤적 타이머 시작. 서보는 rc_tank_servo_jump() 로 초기 위치를 정해야 움직이기 시작한다.
+void rc_tank_servo_init(void);
+// trim: 장착 오차 보정 (도)
+void rc_tank_servo_set_config(rc_tank_hal_servo_t servo, const rc_tank_servo_config_t* config, int trim);
+void rc_tank_servo_get_config(rc_tank_hal_servo_t servo, rc_tank_servo_config_t* config);
+// 목표 각도 (도). 현재 궤적에서 이어서 움직인다
+void rc_tank_servo_set_target(rc_tank_hal_servo_t servo, int angle);
+// 궤적 없이 바로 이동 (초기 위치)
+void rc_tank_servo_jump(rc_tank_hal_servo_t servo, int angle);
+bool rc_tank_servo_is_moving(rc_tank_hal_servo_t servo);
+// 현재 궤적 위치 (0.001도)
+int32_t rc_tank_servo_get_position(rc_tank_hal_servo_t servo);
+// 각도 (0.001도) -> LEDC duty (보정 테이블 보간)
+uint32_t rc_tank_servo_angle_to_duty(rc_tank_hal_servo_t servo, int32_t angle_mdeg);
+// 한 프레임 진행 (타이머에서 호출, 시뮬레이터에서는 직접 호출)
+void rc_tank_servo_update(void);
+void rc_tank_servo_register_cmds(void);
+
+#endif // RC_TANK_SERVO_H
@@ -0,0 +1,228 @@
+#include "rc_tank_settings.h"
+#include "rc_tank.h"
+#include "rc_tank_fixed.h"
+#include "dfplayer.h"
+#include "esp_log.h"
+#include "esp_timer.h"
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+#include "nvs.h"
+#include <stddef.h>
+#include <string.h>
+
+static const char* TAG = "RC_TANK_SETTINGS";
+
+// 저장 태스크 알림 비트
+#define NOTIFY_DIRTY (1 << 0)
+#define NOTIFY_FLUSH (1 << 1)
+
+// RAM 사본 (settings_mux 로 보호)
+static rc_tank_settings_t settings;
+static bool settings_dirty = false;
+static int64_t last_change_us = 0;
+static portMUX_TYPE settings_mux = portMUX_INITIALIZER_UNLOCKED;
+static TaskHandle_t settings_task_handle = NULL;
+
+static void set_defaults(rc_tank_settings_t* s) {
+    const rc_tank_ramp_profile_t track = RC_TANK_RAMP_TRACK_PROFILE;
+    const rc_tank_ramp_profile_t turret = RC_TANK_RAMP_TURRET_PROFILE;
+    const rc_tank_failsafe_config_t failsafe = RC_TANK_FAILSAFE_DEFAULT_CONFIG;
+    const rc_tank_turret_config_t turret_pid = RC_TANK_TURRET_DEFAULT_CONFIG;
+    const rc_tank_servo_config_t mount_servo = RC_TANK_SERVO_MOUNT_DEFAULT_CONFIG;
+    const rc_tank_servo_config_t cannon_servo = RC_TANK_SERVO_CANNON_DEFAULT_CONFIG;
+    const rc_tank_drive_config_t drive = RC_TANK_DRIVE_DEFAULT_CONFIG;
+
+    memset(s, 0, sizeof(*s));
+    s->version = RC_TANK_SETTINGS_VERSION;
+    s->size = sizeof(*s);
+    s->left_speed_multiplier = 1.0f;
+    s->right_speed_multiplier = 1.0f;
+    s->deadzone_q15 = RC_TANK_DEADZONE_Q15;
+    s->volume = DFPLAYER_DEFAULT_VOLUME;
+    s->track_ramp = track;
+    s->turret_ramp = turret;
+    s->failsafe = failsafe;
+    s->turret = turret_pid;
+    s->servo[RC_TANK_HAL_SERVO_MOUNT] = mount_servo;
+    s->servo[RC_TANK_HAL_SERVO_CANNON] = cannon_servo;
+    s->drive = drive;
+}
+
+// 설정을 각 모듈에 반영
+static void apply(const rc_tank_settings_t* s) {
+    rc_tank_set_speed_multipliers(s->left_speed_multiplier, s->right_speed_multiplier);
+    rc_tank_drive_set_config(&s->drive, s->deadzone_q15);
+    rc_tank_ramp_set_profile(RC_TANK_RAMP_LEFT, &s->track_ramp);
+    rc_tank_ramp_set_profile(RC_TANK_RAMP_RIGHT, &s->track_ramp);
+    rc_tank_ramp_set_profile(RC_TANK_RAMP_TURRET, &s->turret_ramp);
+    rc_tank_servo_set_config(RC_TANK_HAL_SERVO_MOUNT, &s->servo[RC_TANK_HAL_SERVO_MOUNT], s->mount_trim);
+    rc_tank_servo_set_config(RC_TANK_HAL_SERVO_CANNON, &s->servo[RC_TANK_HAL_SERVO_CANNON], s->cannon_trim);
+    rc_tank_failsafe_set_config(&s->failsafe);
+    rc_tank_turret_set_config(&s->turret);
+    dfplayer_set_volume(s->volume);
+}
+
+static void load(rc_tank_settings_t* s) {
+    set_defaults(s);
+
+    nvs_handle_t nvs_handle;
+    esp_err_t err = nvs_open(RC_TANK_SETTINGS_NAMESPACE, NVS_READONLY, &nvs_handle);
+    if (err != ESP_OK) {
+        ESP_LOGW(TAG, "NVS open failed, using default values: %s", esp_err_to_name(err));
+        return;
+    }
+
+    rc_tank_settings_t stored;
+    size_t size = sizeof(stored);
+    err = nvs_get_blob(nvs_handle, RC_TANK_SETTINGS_KEY, &stored, &size);
+    if (err == ESP_OK) {
+        if (size < offsetof(rc_tank_settings_t, left_speed_multiplier) || stored.size != size ||
+            stored.version > RC_TANK_SETTINGS_VERSION) {
+            ESP_LOGW(TAG, "Unknown settings (version=%d, size=%d), using default values", stored.version,
+                     (int)size);
+        } else {
+            // 이전 버전은 저장된 길이만큼만 덮어쓰고 나머지는 기본값 유지
+            memcpy(s, &stored, size);
+            s->version = RC_TANK_SETTINGS_VERSION;
+            s->size = sizeof(*s);
+            ESP_LOGI(TAG, "Settings loaded: version=%d, left=%.2f, right=%.2f, volume=%d", stored.version,
+                     s->left_speed_multiplier, s->right_speed_multiplier, s->volume);
+        }
+    } else if (err == ESP_ERR_NVS_NOT_FOUND) {
+        // 이전 버전의 속도 배율만 있는 경우 가져온다
+        float legacy[2];
+        size = sizeof(legacy);
+        if (nvs_get_blob(nvs_handle, RC_TANK_SETTINGS_LEGACY_KEY, legacy, &size) == ESP_OK) {
+            s->left_speed_multiplier = legacy[0];
+            s->right_speed_multiplier = legacy[1];
+            settings_dirty = true;
+            ESP_LOGI(TAG, "Legacy speed multiplier migrated: left=%.2f, right=%.2f", legacy[0], legacy[1]);
+        }
+    } else {
+        ESP_LOGW(TAG, "Settings load failed, using default values: %s", esp_err_to_name(err));
+    }
+
+    nvs_close(nvs_handle);
+}
+
+// 설정 blob 한 개 기록 + commit 한 번
+static void store(const rc_tank_settings_t* s) {
+    nvs_handle_t nvs_handle;
+    esp_err_t err = nvs_open(RC_TANK_SETTINGS_NAMESPACE, NVS_READWRITE, &nvs_handle);
+    if (err != ESP_OK) {
+        ESP_LOGE(TAG, "NVS open failed: %s", esp_err_to_name(err));
+        return;
+    }
+
+    err = nvs_set_blob(nvs_handle, RC_TANK_SETTINGS_KEY, s, sizeof(*s));
+    if (err == ESP_OK) {
+        err = nvs_commit(nvs_handle);
+    }
+    if (err != ESP_OK) {
+        ESP_LOGE(TAG, "Settings save failed: %s", esp_err_to_name(err));
+    } else {
+        ESP_LOGI(TAG, "Settings saved: left=%.2f, right=%.2f", s->left_speed_multiplier, s->right_speed_multiplier);
+    }
+
+    nvs_close(nvs_handle);
+}
+
+static void settings_task(void* arg) {
+    for (;;) {
+        bool dirty;
+        portENTER_CRITICAL(&settings_mux);
+        dirty = settings_dirty;
+        portEXIT_CRITICAL(&settings_mux);
+
+        // 변경 사항이 없으면 알림이 올 때까지 대기, 있으면 주기적으로 확인
+        uint32_t bits = 0;
+        xTaskNotifyWait(0, UINT32_MAX, &bits, dirty ? pdMS_TO_TICKS(RC_TANK_SETTINGS_POLL_MS) : portMAX_DELAY);
+
+        rc_tank_settings_t copy;
+        bool flush = false;
+        portENTER_CRITICAL(&settings_mux);
+        if (settings_dirty &&
+            ((bits & NOTIFY_FLUSH) || esp_timer_get_time() - last_change_us >= RC_TANK_SETTINGS_QUIET_MS * 1000LL)) {
+            copy = settings;
+            settings_dirty = false;
+            flush = true;
+        }
+        portEXIT_CRITICAL(&settings_mux);
+
+        if (flush) {
+            store(&copy);
+        }
+    }
+}
+
+static void mark_dirty(void) {
+    portENTER_CRITICAL(&settings_mux);
+    settings_dirty = true;
+    last_change_us = esp_timer_get_time();
+    portEXIT_CRITICAL(&settings_mux);
+
+    if (settings_task_handle != NULL) {
+        xTaskNotify(settings_task_handle, NOTIFY_DIRTY, eSetBits);
+    }
+}
+
+void rc_tank_settings_init(void) {
+    load(&settings);
+    apply(&settings);
+    last_change_us = esp_timer_get_time();
+
+    if (xTaskCreate(settings_task, "tank_settings", RC_TANK_SETTINGS_TASK_STACK, NULL, RC_TANK_SETTINGS_TASK_PRIORITY,
+                    &settings_task_handle) != pdPASS) {
+        ESP_LOGE(TAG, "Settings task creation failed");
+    }
+}
+
+void rc_tank_settings_get(rc_tank_settings_t* out) {
+    portENTER_CRITICAL(&settings_mux);
+    *out = settings;
+    portEXIT_CRITICAL(&settings_mux);
+}
+
+void rc_tank_settings_set(const rc_tank_settings_t* s) {
+    portENTER_CRITICAL(&settings_mux);
+    settings = *s;
+    settings.version = RC_TANK_SETTINGS_VERSION;
+    settings.size = sizeof(settings);
+    portEXIT_CRITICAL(&settings_mux);
+
+    apply(s);
+    mark_dirty();
+}
+
+void rc_tank_settings_set_speed_multipliers(float left, float right) {
+    // 범위 제한은 rc_tank 에서 하므로 적용된 값을 저장한다
+    rc_tank_set_speed_multipliers(left, right);
+
+    portENTER_CRITICAL(&settings_mux);
+    settings.left_speed_multiplier = rc_tank.left_speed_multiplier;
+    settings.right_speed_multiplier = rc_tank.right_speed_multiplier;
+    portEXIT_CRITICAL(&settings_mux);
+
+    mark_dirty();
+}
+
+void rc_tank_settings_set_drive_mode(rc_tank_drive_mode_t mode) {
+    // 주행 중 버튼으로 바뀌므로 다른 모듈은 건드리지 않고 주행 설정만 다시 적용한다
+    rc_tank_drive_config_t drive;
+    uint16_t deadzone_q15;
+
+    portENTER_CRITICAL(&settings_mux);
+    settings.drive.mode = (mode < RC_TANK_DRIVE_MODE_MAX) ? (uint8_t)mode : RC_TANK_DRIVE_TANK;
+    drive = settings.drive;
+    deadzone_q15 = settings.deadzone_q15;
+    portEXIT_CRITICAL(&settings_mux);
+
+    rc_tank_drive_set_config(&drive, deadzone_q15);
+    mark_dirty();
+}
+
+void rc_tank_settings_flush(void) {
+    if (settings_task_handle != NULL) {
+        xTaskNotify(settings_task_handle, NOTIFY_FLUSH, eSetBits);
+    }
+}
@@ -0,0 +1,60 @@
+#ifndef RC_TANK_SETTINGS_H
+#define RC_TANK_SETTINGS_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "rc_tank_ramp.h"
+#include "rc_tank_failsafe.h"
+#include "rc_tank_turret.h"
+#include "rc_tank_servo.h"
+#include "rc_tank_drive.h"
+
+// NVS 저장 위치
+#define RC_TANK_SETTINGS_NAMESPACE     "rc_tank"
+#define RC_TANK_SETTINGS_KEY           "settings"
+#define RC_TANK_SETTINGS_LEGACY_KEY    "speed_mult"  // 이전 버전 (float 2개)
+
+// 스키마 버전. 새 필드는 구조체 끝에만 추가하고 버전을 올린다.
+#define RC_TANK_SETTINGS_VERSION       5
+
+// 마지막 변경 후 이 시간 동안 변경이 없으면 플래시에 기록
+#define RC_TANK_SETTINGS_QUIET_MS      2000
+#define RC_TANK_SETTINGS_POLL_MS       250
+#define RC_TANK_SETTINGS_TASK_STACK    3072
+#define RC_TANK_SETTINGS_TASK_PRIORITY 2
+
+// 탱크 설정 (NVS blob 한 개로 저장)
+typedef struct {
+    uint16_t version;
+    uint16_t size;
+    float left_speed_multiplier;
+    float right_speed_multiplier;
+    uint16_t deadzone_q15;
+    uint8_t volume;           // 0 ~ 30
+    uint8_t reserved;
+    rc_tank_ramp_profile_t track_ramp;
+    rc_tank_ramp_profile_t turret_ramp;
+    int8_t mount_trim;        // 포 마운트 서보 보정 (도)
+    int8_t cannon_trim;       // 포신 서보 보정 (도)
+    // version 2
+    rc_tank_failsafe_config_t failsafe;
+    // version 3
+    rc_tank_turret_config_t turret;
+    // version 4: 서보 펄스 폭/궤적 제한 (보정 각도는 mount_trim/cannon_trim)
+    rc_tank_servo_config_t servo[RC_TANK_HAL_SERVO_MAX];
+    // version 5: 주행 모드/곡선 (데드존은 deadzone_q15)
+    rc_tank_drive_config_t drive;
+} rc_tank_settings_t;
+
+// 함수 선언
+// NVS 에서 읽어 적용하고 저장 태스크를 시작한다
+void rc_tank_settings_init(void);
+void rc_tank_settings_get(rc_tank_settings_t* out);
+// RAM 사본만 갱신하고 적용한다. 플래시 기록은 저장 태스크가 나중에 한 번에 한다.
+void rc_tank_settings_set(const rc_tank_settings_t* settings);
+void rc_tank_settings_set_speed_multipliers(float left, float right);
+void rc_tank_settings_set_drive_mode(rc_tank_drive_mode_t mode);
+// 변경 사항이 있으면 대기 시간 없이 바로 기록하도록 요청 (비동기)
+void rc_tank_settings_flush(void);
+
+#endif // RC_TANK_SETTINGS_H
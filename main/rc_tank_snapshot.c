@@ -0,0 +1,34 @@
+#include "rc_tank_snapshot.h"
+#include <string.h>
+
+void rc_tank_input_snapshot_init(rc_tank_input_snapshot_t* snap) {
+    atomic_store_explicit(&snap->seq, 0, memory_order_relaxed);
+    memset(snap->data, 0, sizeof(snap->data));
+}
+
+void rc_tank_input_snapshot_publish(rc_tank_input_snapshot_t* snap, const rc_tank_input_t* input) {
+    unsigned seq = atomic_load_explicit(&snap->seq, memory_order_relaxed);
+
+    // 홀수: reader 는 data[1] (직전 값) 을 읽는다. 이전 게시의 data[1] 쓰기가 먼저 보여야 한다
+    atomic_store_explicit(&snap->seq, seq + 1, memory_order_release);
+    atomic_thread_fence(memory_order_release);
+    snap->data[0] = *input;
+
+    // 짝수: reader 는 새 값이 들어간 data[0] 을 읽는다
+    atomic_store_explicit(&snap->seq, seq + 2, memory_order_release);
+    atomic_thread_fence(memory_order_release);
+    snap->data[1] = *input;
+}
+
+uint32_t rc_tank_input_snapshot_read(rc_tank_input_snapshot_t* snap, rc_tank_input_t* out) {
+    unsigned begin, end;
+    do {
+        begin = atomic_load_explicit(&snap->seq, memory_order_acquire);
+        memcpy(out, (const void*)&snap->data[begin & 1], sizeof(*out));
+        atomic_thread_fence(memory_order_acquire);
+        end = atomic_load_explicit(&snap->seq, memory_order_relaxed);
+    } while (begin != end);
+
+    // 완료된 게시 횟수 (쓰기 중이면 직전 게시까지)
+    return begin >> 1;
+}
@@ -0,0 +1,39 @@
+#ifndef RC_TANK_SNAPSHOT_H
+#define RC_TANK_SNAPSHOT_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stdatomic.h>
+
+// 게임패드 입력 (BT 콜백에서 좌석별로 게시, 제어 루프에서 합쳐 읽음. rc_tank_crew 참고)
+typedef struct {
+    int16_t axis_y;   // 좌측 스틱 Y (-512 ~ 511)
+    int16_t axis_ry;  // 우측 스틱 Y (-512 ~ 511)
+    int16_t axis_x;   // 좌측 스틱 X (-512 ~ 511)
+    int16_t axis_rx;  // 우측 스틱 X (-512 ~ 511)
+    int16_t throttle; // 오른쪽 트리거 (0 ~ 1023)
+    int16_t brake;    // 왼쪽 트리거 (0 ~ 1023)
+    int8_t dpad_x;    // -1, 0, 1
+    int8_t dpad_y;    // -1, 0, 1
+    int8_t link;      // 보고한 컨트롤러 번호 (페일세이프 링크), 없으면 -1
+    bool active;      // false 이면 모든 구동 정지
+} rc_tank_input_t;
+
+// 단일 writer / 다중 reader 시퀀스 락 (잠금 없음, 사본 두 개).
+// writer 는 seq 를 홀수로 만든 뒤 data[0] 을, 짝수로 되돌린 뒤 data[1] 을 쓴다.
+// reader 는 seq 의 최하위 비트가 가리키는 (지금 쓰지 않는) 사본을 복사하고, 그 사이 seq 가
+// 변했으면 다시 읽는다. 같은 코어에서 writer 를 선점한 reader 도 기다리지 않고 바로 읽는다.
+typedef struct {
+    atomic_uint seq;
+    rc_tank_input_t data[2];
+} rc_tank_input_snapshot_t;
+
+// 함수 선언
+void rc_tank_input_snapshot_init(rc_tank_input_snapshot_t* snap);
+// writer 는 하나여야 한다 (BT 스레드)
+void rc_tank_input_snapshot_publish(rc_tank_input_snapshot_t* snap, const rc_tank_input_t* input);
+// 일관된 복사본을 out 에 채우고 해당 시퀀스 번호를 반환한다.
+// 반환값이 이전과 같으면 새로 게시된 입력이 없는 것이다.
+uint32_t rc_tank_input_snapshot_read(rc_tank_input_snapshot_t* snap, rc_tank_input_t* out);
+
+#endif // RC_TANK_SNAPSHOT_H
@@ -0,0 +1,285 @@
+#include "rc_tank_turret.h"
+#include "rc_tank.h"
+#include "rc_tank_hal.h"
+#include "rc_tank_loop.h"
+#include "rc_tank_settings.h"
+#include "esp_console.h"
+#include "esp_log.h"
+#include "freertos/FreeRTOS.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+static const char* TAG = "RC_TANK_TURRET";
+
+#define TICK_MS (1000 / RC_TANK_CONTROL_RATE_HZ)
+
+// 설정과 요청 (임의 스레드 -> 제어 루프, turret_mux 로 보호)
+static rc_tank_turret_config_t config = RC_TANK_TURRET_DEFAULT_CONFIG;
+static uint32_t request_seq = 0;
+static bool request_position = false;
+static int32_t request_target = 0;
+static portMUX_TYPE turret_mux = portMUX_INITIALIZER_UNLOCKED;
+
+// 제어 루프 전용
+static rc_tank_turret_mode_t mode = RC_TANK_TURRET_MANUAL;
+static uint32_t handled_seq = 0;
+static int manual_speed = 0;
+static int32_t target_ddeg = 0;
+static int32_t angle_ddeg = 0;       // 보정 후
+static int32_t raw_ddeg = 0;         // 보정 전
+static int32_t rate_ddeg_s = 0;      // 각속도 (필터 적용)
+static int64_t integral = 0;         // 오차 적분 (0.1도 * ms)
+static int32_t last_output = 0;
+static int32_t last_i_term = 0;
+static uint32_t sensor_fail_ticks = RC_TANK_TURRET_SENSOR_TIMEOUT + 1;  // 첫 값을 읽기 전에는 센서 없음
+static uint32_t sensor_errors = 0;
+static bool have_sample = false;
+
+static int32_t clamp32(int32_t v, int32_t lo, int32_t hi) {
+    return (v < lo) ? lo : (v > hi) ? hi : v;
+}
+
+void rc_tank_turret_init(void) {
+    mode = RC_TANK_TURRET_MANUAL;
+    manual_speed = 0;
+    integral = 0;
+    have_sample = false;
+}
+
+void rc_tank_turret_set_config(const rc_tank_turret_config_t* new_config) {
+    portENTER_CRITICAL(&turret_mux);
+    config = *new_config;
+    if (config.min_ddeg > config.max_ddeg) {
+        config.min_ddeg = config.max_ddeg;
+    }
+    portEXIT_CRITICAL(&turret_mux);
+}
+
+void rc_tank_turret_set_manual(int speed) {
+    manual_speed = speed;
+}
+
+static void post_request(bool position, int32_t target) {
+    portENTER_CRITICAL(&turret_mux);
+    request_position = position;
+    request_target = clamp32(target, config.min_ddeg, config.max_ddeg);
+    request_seq++;
+    portEXIT_CRITICAL(&turret_mux);
+}
+
+void rc_tank_turret_goto(int32_t angle_ddeg) {
+    post_request(true, angle_ddeg);
+}
+
+void rc_tank_turret_center(void) {
+    post_request(true, 0);
+}
+
+void rc_tank_turret_cancel(void) {
+    post_request(false, 0);
+}
+
+// 센서 읽기. 실패가 계속되면 센서 없음으로 판정
+static bool read_sensor(const rc_tank_turret_config_t* c) {
+    int32_t raw;
+    if (!rc_tank_hal_read_turret_angle(&raw)) {
+        sensor_errors++;
+        if (sensor_fail_ticks <= RC_TANK_TURRET_SENSOR_TIMEOUT) {
+            sensor_fail_ticks++;
+        }
+        return sensor_fail_ticks <= RC_TANK_TURRET_SENSOR_TIMEOUT;
+    }
+
+    int32_t angle = raw - c->center_ddeg;
+    if (have_sample) {
+        // 미분은 측정값 기준 (목표 변경 시 출력 급변 방지), 1/4 이동 평균
+        int32_t rate = (angle - angle_ddeg) * RC_TANK_CONTROL_RATE_HZ;
+        rate_ddeg_s += (rate - rate_ddeg_s) / 4;
+    }
+    raw_ddeg = raw;
+    angle_ddeg = angle;
+    have_sample = true;
+    sensor_fail_ticks = 0;
+    return true;
+}
+
+// PID 한 스텝. 반환값은 터렛 속도 (-MAX ~ MAX)
+static int32_t pid_step(const rc_tank_turret_config_t* c) {
+    int32_t error = target_ddeg - angle_ddeg;
+    if (abs(error) <= RC_TANK_TURRET_TOLERANCE_DDEG) {
+        // 도달: 적분은 그대로 두고 출력만 끈다 (잔류 오차로 떨리는 것 방지)
+        last_i_term = 0;
+        return 0;
+    }
+
+    int32_t p_term = (c->kp_q8 * error) >> 8;
+    int32_t d_term = -((c->kd_q8 * rate_ddeg_s) >> 8);
+    int32_t i_term = (int32_t)((c->ki_q8 * integral / 1000) >> 8);
+    int32_t out = p_term + i_term + d_term;
+
+    // 안티 와인드업: 포화 방향으로는 적분하지 않고, 적분 항 자체도 출력 한계로 제한
+    bool saturated = (out >= RC_TANK_TURRET_MAX_SPEED && error > 0) || (out <= -RC_TANK_TURRET_MAX_SPEED && error < 0);
+    if (!saturated && c->ki_q8 > 0) {
+        int64_t limit = (int64_t)RC_TANK_TURRET_MAX_SPEED * 256 * 1000 / c->ki_q8;
+        integral += (int64_t)error * TICK_MS;
+        if (integral > limit) integral = limit;
+        if (integral < -limit) integral = -limit;
+    }
+
+    last_i_term = i_term;
+    return clamp32(out, -RC_TANK_TURRET_MAX_SPEED, RC_TANK_TURRET_MAX_SPEED);
+}
+
+void rc_tank_turret_update(void) {
+    rc_tank_turret_config_t c;
+    bool new_request = false;
+    bool position = false;
+    int32_t target = 0;
+
+    portENTER_CRITICAL(&turret_mux);
+    c = config;
+    if (request_seq != handled_seq) {
+        handled_seq = request_seq;
+        new_request = true;
+        position = request_position;
+        target = request_target;
+    }
+    portEXIT_CRITICAL(&turret_mux);
+
+    bool sensor_ok = read_sensor(&c);
+
+    if (new_request) {
+        if (position && sensor_ok) {
+            // 새 목표마다 적분 초기화 (이전 목표의 잔류 오차를 끌고 가지 않도록)
+            integral = 0;
+            mode = RC_TANK_TURRET_POSITION;
+            target_ddeg = target;
+        } else {
+            if (position) {
+                ESP_LOGW(TAG, "No turret sensor, position command ignored");
+            }
+            mode = RC_TANK_TURRET_MANUAL;
+            manual_speed = 0;
+        }
+    }
+
+    // D-PAD 입력은 위치 명령보다 우선
+    if (manual_speed != 0) {
+        mode = RC_TANK_TURRET_MANUAL;
+    }
+    if (mode == RC_TANK_TURRET_POSITION && !sensor_ok) {
+        ESP_LOGW(TAG, "Turret sensor lost, position control stopped");
+        mode = RC_TANK_TURRET_MANUAL;
+    }
+
+    int32_t out;
+    if (mode == RC_TANK_TURRET_POSITION) {
+        out = pid_step(&c);
+    } else {
+        out = manual_speed;
+        // 회전 한계 (센서가 있을 때만)
+        if (sensor_ok && ((out > 0 && angle_ddeg >= c.max_ddeg) || (out < 0 && angle_ddeg <= c.min_ddeg))) {
+            out = 0;
+        }
+    }
+
+    last_output = out;
+    rc_tank_set_turret_speed(out);
+}
+
+bool rc_tank_turret_get_raw(int32_t* ddeg) {
+    *ddeg = raw_ddeg;
+    return have_sample && sensor_fail_ticks <= RC_TANK_TURRET_SENSOR_TIMEOUT;
+}
+
+void rc_tank_turret_get_status(rc_tank_turret_status_t* out) {
+    out->mode = mode;
+    out->sensor_ok = have_sample && sensor_fail_ticks <= RC_TANK_TURRET_SENSOR_TIMEOUT;
+    out->angle_ddeg = angle_ddeg;
+    out->target_ddeg = target_ddeg;
+    out->output = last_output;
+    out->integral_term = last_i_term;
+    out->sensor_errors = sensor_errors;
+}
+
+// 콘솔에서 바꾼 보정/게인은 설정에 반영 (지연 저장)
+static void update_settings(const rc_tank_turret_config_t* c) {
+    rc_tank_settings_t s;
+    rc_tank_settings_get(&s);
+    s.turret = *c;
+    rc_tank_settings_set(&s);
+}
+
+static int cmd_tank_turret(int argc, char** argv) {
+    rc_tank_turret_config_t c;
+    portENTER_CRITICAL(&turret_mux);
+    c = config;
+    portEXIT_CRITICAL(&turret_mux);
+
+    if (argc >= 3 && strcmp(argv[1], "goto") == 0) {
+        rc_tank_turret_goto((int32_t)(strtof(argv[2], NULL) * 10.0f));
+        return 0;
+    }
+    if (argc >= 2 && strcmp(argv[1], "center") == 0) {
+        rc_tank_turret_center();
+        return 0;
+    }
+    if (argc >= 2 && strcmp(argv[1], "stop") == 0) {
+        rc_tank_turret_cancel();
+        return 0;
+    }
+    if (argc >= 2 && strcmp(argv[1], "zero") == 0) {
+        int32_t raw;
+        if (!rc_tank_turret_get_raw(&raw)) {
+            printf("No turret sensor\n");
+            return 1;
+        }
+        c.center_ddeg = (int16_t)raw;
+        update_settings(&c);
+        printf("Center set to sensor angle %ld (0.1 deg)\n", (long)raw);
+        return 0;
+    }
+    if (argc >= 5 && strcmp(argv[1], "pid") == 0) {
+        c.kp_q8 = (int16_t)(strtof(argv[2], NULL) * 256.0f);
+        c.ki_q8 = (int16_t)(strtof(argv[3], NULL) * 256.0f);
+        c.kd_q8 = (int16_t)(strtof(argv[4], NULL) * 256.0f);
+        update_settings(&c);
+        return 0;
+    }
+    if (argc >= 4 && strcmp(argv[1], "limits") == 0) {
+        c.min_ddeg = (int16_t)(strtof(argv[2], NULL) * 10.0f);
+        c.max_ddeg = (int16_t)(strtof(argv[3], NULL) * 10.0f);
+        update_settings(&c);
+        return 0;
+    }
+    if (argc >= 2) {
+        printf("Unknown arguments\n");
+        return 1;
+    }
+
+    rc_tank_turret_status_t st;
+    rc_tank_turret_get_status(&st);
+    printf("Turret: mode=%s, sensor=%s (errors %lu)\n", st.mode == RC_TANK_TURRET_POSITION ? "position" : "manual",
+           st.sensor_ok ? "ok" : "none", (unsigned long)st.sensor_errors);
+    printf("  angle=%ld, target=%ld (0.1 deg), output=%ld, i=%ld\n", (long)st.angle_ddeg, (long)st.target_ddeg,
+           (long)st.output, (long)st.integral_term);
+    printf("  pid: kp=%.3f ki=%.3f kd=%.3f, center=%d, limits=%d..%d (0.1 deg)\n", c.kp_q8 / 256.0f,
+           c.ki_q8 / 256.0f, c.kd_q8 / 256.0f, c.center_ddeg, c.min_ddeg, c.max_ddeg);
+    return 0;
+}
+
+void rc_tank_turret_register_cmds(void) {
+    const esp_console_cmd_t turret_cmd = {
+        .command = "tank_turret",
+        .help =
+            "Shows the turret position controller, or commands it.\n"
+            "  goto <deg>: absolute angle, center: return to front, stop: cancel\n"
+            "  zero: current position becomes the front\n"
+            "  pid <kp> <ki> <kd>, limits <min deg> <max deg>: saved with the settings",
+        .hint = "[goto <deg> | center | stop | zero | pid <kp> <ki> <kd> | limits <min> <max>]",
+        .func = &cmd_tank_turret,
+    };
+
+    ESP_ERROR_CHECK(esp_console_cmd_register(&turret_cmd));
+}
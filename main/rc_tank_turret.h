@@ -0,0 +1,61 @@
+#ifndef RC_TANK_TURRET_H
+#define RC_TANK_TURRET_H
+
+#include <stdint.h>
+#include <stdbool.h>
+
+// 터렛 위치 제어
+// 위치 센서 (rc_tank_hal_read_turret_angle) 를 제어 루프 주기로 읽어 PID 로 절대 각도를 맞춘다.
+// 각도 단위: 0.1도 (0 = 정면, 양수 = 시계방향)
+#define RC_TANK_TURRET_MANUAL_SPEED    128   // D-PAD 수동 회전 속도
+#define RC_TANK_TURRET_MAX_SPEED       200   // PID 출력 제한
+#define RC_TANK_TURRET_TOLERANCE_DDEG  10    // 이 오차 이내면 도달로 보고 출력 0
+#define RC_TANK_TURRET_SENSOR_TIMEOUT  20    // 연속 실패 틱 수. 넘으면 위치 제어 중단
+
+typedef enum {
+    RC_TANK_TURRET_MANUAL = 0,   // D-PAD 속도 명령 (개루프)
+    RC_TANK_TURRET_POSITION,     // 목표 각도 (PID)
+} rc_tank_turret_mode_t;
+
+// PID 게인 (Q8) 및 센서 보정. rc_tank_settings 에 저장된다.
+typedef struct {
+    int16_t kp_q8;        // 속도 / 0.1도
+    int16_t ki_q8;        // 속도 / (0.1도 * 초)
+    int16_t kd_q8;        // 속도 / (0.1도 / 초)
+    int16_t center_ddeg;  // 정면일 때의 센서 각도
+    int16_t min_ddeg;     // 회전 한계 (보정 후)
+    int16_t max_ddeg;
+} rc_tank_turret_config_t;
+
+// 기본값: 40도 이상 오차에서 포화, 1도 오차가 1초 지속되면 적분 항 2.5
+#define RC_TANK_TURRET_DEFAULT_CONFIG                                                                     \
+    {.kp_q8 = 128, .ki_q8 = 64, .kd_q8 = 8, .center_ddeg = 0, .min_ddeg = -1200, .max_ddeg = 1200}
+
+typedef struct {
+    rc_tank_turret_mode_t mode;
+    bool sensor_ok;
+    int32_t angle_ddeg;
+    int32_t target_ddeg;
+    int32_t output;
+    int32_t integral_term;
+    uint32_t sensor_errors;
+} rc_tank_turret_status_t;
+
+// 함수 선언
+void rc_tank_turret_init(void);
+void rc_tank_turret_set_config(const rc_tank_turret_config_t* config);
+// 제어 루프: D-PAD 속도. 0 이 아니면 위치 제어를 취소하고 수동 회전
+void rc_tank_turret_set_manual(int speed);
+// 임의 스레드: 절대 각도 / 중앙 복귀 요청 (다음 제어 틱부터 적용)
+void rc_tank_turret_goto(int32_t angle_ddeg);
+void rc_tank_turret_center(void);
+// 임의 스레드: 위치 제어 취소 (수동 속도 0)
+void rc_tank_turret_cancel(void);
+// 제어 루프: 센서를 읽고 터렛 목표 속도 갱신 (rc_tank_update_outputs 전에 호출)
+void rc_tank_turret_update(void);
+// 마지막으로 읽은 센서 각도 (보정 전). 중앙 보정에 사용
+bool rc_tank_turret_get_raw(int32_t* ddeg);
+void rc_tank_turret_get_status(rc_tank_turret_status_t* out);
+void rc_tank_turret_register_cmds(void);
+
+#endif // RC_TANK_TURRET_H